@@ -0,0 +1,53 @@
+#ifndef PIC16F876A_CONTROLLER_ANIMATE
+#define PIC16F876A_CONTROLLER_ANIMATE
+
+/*************************************************************************
+ * Projet Raspi LCD display
+ *************************************************************************
+ * File : pic16f876a_controller_animate.h
+ *************************************************************************
+ * Date : 19 Octobre 2026
+ * Author : Sinseman44
+ * Organization : Coloc's bar
+ *************************************************************************/
+
+/*************************************************************************
+ * Inclusion(s)
+ *************************************************************************/
+
+#include "pic16f876a_controller_include.h"
+
+/*************************************************************************
+ * Constante(s)
+ *************************************************************************/
+
+#define ANIMATE_NB_SLOTS		2		/*!< Number of animated cells */
+#define ANIMATE_MAX_GLYPHS		8		/*!< Glyphs max in a sequence */
+
+/*************************************************************************
+ * Enuméré(s)
+ *************************************************************************/ 
+
+/*************************************************************************
+ * Structure(s)
+ *************************************************************************/ 
+
+/*************************************************************************
+ * Variable(s)
+ *************************************************************************/
+
+/*************************************************************************
+ * Prototypes(s)
+ *************************************************************************/
+
+void animate_init(void);
+
+int8_t animate_start(const uint8_t /* in */ ui8_row,
+		     const uint8_t /* in */ ui8_column,
+		     const uint8_t /* in */ ui8_period,
+		     const uint8_t * /* in */ pui8_glyphs,
+		     const uint8_t /* in */ ui8_nb_glyphs);
+
+void animate_task(void);
+
+#endif /* PIC16F876A_CONTROLLER_ANIMATE */
@@ -0,0 +1,70 @@
+#ifndef PIC16F876A_CONTROLLER_BACKPACK
+#define PIC16F876A_CONTROLLER_BACKPACK
+
+/*************************************************************************
+ * Projet Raspi LCD display
+ *************************************************************************
+ * File : pic16f876a_controller_backpack.h
+ *************************************************************************
+ * Date : 19 Octobre 2026
+ * Author : Sinseman44
+ * Organization : Coloc's bar
+ *************************************************************************/
+
+/*************************************************************************
+ * Inclusion(s)
+ *************************************************************************/
+
+#include "pic16f876a_controller_include.h"
+
+/*************************************************************************
+ * Constante(s)
+ *************************************************************************/
+
+#ifndef BACKPACK_NB
+#define BACKPACK_NB			1		/*!< Backpacks driven, 2 at most (RAM : 40 bytes each) */
+#endif
+#define BACKPACK_DISPLAY	2		/*!< Display field of the first backpack */
+#if defined(BACKPACK_ENABLE) && (BACKPACK_NB > 1)
+#define BACKPACK_BANK3_SIZE	32		/*!< Screen of the second backpack in the bank 3 */
+#else
+#define BACKPACK_BANK3_SIZE	0
+#endif
+
+/*************************************************************************
+ * Enuméré(s)
+ *************************************************************************/
+
+/*************************************************************************
+ * Structure(s)
+ *************************************************************************/
+
+/*************************************************************************
+ * Variable(s)
+ *************************************************************************/
+
+/*************************************************************************
+ * Prototypes(s)
+ *************************************************************************/
+
+void backpack_init(void);
+
+void backpack_task(void);
+
+void backpack_clear(const uint8_t /* in */ ui8_backpack);
+
+void backpack_return_home(const uint8_t /* in */ ui8_backpack);
+
+void backpack_set_cursor(const uint8_t /* in */ ui8_backpack,
+			 const uint8_t /* in */ ui8_row,
+			 const uint8_t /* in */ ui8_column);
+
+void backpack_put_char(const uint8_t /* in */ ui8_backpack,
+		       const uint8_t /* in */ ui8_value);
+
+int8_t backpack_set_control(const uint8_t /* in */ ui8_backpack,
+			    const uint8_t /* in */ ui8_display,
+			    const uint8_t /* in */ ui8_cursor,
+			    const uint8_t /* in */ ui8_blink);
+
+#endif /* PIC16F876A_CONTROLLER_BACKPACK */
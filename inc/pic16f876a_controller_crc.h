@@ -0,0 +1,45 @@
+#ifndef PIC16F876A_CONTROLLER_CRC
+#define PIC16F876A_CONTROLLER_CRC
+
+/*************************************************************************
+ * Projet Raspi LCD display
+ *************************************************************************
+ * File : pic16f876a_controller_crc.h
+ *************************************************************************
+ * Date : 19 Octobre 2026
+ * Author : Sinseman44
+ * Organization : Coloc's bar
+ *************************************************************************/
+
+/*************************************************************************
+ * Inclusion(s)
+ *************************************************************************/
+
+#include "pic16f876a_controller_include.h"
+
+/*************************************************************************
+ * Constante(s)
+ *************************************************************************/
+
+#define CRC8_INIT			0x00	/*!< Initial value of a CRC-8 */
+
+/*************************************************************************
+ * Enuméré(s)
+ *************************************************************************/ 
+
+/*************************************************************************
+ * Structure(s)
+ *************************************************************************/ 
+
+/*************************************************************************
+ * Variable(s)
+ *************************************************************************/
+
+/*************************************************************************
+ * Prototypes(s)
+ *************************************************************************/
+
+uint8_t crc8_update(const uint8_t /* in */ ui8_crc,
+		    const uint8_t /* in */ ui8_value);
+
+#endif /* PIC16F876A_CONTROLLER_CRC */
@@ -0,0 +1,78 @@
+#ifndef PIC16F876A_CONTROLLER_EEPROM
+#define PIC16F876A_CONTROLLER_EEPROM
+
+/*************************************************************************
+ * Projet Raspi LCD display
+ *************************************************************************
+ * File : pic16f876a_controller_eeprom.h
+ *************************************************************************
+ * Date : 19 Octobre 2026
+ * Author : Sinseman44
+ * Organization : Coloc's bar
+ *************************************************************************/
+
+/*************************************************************************
+ * Inclusion(s)
+ *************************************************************************/
+
+#include "pic16f876a_controller_include.h"
+
+/*************************************************************************
+ * Constante(s)
+ *************************************************************************/
+
+/* Internal EEPROM map :
+ * 
+ * 0x00 - 0x05 : macro directory (pic16f876a_controller_macro.c)
+ * 0x06 - 0xDC : macro frames (pic16f876a_controller_macro.c)
+ * 0xDD - 0xFE : saved screen (pic16f876a_controller_lcd.c)
+ * 0xFF        : I2C slave address (pic16f876a_controller_i2c.c)
+ */
+
+#define RET_EEPROM_OK		 0
+#define RET_EEPROM_NOK		-1
+
+/*************************************************************************
+ * Enuméré(s)
+ *************************************************************************/ 
+
+/*************************************************************************
+ * Structure(s)
+ *************************************************************************/ 
+
+/*************************************************************************
+ * Variable(s)
+ *************************************************************************/
+
+/*************************************************************************
+ * Prototypes(s)
+ *************************************************************************/
+
+/*
+ * Initialise the write queue and the EEPROM write interrupt
+ */
+void eeprom_init(void);
+
+/*
+ * Queue a byte to write in the EEPROM (waits for a write cycle when
+ * the queue is full)
+ */
+int8_t eeprom_async_write(const uint8_t /* in */ ui8_addr,
+			  const uint8_t /* in */ ui8_value);
+
+/*
+ * Read a byte from the EEPROM (pending writes included)
+ */
+uint8_t eeprom_async_read(const uint8_t /* in */ ui8_addr);
+
+/*
+ * Indicate if writes are pending
+ */
+uint8_t eeprom_async_busy(void);
+
+/*
+ * Start the next pending write (EEPROM write interrupt)
+ */
+void eeprom_write_done(void);
+
+#endif /* PIC16F876A_CONTROLLER_EEPROM */
@@ -0,0 +1,71 @@
+#ifndef PIC16F876A_CONTROLLER_ERROR
+#define PIC16F876A_CONTROLLER_ERROR
+
+/*************************************************************************
+ * Projet Raspi LCD display
+ *************************************************************************
+ * File : pic16f876a_controller_error.h
+ *************************************************************************
+ * Date : 19 Octobre 2026
+ * Author : Sinseman44
+ * Organization : Coloc's bar
+ *************************************************************************/
+
+/*************************************************************************
+ * Inclusion(s)
+ *************************************************************************/
+
+#include "pic16f876a_controller_include.h"
+
+/*************************************************************************
+ * Constante(s)
+ *************************************************************************/
+
+#define ERROR_VALUE			1		/*!< Frame byte can't be read */
+#define ERROR_EMPTY			2		/*!< Frame too short for its id */
+#define ERROR_CRC			3		/*!< Frame dropped on a bad CRC */
+#define ERROR_SYNC			4		/*!< Frame dropped on a bad id or size */
+#define ERROR_OVERFLOW		5		/*!< Frame dropped, lane full */
+#define ERROR_PARTIAL		6		/*!< Transfer stopped inside a frame */
+#define ERROR_FULL			7		/*!< Frame refused, no room left */
+#define ERROR_MACRO			8		/*!< Record dropped, no EEPROM space left */
+#define ERROR_NB_CODES		9
+
+#define ERROR_LOG_SIZE		4		/*!< Entries of the log */
+
+#define ERROR_SETUP_BANNER	0x01	/*!< Show the decoding errors on the LCD */
+#define ERROR_SETUP_CLEAR	0x02	/*!< Clear the log and the counters */
+
+/*************************************************************************
+ * Enuméré(s)
+ *************************************************************************/ 
+
+/*************************************************************************
+ * Structure(s)
+ *************************************************************************/ 
+
+/*************************************************************************
+ * Variable(s)
+ *************************************************************************/
+
+/*************************************************************************
+ * Prototypes(s)
+ *************************************************************************/
+
+void error_init(void);
+
+void error_setup(const uint8_t /* in */ ui8_flags);
+
+uint8_t error_is_banner(void);
+
+void error_log(const uint8_t /* in */ ui8_code,
+	       const uint8_t /* in */ ui8_opcode);
+
+void error_isr_log(const uint8_t /* in */ ui8_code,
+		   const uint8_t /* in */ ui8_opcode);
+
+uint8_t error_read_counters(const uint8_t /* in */ ui8_idx);
+
+uint8_t error_read_log(const uint8_t /* in */ ui8_idx);
+
+#endif /* PIC16F876A_CONTROLLER_ERROR */
@@ -26,6 +26,10 @@
 #define RET_FIFO_NOK		-1
 #define RET_FIFO_EMPTY		-2
 
+#define FIFO_LANE_HIGH		0		/*!< Control frames */
+#define FIFO_LANE_BULK		1		/*!< Text and other frames */
+#define FIFO_NB_LANES		2
+
 /*************************************************************************
  * Enuméré(s)
  *************************************************************************/ 
@@ -38,19 +42,27 @@
  * Variable(s)
  *************************************************************************/
 
-uint8_t *gpui8_read_buf = NULL;			/*!< Read pointer on the buffer */
-uint8_t *gpui8_write_buf = NULL;		/*!< Write pointer on the buffer */
-
 /*************************************************************************
  * Prototypes(s)
  *************************************************************************/
 
 void fifo_init(void);
 
-int8_t fifo_put(const uint8_t /* in */ ui8_value);
+int8_t fifo_put(const uint8_t /* in */ ui8_lane,
+		const uint8_t /* in */ ui8_value);
+
+int8_t fifo_get(const uint8_t /* in */ ui8_lane,
+		uint8_t * /* out */ const pui8_value);
+
+uint8_t fifo_state(const uint8_t /* in */ ui8_lane);
+
+uint8_t fifo_mark(const uint8_t /* in */ ui8_lane);
+
+void fifo_rollback(const uint8_t /* in */ ui8_lane,
+		   const uint8_t /* in */ ui8_mark);
 
-int8_t fifo_get(uint8_t * /* out */ const pui8_value);
+uint8_t fifo_read_hwm(const uint8_t /* in */ ui8_lane);
 
-uint8_t fifo_state(void);
+void fifo_clear_hwm(void);
 
 #endif /* PIC16F876A_CONTROLLER_FIFO */
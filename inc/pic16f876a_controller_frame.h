@@ -1,53 +1,93 @@
-#ifndef PIC16F876A_CONTROLLER_FRAME
-#define PIC16F876A_CONTROLLER_FRAME
-
-/*************************************************************************
- * Projet Raspi LCD display
- *************************************************************************
- * File : pic16f876a_controller_frame.h
- *************************************************************************
- * Date : 29 Septembre 2012
- * Author : Sinseman44
- * Organization : Coloc's bar
- *************************************************************************/
-
-/*************************************************************************
- * Inclusion(s)
- *************************************************************************/
-
-#include "pic16f876a_controller_fifo.h"
-
-/*************************************************************************
- * Constante(s)
- *************************************************************************/
-
-/*************************************************************************
- * Enuméré(s)
- *************************************************************************/ 
-
-enum {
-	CLEAR_DISPLAY = 1,
-	RETURN_HOME,
-	SET_CURSOR,
-	PUT_CHAR,
-	PUT_STRING,
-	CONTROL_DISPLAY
-} FRAME_id_t;
-
-/*************************************************************************
- * Structure(s)
- *************************************************************************/ 
-
-/*************************************************************************
- * Variable(s)
- *************************************************************************/
-
-/*************************************************************************
- * Prototypes(s)
- *************************************************************************/
-
-void frame_init(void);
-
-int8_t frame_decode_fifo(void);
-
-#endif /* PIC16F876A_CONTROLLER_FRAME */
+#ifndef PIC16F876A_CONTROLLER_FRAME
+#define PIC16F876A_CONTROLLER_FRAME
+
+/*************************************************************************
+ * Projet Raspi LCD display
+ *************************************************************************
+ * File : pic16f876a_controller_frame.h
+ *************************************************************************
+ * Date : 29 Septembre 2012
+ * Author : Sinseman44
+ * Organization : Coloc's bar
+ *************************************************************************/
+
+/*************************************************************************
+ * Inclusion(s)
+ *************************************************************************/
+
+#include "pic16f876a_controller_fifo.h"
+
+/*************************************************************************
+ * Constante(s)
+ *************************************************************************/
+
+#define FRAME_SYNC			0x00	/*!< Sync byte between frames */
+#define FRAME_CRC_FLAG		0x80	/*!< Id bit of a frame with a CRC-8 */
+#define FRAME_DISPLAY_MASK	0x60	/*!< Id bits of the display selected */
+#define FRAME_DISPLAY_SHIFT	5
+#define FRAME_ID_MASK		0x1F	/*!< Id bits of the frame identifier */
+#define FRAME_ID_LAST		SET_ADDRESS	/*!< Last frame identifier */
+
+/*************************************************************************
+ * Enuméré(s)
+ *************************************************************************/ 
+
+typedef enum {
+	CLEAR_DISPLAY = 1,
+	RETURN_HOME,
+	SET_CURSOR,
+	PUT_CHAR,
+	PUT_STRING,
+	CONTROL_DISPLAY,
+	BEGIN_RECORD,
+	END_RECORD,
+	RUN_MACRO,
+	SAVE_SCREEN,
+	BEGIN_UPDATE,
+	COMMIT,
+	SCROLL,
+	MARQUEE,
+	DEFINE_CHAR,
+	ANIMATE,
+	SCHEDULE,
+	SET_TICK,
+	COALESCE,
+	READ_SELECT,
+	ERROR_SETUP,
+	PERF_RESET,
+	SET_ADDRESS
+} FRAME_id_t;
+
+/*************************************************************************
+ * Structure(s)
+ *************************************************************************/ 
+
+/*************************************************************************
+ * Variable(s)
+ *************************************************************************/
+
+/*************************************************************************
+ * Prototypes(s)
+ *************************************************************************/
+
+void frame_init(const uint8_t /* in */ ui8_warm_boot);
+
+void frame_task(void);
+
+uint8_t frame_is_ready(void);
+
+int8_t frame_decode_fifo(void);
+
+void frame_receive_start(void);
+
+void frame_receive_resync(void);
+
+void frame_receive_general_call(void);
+
+void frame_receive(const uint8_t /* in */ ui8_value);
+
+uint8_t frame_is_pending(void);
+
+uint8_t frame_read_byte(const uint8_t /* in */ ui8_idx);
+
+#endif /* PIC16F876A_CONTROLLER_FRAME */
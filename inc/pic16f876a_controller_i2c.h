@@ -39,17 +39,32 @@ enum {
  */
 uint8_t i2c_slave_read(void);
 
+/*
+ * Load a byte to send to the master
+ */
+void i2c_slave_write(const uint8_t /* in */ ui8_value);
+
 /*
  * 
  */ 
 //~ int8_t i2c_slave_scan(void);
 int8_t i2c_slave_state(uint8_t * pui8_state);
 
+/*
+ * Handle the SSP interrupt (slave mode)
+ */
+void i2c_isr(void);
+
 /*
  * Initialise the I2C in slave mode
  */
 int8_t i2c_init(void);
 
+/*
+ * Save the slave address in the EEPROM and use it
+ */
+void i2c_set_own_addr(const uint8_t /* in */ ui8_addr);
+
 /*
  * Set slave address and read/write bit
  */
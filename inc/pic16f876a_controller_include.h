@@ -35,6 +35,14 @@
 //#define __DEBUG__
 
 typedef char 					char_t;
+#ifdef EMU_HOST
+// host emulator (make emu) : the types of stdint.h have the sizes of
+// picc, the 24 bits types are wider
+typedef signed short			short16_t;
+typedef unsigned short			ushort16_t;
+typedef int32_t					int24_t;
+typedef uint32_t				uint24_t;
+#else
 typedef signed char				int8_t;
 typedef unsigned char 			uint8_t;
 typedef signed short			short16_t;
@@ -45,5 +53,13 @@ typedef signed short long 		int24_t;
 typedef unsigned short long 	uint24_t;
 typedef signed long 			int32_t;
 typedef unsigned long 			uint32_t;
+#endif
+
+// the flags (gb_flag_) are bit variables : 8 of them per byte of RAM,
+// cleared at the start since a bit can't be initialised
+
+// the bank 0 and the common RAM are left to the state of the interrupt and
+// to the compiled stack, the state of the main loop is placed in the banks
+// 1 to 3 (bank1, bank2, bank3 qualifiers)
 
 #endif /* PIC16F876A_CONTROLLER_INCLUDE */
@@ -21,6 +21,22 @@
  * Constante(s)
  *************************************************************************/
 
+#define LCD_NB_ROWS				2		/*!< Number of rows of the screen */
+#define LCD_NB_COLUMNS			16		/*!< Number of columns of the screen */
+#define LCD_LINE_SIZE			40		/*!< DDRAM size of a line */
+#define LCD_SCREEN_SIZE			(LCD_NB_ROWS * LCD_NB_COLUMNS)
+#define LCD_GLYPH_SIZE			8		/*!< Rows of a custom character */
+
+#define LCD_DISPLAY_1			0		/*!< LCD enabled by RA5 */
+#define LCD_DISPLAY_2			1		/*!< LCD enabled by RB1 (make LCD2=1) */
+#ifdef LCD2_ENABLE
+#define LCD_NB_DISPLAYS			2
+#define LCD_BANK3_SIZE			10		/*!< State of the displays in the bank 3 */
+#else
+#define LCD_NB_DISPLAYS			1
+#define LCD_BANK3_SIZE			0
+#endif
+
 /*************************************************************************
  * Enuméré(s)
  *************************************************************************/ 
@@ -38,9 +54,41 @@
  *************************************************************************/
 
 /*
- * initialisation of lcd
+ * initialisation of lcd (the logo is skipped on a warm boot)
+ */
+int8_t lcd_init(const uint8_t /* in */ ui8_warm_boot);
+
+/*
+ * Go on with the initialisation without blocking
+ */
+void lcd_init_task(void);
+
+/*
+ * Indicate if the initialisation is over
+ */
+uint8_t lcd_is_ready(void);
+
+/*
+ * Select the display written by the next calls
+ */
+int8_t lcd_select(const uint8_t /* in */ ui8_display);
+
+/*
+ * Forget the instructions which are over
  */
-int8_t lcd_init(void);
+void lcd_busy_task(void);
+
+/*
+ * Follow the auto-increment of the address counter
+ */
+uint8_t lcd_next_addr(const uint8_t /* in */ ui8_addr);
+
+/*
+ * Conversions between DDRAM addresses and visible cells
+ */
+uint8_t lcd_addr_to_cell(const uint8_t /* in */ ui8_addr);
+
+uint8_t lcd_cell_to_addr(const uint8_t /* in */ ui8_cell);
 
 /* 
  * Clear and home the LCD 
@@ -77,4 +125,59 @@ int8_t lcd_set_control(const uint8_t /* in */ ui8_display,
 		       const uint8_t /* in */ ui8_cursor,
 		       const uint8_t /* in */ ui8_blink);
 
+/* 
+ * Initialise custom characters 
+ */
+int8_t lcd_define_custom_char(const uint8_t /* in */ ui8_custom_char_size,
+							  const char_t * /* in */ pi8_custom_char,
+							  const uint8_t /* in */ ui8_addr_offset);
+
+/*
+ * Coalesce the writes in the off-screen page
+ */
+void lcd_set_coalesce(const uint8_t /* in */ ui8_on);
+
+/*
+ * Flush a coalesced write to the screen
+ */
+void lcd_flush_task(void);
+
+/*
+ * Write a character in a visible cell if it changes
+ */
+void lcd_write_cell(const uint8_t /* in */ ui8_cell,
+		    const uint8_t /* in */ ui8_value);
+
+/*
+ * Scroll the lines with the display shift
+ */
+int8_t lcd_scroll(const uint8_t /* in */ ui8_direction,
+		  const uint8_t /* in */ ui8_count,
+		  const uint8_t /* in */ ui8_period);
+
+/*
+ * Do the next step of a timed scroll
+ */
+void lcd_scroll_task(void);
+
+/*
+ * Start an update in the off-screen page
+ */
+void lcd_begin_update(void);
+
+/*
+ * Write the changes of the off-screen page to the screen
+ */
+void lcd_commit(void);
+
+/*
+ * Save the screen in the EEPROM
+ */
+void lcd_save_screen(void);
+
+/*
+ * Restore the screen saved in the EEPROM
+ */
+int8_t lcd_restore_screen(void);
+
 #endif /* PIC16F876A_CONTROLLER_LCD */
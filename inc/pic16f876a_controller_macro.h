@@ -0,0 +1,69 @@
+#ifndef PIC16F876A_CONTROLLER_MACRO
+#define PIC16F876A_CONTROLLER_MACRO
+
+/*************************************************************************
+ * Projet Raspi LCD display
+ *************************************************************************
+ * File : pic16f876a_controller_macro.h
+ *************************************************************************
+ * Date : 19 Octobre 2026
+ * Author : Sinseman44
+ * Organization : Coloc's bar
+ *************************************************************************/
+
+/*************************************************************************
+ * Inclusion(s)
+ *************************************************************************/
+
+#include "pic16f876a_controller_include.h"
+
+/*************************************************************************
+ * Constante(s)
+ *************************************************************************/
+
+#define RET_MACRO_OK		 0
+#define RET_MACRO_NOK		-1
+#define RET_MACRO_EMPTY		-2
+#define RET_MACRO_FULL		-3
+
+#define MACRO_EEPROM_BASE	0x00	/*!< EEPROM address of the directory */
+#define MACRO_NB_SLOTS		3		/*!< Number of macros */
+#define MACRO_DATA_BASE		(MACRO_EEPROM_BASE + (2 * MACRO_NB_SLOTS))	/*!< First byte of the frames */
+#define MACRO_DATA_END		0xDD	/*!< End of the frames (the saved screen follows) */
+#define MACRO_EMPTY			0xFF	/*!< Size byte of an empty macro */
+
+/*************************************************************************
+ * Enuméré(s)
+ *************************************************************************/ 
+
+/*************************************************************************
+ * Structure(s)
+ *************************************************************************/ 
+
+/*************************************************************************
+ * Variable(s)
+ *************************************************************************/
+
+/*************************************************************************
+ * Prototypes(s)
+ *************************************************************************/
+
+void macro_init(void);
+
+int8_t macro_begin_record(const uint8_t /* in */ ui8_macro_id);
+
+int8_t macro_record_byte(const uint8_t /* in */ ui8_value);
+
+int8_t macro_end_record(void);
+
+uint8_t macro_is_recording(void);
+
+int8_t macro_play(const uint8_t /* in */ ui8_macro_id);
+
+void macro_stop(void);
+
+int8_t macro_get(uint8_t * /* out */ const pui8_value);
+
+uint8_t macro_is_playing(void);
+
+#endif /* PIC16F876A_CONTROLLER_MACRO */
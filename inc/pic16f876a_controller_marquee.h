@@ -0,0 +1,55 @@
+#ifndef PIC16F876A_CONTROLLER_MARQUEE
+#define PIC16F876A_CONTROLLER_MARQUEE
+
+/*************************************************************************
+ * Projet Raspi LCD display
+ *************************************************************************
+ * File : pic16f876a_controller_marquee.h
+ *************************************************************************
+ * Date : 19 Octobre 2026
+ * Author : Sinseman44
+ * Organization : Coloc's bar
+ *************************************************************************/
+
+/*************************************************************************
+ * Inclusion(s)
+ *************************************************************************/
+
+#include "pic16f876a_controller_include.h"
+
+/*************************************************************************
+ * Constante(s)
+ *************************************************************************/
+
+#ifndef MARQUEE_MAX_SIZE
+#define MARQUEE_MAX_SIZE		32		/*!< Text size max (make MARQUEE_SIZE=56) */
+#endif
+
+/*************************************************************************
+ * Enuméré(s)
+ *************************************************************************/ 
+
+/*************************************************************************
+ * Structure(s)
+ *************************************************************************/ 
+
+/*************************************************************************
+ * Variable(s)
+ *************************************************************************/
+
+/*************************************************************************
+ * Prototypes(s)
+ *************************************************************************/
+
+void marquee_init(void);
+
+int8_t marquee_put(const uint8_t /* in */ ui8_offset,
+		   const uint8_t /* in */ ui8_value);
+
+int8_t marquee_start(const uint8_t /* in */ ui8_row,
+		     const uint8_t /* in */ ui8_period,
+		     const uint8_t /* in */ ui8_size);
+
+void marquee_task(void);
+
+#endif /* PIC16F876A_CONTROLLER_MARQUEE */
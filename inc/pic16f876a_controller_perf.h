@@ -0,0 +1,79 @@
+#ifndef PIC16F876A_CONTROLLER_PERF
+#define PIC16F876A_CONTROLLER_PERF
+
+/*************************************************************************
+ * Projet Raspi LCD display
+ *************************************************************************
+ * File : pic16f876a_controller_perf.h
+ *************************************************************************
+ * Date : 19 Octobre 2026
+ * Author : Sinseman44
+ * Organization : Coloc's bar
+ *************************************************************************/
+
+/*************************************************************************
+ * Inclusion(s)
+ *************************************************************************/
+
+#include "pic16f876a_controller_include.h"
+
+/*************************************************************************
+ * Constante(s)
+ *************************************************************************/
+
+#define PERF_T1CON			0x11	/*!< Timer1 on, Fosc/4, 1:2 (1 us) */
+
+/*************************************************************************
+ * Enuméré(s)
+ *************************************************************************/ 
+
+/*************************************************************************
+ * Structure(s)
+ *************************************************************************/ 
+
+/*************************************************************************
+ * Variable(s)
+ *************************************************************************/
+
+/*************************************************************************
+ * Prototypes(s)
+ *************************************************************************/
+
+#ifdef PERF_ENABLE
+
+void perf_init(void);
+
+void perf_reset(void);
+
+void perf_isr_begin(void);
+
+void perf_isr_end(void);
+
+void perf_isr_frame(const uint8_t /* in */ ui8_frame_id);
+
+void perf_isr_drop(const uint8_t /* in */ ui8_nb_bytes);
+
+void perf_isr_overflow(void);
+
+void perf_decode_begin(void);
+
+void perf_decode_end(const uint8_t /* in */ ui8_frame_id);
+
+uint8_t perf_read_byte(const uint8_t /* in */ ui8_idx);
+
+#else
+
+#define perf_init()
+#define perf_reset()
+#define perf_isr_begin()
+#define perf_isr_end()
+#define perf_isr_frame(ui8_frame_id)
+#define perf_isr_drop(ui8_nb_bytes)
+#define perf_isr_overflow()
+#define perf_decode_begin()
+#define perf_decode_end(ui8_frame_id)
+#define perf_read_byte(ui8_idx)			0
+
+#endif /* PERF_ENABLE */
+
+#endif /* PIC16F876A_CONTROLLER_PERF */
@@ -0,0 +1,65 @@
+#ifndef PIC16F876A_CONTROLLER_SCHEDULE
+#define PIC16F876A_CONTROLLER_SCHEDULE
+
+/*************************************************************************
+ * Projet Raspi LCD display
+ *************************************************************************
+ * File : pic16f876a_controller_schedule.h
+ *************************************************************************
+ * Date : 19 Octobre 2026
+ * Author : Sinseman44
+ * Organization : Coloc's bar
+ *************************************************************************/
+
+/*************************************************************************
+ * Inclusion(s)
+ *************************************************************************/
+
+#include "pic16f876a_controller_include.h"
+
+/*************************************************************************
+ * Constante(s)
+ *************************************************************************/
+
+#define RET_SCHEDULE_OK			 0
+#define RET_SCHEDULE_NOK		-1
+#define RET_SCHEDULE_EMPTY		-2
+
+#ifndef SCHEDULE_BUFFER_SIZE
+#define SCHEDULE_BUFFER_SIZE	32		/*!< Queue size, headers included (make SCHEDULE_SIZE=8) */
+#endif
+
+/*************************************************************************
+ * Enuméré(s)
+ *************************************************************************/ 
+
+/*************************************************************************
+ * Structure(s)
+ *************************************************************************/ 
+
+/*************************************************************************
+ * Variable(s)
+ *************************************************************************/
+
+extern uint16_t gui16_schedule_offset;	/*!< Master time - tick */
+
+/*************************************************************************
+ * Prototypes(s)
+ *************************************************************************/
+
+void schedule_init(void);
+
+void schedule_set_time(const uint16_t /* in */ ui16_time);
+
+int8_t schedule_open(const uint16_t /* in */ ui16_deadline,
+		     const uint8_t /* in */ ui8_size);
+
+int8_t schedule_put(const uint8_t /* in */ ui8_value);
+
+uint8_t schedule_is_due(void);
+
+int8_t schedule_get(uint8_t * /* out */ const pui8_value);
+
+void schedule_pop(void);
+
+#endif /* PIC16F876A_CONTROLLER_SCHEDULE */
@@ -0,0 +1,65 @@
+#ifndef PIC16F876A_CONTROLLER_TIMER
+#define PIC16F876A_CONTROLLER_TIMER
+
+/*************************************************************************
+ * Projet Raspi LCD display
+ *************************************************************************
+ * File : pic16f876a_controller_timer.h
+ *************************************************************************
+ * Date : 19 Octobre 2026
+ * Author : Sinseman44
+ * Organization : Coloc's bar
+ *************************************************************************/
+
+/*************************************************************************
+ * Inclusion(s)
+ *************************************************************************/
+
+#include "pic16f876a_controller_include.h"
+
+/*************************************************************************
+ * Constante(s)
+ *************************************************************************/
+
+#define TIMER_TICK_MS			1		/*!< Tick period (ms) */
+
+/*************************************************************************
+ * Enuméré(s)
+ *************************************************************************/ 
+
+/*************************************************************************
+ * Structure(s)
+ *************************************************************************/ 
+
+/*************************************************************************
+ * Variable(s)
+ *************************************************************************/
+
+extern bank0 volatile uint16_t gui16_timer_tick;	/*!< Number of ticks since the start */
+
+/*************************************************************************
+ * Prototypes(s)
+ *************************************************************************/
+
+/*
+ * Initialise the tick timer (Timer2)
+ */
+void timer_init(void);
+
+/*
+ * Count a tick (Timer2 interrupt)
+ */
+void timer_isr(void);
+
+/*
+ * Retrieve the tick counter
+ */
+uint16_t timer_get_tick(void);
+
+/*
+ * Test if a number of ticks has elapsed since a tick value
+ */
+uint8_t timer_elapsed(const uint16_t /* in */ ui16_since,
+		      const uint16_t /* in */ ui16_nb_ticks);
+
+#endif /* PIC16F876A_CONTROLLER_TIMER */
@@ -0,0 +1,71 @@
+#ifndef PIC16F876A_CONTROLLER_TRACE
+#define PIC16F876A_CONTROLLER_TRACE
+
+/*************************************************************************
+ * Projet Raspi LCD display
+ *************************************************************************
+ * File : pic16f876a_controller_trace.h
+ *************************************************************************
+ * Date : 19 Octobre 2026
+ * Author : Sinseman44
+ * Organization : Coloc's bar
+ *************************************************************************/
+
+/*
+ * Trace points :
+ * --------------
+ * A trace point drives a spare pin high while a part of the code runs,
+ * to be watched with a scope or a logic analyser. Each begin or end is a
+ * single bit set or clear. Without TRACE_ENABLE (make TRACE=1) the trace
+ * points are removed and the pins stay inputs.
+ *
+ * The host emulator (make emu, see tools/emu/emu_main.c) builds the trace
+ * points and writes the RB6/RB7 waveforms with the LCD pins and the bus
+ * lines to a VCD file (-v file.vcd). Its times come from a cost per basic
+ * block, on the board the logic analyser captures the real ones.
+ */
+
+/*************************************************************************
+ * Inclusion(s)
+ *************************************************************************/
+
+#include "pic16f876a_controller_include.h"
+
+/*************************************************************************
+ * Constante(s)
+ *************************************************************************/
+
+#ifdef TRACE_ENABLE
+
+#define TRACE_ISR			RB7		/*!< High during the interrupt */
+#define TRACE_DECODE		RB6		/*!< High during a frame decoding */
+
+#define TRACE_INIT()		do { RB6 = 0; RB7 = 0; TRISB6 = 0; TRISB7 = 0; } while(0)
+#define TRACE_BEGIN(point)	((point) = 1)
+#define TRACE_END(point)	((point) = 0)
+
+#else
+
+#define TRACE_INIT()
+#define TRACE_BEGIN(point)
+#define TRACE_END(point)
+
+#endif /* TRACE_ENABLE */
+
+/*************************************************************************
+ * Enuméré(s)
+ *************************************************************************/ 
+
+/*************************************************************************
+ * Structure(s)
+ *************************************************************************/ 
+
+/*************************************************************************
+ * Variable(s)
+ *************************************************************************/
+
+/*************************************************************************
+ * Prototypes(s)
+ *************************************************************************/
+
+#endif /* PIC16F876A_CONTROLLER_TRACE */
@@ -0,0 +1,76 @@
+#ifndef PIC16F876A_CONTROLLER_TRANSPORT
+#define PIC16F876A_CONTROLLER_TRANSPORT
+
+/*************************************************************************
+ * Projet Raspi LCD display
+ *************************************************************************
+ * File : pic16f876a_controller_transport.h
+ *************************************************************************
+ * Date : 19 Octobre 2026
+ * Author : Sinseman44
+ * Organization : Coloc's bar
+ *************************************************************************/
+
+/*
+ * Transport :
+ * -----------
+ * The bytes are received by one transport chosen when building 
+ * (make TRANSPORT=uart or spi, I2C by default) and given to the frame layer
+ * from the interrupt :
+ *   frame_receive_start() : the bytes which follow start a new frame
+ *   frame_receive_resync(): bytes lost, the next frame follows a sync byte
+ *   frame_receive()       : a byte received
+ *   frame_read_byte()     : a byte to send (I2C read)
+ * The set address frame only changes the I2C slave address.
+ */
+
+/*************************************************************************
+ * Inclusion(s)
+ *************************************************************************/
+
+#if defined(TRANSPORT_UART)
+#include "pic16f876a_controller_uart.h"
+#elif defined(TRANSPORT_SPI)
+#include "pic16f876a_controller_spi.h"
+#else
+#include "pic16f876a_controller_i2c.h"
+#endif
+
+/*************************************************************************
+ * Constante(s)
+ *************************************************************************/
+
+#if defined(TRANSPORT_UART)
+#define TRANSPORT_INIT()		uart_init()
+#define TRANSPORT_IRQ			RCIF		/*!< Cleared by reading RCREG */
+#define TRANSPORT_ISR()			uart_isr()
+#define TRANSPORT_SET_ADDR(addr)
+#elif defined(TRANSPORT_SPI)
+#define TRANSPORT_INIT()		spi_init()
+#define TRANSPORT_IRQ			(SSPIF | INTF)	/*!< Byte or framing line */
+#define TRANSPORT_ISR()			spi_isr()
+#define TRANSPORT_SET_ADDR(addr)
+#else
+#define TRANSPORT_INIT()		i2c_init()
+#define TRANSPORT_IRQ			SSPIF
+#define TRANSPORT_ISR()			i2c_isr()
+#define TRANSPORT_SET_ADDR(addr)	i2c_set_own_addr(addr)
+#endif
+
+/*************************************************************************
+ * Enuméré(s)
+ *************************************************************************/ 
+
+/*************************************************************************
+ * Structure(s)
+ *************************************************************************/ 
+
+/*************************************************************************
+ * Variable(s)
+ *************************************************************************/
+
+/*************************************************************************
+ * Prototypes(s)
+ *************************************************************************/
+
+#endif /* PIC16F876A_CONTROLLER_TRANSPORT */
@@ -0,0 +1,48 @@
+#ifndef PIC16F876A_CONTROLLER_UART
+#define PIC16F876A_CONTROLLER_UART
+
+/*************************************************************************
+ * Projet Raspi LCD display
+ *************************************************************************
+ * File : pic16f876a_controller_uart.h
+ *************************************************************************
+ * Date : 19 Octobre 2026
+ * Author : Sinseman44
+ * Organization : Coloc's bar
+ *************************************************************************/
+
+/*************************************************************************
+ * Inclusion(s)
+ *************************************************************************/
+
+#include "pic16f876a_controller_include.h"
+
+/*************************************************************************
+ * Constante(s)
+ *************************************************************************/
+
+#ifndef UART_BAUD
+#define UART_BAUD			125000UL	/*!< Baud rate (make BAUD=250000) */
+#endif
+
+/*************************************************************************
+ * Enuméré(s)
+ *************************************************************************/ 
+
+/*************************************************************************
+ * Structure(s)
+ *************************************************************************/ 
+
+/*************************************************************************
+ * Variable(s)
+ *************************************************************************/
+
+/*************************************************************************
+ * Prototypes(s)
+ *************************************************************************/
+
+void uart_init(void);
+
+void uart_isr(void);
+
+#endif /* PIC16F876A_CONTROLLER_UART */
@@ -10,19 +10,19 @@
 
 /*                          PIC16F876A
  *                 ---------------------------
- *               --|(1) /MCLR        RB7 (28)|--
- *        LCD_D7 --|(2) RA0          RB6 (27)|--
- *        LCD_D6 --|(3) RA1          RB5 (26)|--
- *        LCD_D5 --|(4) RA2          RB4 (25)|--
- *        LCD_D4 --|(5) RA3          RB3 (24)|--
- *        LCD_RS --|(6) RA4          RB2 (23)|--
- *        LCD_EN --|(7) RA5          RB1 (22)|-- 
- *           0 V --|(8) VSS          RB0 (21)|--
+ *               --|(1) /MCLR        RB7 (28)|-- TRACE_ISR
+ *        LCD_D7 --|(2) RA0          RB6 (27)|-- TRACE_DECODE
+ *        LCD_D6 --|(3) RA1          RB5 (26)|-- Address strap 2 (I2C)
+ *        LCD_D5 --|(4) RA2          RB4 (25)|-- Address strap 1 (I2C)
+ *        LCD_D4 --|(5) RA3          RB3 (24)|-- SCL backpacks
+ *        LCD_RS --|(6) RA4          RB2 (23)|-- SDA backpacks
+ *        LCD_EN --|(7) RA5          RB1 (22)|-- LCD2_EN (second LCD)
+ *           0 V --|(8) VSS          RB0 (21)|-- SPI framing (SPI transport)
  *               --|(9) OSC1         VDD (20)|-- +5 V
  *               --|(10) OSC2        VSS (19)|--  0 V
- *               --|(11) RC0         RC7 (18)|-- 
- *               --|(12) RC1         RC6 (17)|-- 
- *               --|(13) RC2         RC5 (16)|-- LED
+ *               --|(11) RC0         RC7 (18)|-- RX (UART transport)
+ *               --|(12) RC1         RC6 (17)|-- TX (UART transport)
+ *               --|(13) RC2         RC5 (16)|-- LED (none with SPI, SDO)
  *      SCL Line --|(14) SCL         SDA (15)|-- SDA Line
  *                 ---------------------------
  */
@@ -32,18 +32,23 @@
  *************************************************************************/
 
 #include "pic16f876a_controller_frame.h"
-#include "pic16f876a_controller_i2c.h"
+#include "pic16f876a_controller_transport.h"
+#include "pic16f876a_controller_eeprom.h"
+#include "pic16f876a_controller_timer.h"
+#include "pic16f876a_controller_perf.h"
+#include "pic16f876a_controller_trace.h"
 
 /*************************************************************************
  * Constante(s)
  *************************************************************************/
 
 // macro used to program the configuration fuses
-__CONFIG(CP_OFF & DEBUG_OFF & WRT_OFF & CPD_OFF & LVP_OFF & BOREN_OFF & PWRTE_ON & WDTE_OFF & FOSC_HS);
+__CONFIG(CP_OFF & DEBUG_OFF & WRT_OFF & CPD_OFF & LVP_OFF & BOREN_ON & PWRTE_ON & WDTE_OFF & FOSC_HS);
 
-uint8_t gui8_recv_byte_idx = 0; /*!< */
-uint8_t gui8_frame_recv_size = 0; /*!< */
-uint8_t gui8_token = 0; /*!< number of frames received from I2C bus */
+#define RESET_POWER_ON		0 /*!< Power-on reset */
+#define RESET_BROWN_OUT		1 /*!< Brown-out reset */
+#define RESET_WATCHDOG		2 /*!< Watchdog time-out reset */
+#define RESET_MCLR			3 /*!< MCLR reset */
 
 /**
  * @fn void interrupt ISR_handle(void)
@@ -53,39 +58,26 @@ uint8_t gui8_token = 0; /*!< number of frames received from I2C bus */
  * @return nothing
  */
 void interrupt ISR_handle(void) {
-	uint8_t ui8_slave_state = 0;
-	uint8_t ui8_i2c_value = 0;
-	if(SSPIF == 1) {
-		SSPIF = 0; // Reset IRQ flag
-		i2c_slave_state(&ui8_slave_state);
-		if((ui8_slave_state == 1) || (ui8_slave_state == 3)) {
-			i2c_slave_read(); // Read SSPBUF to clear BF bit but don't care about returned value
-			gui8_recv_byte_idx = 0;
-			gui8_frame_recv_size = 0;
-		}
-		else if(ui8_slave_state == 2) {
-			ui8_i2c_value = i2c_slave_read(); // Read SSPBUF to clear BF bit and read data from master
-			fifo_put(ui8_i2c_value);
-
-			// copy frame size byte
-			if(gui8_recv_byte_idx == 1) {
-				gui8_frame_recv_size = ui8_i2c_value - 1;
-			}
-			/* else nothing to do */
+	TRACE_BEGIN(TRACE_ISR);
+	perf_isr_begin();
+	if(TRANSPORT_IRQ == 1) {
+		TRANSPORT_ISR(); // bytes received go to the frame layer
+	}
+	/* else nothing to do */
 
-			// indicate that is the last byte received
-			if((gui8_frame_recv_size == gui8_recv_byte_idx) && 
-			   (gui8_recv_byte_idx != 0)) {
-				gui8_token ++; // increase the number of frames received
-			}
-			/* else nothing to do */
+	if(TMR2IF == 1) {
+		TMR2IF = 0; // Reset IRQ flag
+		timer_isr();
+	}
+	/* else nothing to do */
 
-			gui8_recv_byte_idx ++;
-		}
-		/* else nothing to do */
-		CKP = 1;
+	if(EEIF == 1) {
+		EEIF = 0; // Reset IRQ flag
+		eeprom_write_done(); // start the next queued write
 	}
 	/* else nothing to do */
+	perf_isr_end();
+	TRACE_END(TRACE_ISR);
 }
 
 /**
@@ -103,6 +95,33 @@ void interrupt_init(void) {
 	PEIE = 1;
 }
 
+/**
+ * @fn uint8_t reset_get_cause(void)
+ * @brief retrieve the cause of the last reset and re-arm the POR/BOR bits
+ *
+ * @param none
+ * @return RESET_POWER_ON, RESET_BROWN_OUT, RESET_WATCHDOG or RESET_MCLR
+ */
+uint8_t reset_get_cause(void) {
+	uint8_t ui8_cause = RESET_MCLR;
+
+	if(POR == 0) {
+		ui8_cause = RESET_POWER_ON;
+	}
+	else if(BOR == 0) {
+		ui8_cause = RESET_BROWN_OUT;
+	}
+	else if(TO == 0) {
+		ui8_cause = RESET_WATCHDOG;
+	}
+	/* else nothing to do */
+
+	// BOR is unknown after a power-on reset
+	POR = 1;
+	BOR = 1;
+	return ui8_cause;
+}
+
 /**
  * @fn void main(void)
  * @brief main process
@@ -110,40 +129,55 @@ void interrupt_init(void) {
  * @return none
  */
 void main(void) {
+#ifndef TRANSPORT_SPI
+	// RC5 is the SDO pin of the SPI transport, there is no LED
 	TRISC5 = 0;
-	TRISB7 = 0;
-	TRISB6 = 0;
 	RC5 = 0;
-	RB7 = 0;
-	RB6 = 0;
+#endif
+	TRACE_INIT();
+#ifndef TRANSPORT_SPI
 	uint16_t ui16_blink = 0;
+#endif
 	int8_t i8_ret = -1;
+	uint8_t ui8_warm_boot = 0;
 
-	// initialise uart
-	//~ uart_init();
+	if(reset_get_cause() != RESET_POWER_ON) {
+		ui8_warm_boot = 1;
+	}
+	/* else nothing to do */
 
 	// initialise Fifo	
 	fifo_init();
 
+	// initialise EEPROM write queue
+	eeprom_init();
+
+	// initialise tick timer
+	timer_init();
+
+	// start the performance measurements (Timer1)
+	perf_init();
+
+	// initialise the transport (I2C, UART or SPI)
+	TRANSPORT_INIT();
+
 	// initialisation
 	interrupt_init();
 
-	// initialise I2C HW
-	i2c_init();
-
-	// initialise lcd HW
-	frame_init();
-	
-	//~ uart_printf("LCD 2x16 CONTROLLER TEST\n\0");
+	// start lcd HW initialisation, frames received meanwhile are buffered
+	frame_init(ui8_warm_boot);
 	
 	while(1) {
-		// test if frames are in the buffer
-		if(gui8_token != 0) {
+		// run the timed tasks (lcd initialisation, scroll)
+		frame_task();
+
+		// test if frames are in the buffer and the lcd is initialised
+		if((frame_is_ready() == 1) && (frame_is_pending() == 1)) {
 			i8_ret = frame_decode_fifo(); // decode frame and execute actions
-			gui8_token --; // decrease number of frames in the buffer
 		}
 		/* else nothing to do */
 		
+#ifndef TRANSPORT_SPI
 		if(ui16_blink == 65000) {
 			if(RC5 == 1) {
 				RC5 = 0;
@@ -156,5 +190,6 @@ void main(void) {
 		else {
 			ui16_blink ++;
 		}
+#endif
 	}
 }
@@ -0,0 +1,179 @@
+/*************************************************************************
+ * Projet Raspberry pi lcd controller
+ *************************************************************************
+ * File : pic16f876a_controller_animate.c
+ *************************************************************************
+ * Date : 19 Octobre 2026
+ * Author : Sinseman44
+ * Organization : Coloc's bar
+ *************************************************************************/
+
+/*
+ * Glyph animation :
+ * -----------------
+ * A cell cycles through a sequence of characters (ROM characters or
+ * CGRAM glyphs 0 to 7) at its own period, without any frame from the
+ * master : spinner, blinking icon, activity indicator ...
+ *
+ *   slot : | Cell | Period | Glyph 1 | Glyph 2 | ... | Glyph n |
+ *
+ * A glyph shown in several cells is animated everywhere by rewriting
+ * its bitmap once with a DEFINE_CHAR frame.
+ */
+
+/*************************************************************************
+ * Inclusion(s)
+ *************************************************************************/
+
+#include "pic16f876a_controller_animate.h"
+#include "pic16f876a_controller_lcd.h"
+#include "pic16f876a_controller_timer.h"
+
+/*************************************************************************
+ * Constante(s)/Macro(s)
+ *************************************************************************/
+
+#define ANIMATE_UNIT			10		/*!< Unit of the period (ms) */
+
+bank2 uint8_t gpui8_animate_cell[ANIMATE_NB_SLOTS];		/*!< Animated cell */
+bank2 uint8_t gpui8_animate_period[ANIMATE_NB_SLOTS];		/*!< Period (0 : free slot) */
+bank2 uint8_t gpui8_animate_nb_glyphs[ANIMATE_NB_SLOTS];	/*!< Glyphs in the sequence */
+bank2 uint8_t gpui8_animate_idx[ANIMATE_NB_SLOTS];		/*!< Next glyph shown */
+bank2 uint16_t gpui16_animate_start[ANIMATE_NB_SLOTS];	/*!< Tick of the last step */
+bank2 uint8_t gppui8_animate_glyphs[ANIMATE_NB_SLOTS][ANIMATE_MAX_GLYPHS];	/*!< Sequences */
+
+/*************************************************************************
+ * Prototype(s)
+ *************************************************************************/
+
+/*************************************************************************
+ * Fonction(s)
+ *************************************************************************/
+
+/**
+ * @fn void animate_init(void)
+ * @brief free all the slots
+ * @param none
+ * @return none
+ */
+void animate_init(void) {
+	uint8_t ui8_slot = 0;
+
+	for(ui8_slot = 0; ui8_slot < ANIMATE_NB_SLOTS; ui8_slot ++) {
+		gpui8_animate_period[ui8_slot] = 0;
+	}
+}
+
+/**
+ * @fn int8_t animate_start(const uint8_t ui8_row,
+ *			    const uint8_t ui8_column,
+ *			    const uint8_t ui8_period,
+ *			    const uint8_t * pui8_glyphs,
+ *			    const uint8_t ui8_nb_glyphs)
+ * @brief animate a cell (or stop it when the period is 0)
+ *
+ * The slot already animating the cell is reused, otherwise a free one.
+ *
+ * @param [in] ui8_row		row of the cell (1 to 2)
+ * @param [in] ui8_column	column of the cell (1 to 16)
+ * @param [in] ui8_period	time between glyphs (10 ms unit), 0 stops
+ * @param [in] pui8_glyphs	sequence of characters
+ * @param [in] ui8_nb_glyphs	number of characters in the sequence
+ * @return RET_NOK if a parameter is invalid or no slot is free 
+ *         otherwise RET_OK
+ */
+int8_t animate_start(const uint8_t /* in */ ui8_row,
+		     const uint8_t /* in */ ui8_column,
+		     const uint8_t /* in */ ui8_period,
+		     const uint8_t * /* in */ pui8_glyphs,
+		     const uint8_t /* in */ ui8_nb_glyphs) {
+	uint8_t ui8_cell = 0;
+	uint8_t ui8_slot = 0;
+	uint8_t ui8_free = ANIMATE_NB_SLOTS;
+	uint8_t ui8_idx = 0;
+
+	if((ui8_row == 0) || 
+	   (ui8_row > LCD_NB_ROWS) ||
+	   (ui8_column == 0) ||
+	   (ui8_column > LCD_NB_COLUMNS) ||
+	   (ui8_nb_glyphs > ANIMATE_MAX_GLYPHS)) {
+		return RET_NOK;
+	}
+	/* else nothing to do */
+
+	ui8_cell = ((ui8_row - 1) * LCD_NB_COLUMNS) + (ui8_column - 1);
+	for(ui8_slot = 0; ui8_slot < ANIMATE_NB_SLOTS; ui8_slot ++) {
+		if(gpui8_animate_period[ui8_slot] == 0) {
+			if(ui8_free == ANIMATE_NB_SLOTS) {
+				ui8_free = ui8_slot;
+			}
+			/* else nothing to do */
+		}
+		else if(gpui8_animate_cell[ui8_slot] == ui8_cell) {
+			break;
+		}
+		/* else nothing to do */
+	}
+
+	if(ui8_slot == ANIMATE_NB_SLOTS) {
+		if((ui8_period == 0) || (ui8_nb_glyphs == 0)) {
+			// nothing to stop
+			return RET_OK;
+		}
+		/* else nothing to do */
+		if(ui8_free == ANIMATE_NB_SLOTS) {
+			return RET_NOK;
+		}
+		/* else nothing to do */
+		ui8_slot = ui8_free;
+	}
+	/* else nothing to do */
+
+	if(ui8_nb_glyphs == 0) {
+		gpui8_animate_period[ui8_slot] = 0;
+		return RET_OK;
+	}
+	/* else nothing to do */
+
+	for(ui8_idx = 0; ui8_idx < ui8_nb_glyphs; ui8_idx ++) {
+		gppui8_animate_glyphs[ui8_slot][ui8_idx] = pui8_glyphs[ui8_idx];
+	}
+	gpui8_animate_cell[ui8_slot] = ui8_cell;
+	gpui8_animate_nb_glyphs[ui8_slot] = ui8_nb_glyphs;
+	gpui8_animate_idx[ui8_slot] = 0;
+	gpui8_animate_period[ui8_slot] = ui8_period;
+	// first glyph now
+	gpui16_animate_start[ui8_slot] = timer_get_tick() - ((uint16_t)ui8_period * ANIMATE_UNIT);
+	return RET_OK;
+}
+
+/**
+ * @fn void animate_task(void)
+ * @brief show the next glyph of the cells whose period is elapsed
+ * @param none
+ * @return none
+ */
+void animate_task(void) {
+	uint8_t ui8_slot = 0;
+	uint8_t ui8_idx = 0;
+	uint16_t ui16_period = 0;
+
+	for(ui8_slot = 0; ui8_slot < ANIMATE_NB_SLOTS; ui8_slot ++) {
+		ui16_period = (uint16_t)gpui8_animate_period[ui8_slot] * ANIMATE_UNIT;
+		if((ui16_period != 0) &&
+		   (timer_elapsed(gpui16_animate_start[ui8_slot], ui16_period) == 1)) {
+			gpui16_animate_start[ui8_slot] += ui16_period;
+
+			ui8_idx = gpui8_animate_idx[ui8_slot];
+			lcd_write_cell(gpui8_animate_cell[ui8_slot], 
+				       gppui8_animate_glyphs[ui8_slot][ui8_idx]);
+			ui8_idx ++;
+			if(ui8_idx == gpui8_animate_nb_glyphs[ui8_slot]) {
+				ui8_idx = 0;
+			}
+			/* else nothing to do */
+			gpui8_animate_idx[ui8_slot] = ui8_idx;
+		}
+		/* else nothing to do */
+	}
+}
@@ -0,0 +1,467 @@
+/*************************************************************************
+ * Projet Raspberry pi lcd controller
+ *************************************************************************
+ * File : pic16f876a_controller_backpack.c
+ *************************************************************************
+ * Date : 19 Octobre 2026
+ * Author : Sinseman44
+ * Organization : Coloc's bar
+ *************************************************************************/
+
+/*
+ * PCF8574 backpacks (make BACKPACK=1 or BACKPACK=2) :
+ * ---------------------------------------------------
+ * HD44780 16x2 behind a PCF8574 I2C expander, on a second I2C bus driven
+ * by software as a master (the MSSP is the slave of the Raspberry pi) :
+ * SDA on RB2, SCL on RB3, open drain with 4.7k pull-ups, about 50 kHz.
+ *
+ *      PCF8574 : P0 RS | P1 RW | P2 EN | P3 backlight | P4-P7 D4-D7
+ *      Address : 0x27 for the first backpack (A0-A2 high), 0x26, ...
+ *
+ * The frames only write the shadow of the backpack and mark the cells
+ * which changed, they are decoded at once. The bus traffic (4 bytes of
+ * the expander per LCD byte) is done by backpack_task() in the main loop,
+ * one cell per backpack and per call : a cell written several times is
+ * only sent with its last value and the consecutive cells are sent
+ * without setting the address. The backlight follows the display bit of
+ * the control display frame.
+ *
+ * RAM : 40 bytes per backpack, the screen of the second one is in the
+ * bank 3 and takes 32 bytes of the marquee text and of the schedule
+ * queue. Custom characters aren't sent to the backpacks : their glyphs
+ * would need 8 more bytes per backpack, or a transfer of about 4 ms
+ * while the frame is decoded.
+ */
+
+/*************************************************************************
+ * Inclusion(s)
+ *************************************************************************/
+
+#include "pic16f876a_controller_backpack.h"
+#include "pic16f876a_controller_lcd.h"
+#include "pic16f876a_controller_timer.h"
+
+/*************************************************************************
+ * Constante(s)/Macro(s)
+ *************************************************************************/
+
+#if defined(ANIMATE_ENABLE) || defined(PERF_ENABLE)
+#error "BACKPACK=1 or 2 doesn't fit in the RAM with ANIMATE=1 or PERF=1"
+#endif
+#if (BACKPACK_NB < 1) || (BACKPACK_NB > 2)
+#error "BACKPACK=1 or 2 only (display field of the frames)"
+#endif
+
+#define BACKPACK_SDA		RB2
+#define BACKPACK_SCL		RB3
+
+// open drain : a line is released as an input and driven low as an output,
+// the latch is cleared first (the other pins of the port B are written
+// with a read-modify-write)
+#define BACKPACK_SDA_HIGH()	do { TRISB2 = 1; } while(0)
+#define BACKPACK_SDA_LOW()	do { BACKPACK_SDA = 0; TRISB2 = 0; } while(0)
+#define BACKPACK_SCL_HIGH()	do { TRISB3 = 1; } while(0)
+#define BACKPACK_SCL_LOW()	do { BACKPACK_SCL = 0; TRISB3 = 0; } while(0)
+#define BACKPACK_HALF_BIT()	__delay_us(5)
+
+#define BACKPACK_ADDR		0x27	/*!< PCF8574 of the first backpack */
+#define BACKPACK_RS			0x01	/*!< PCF8574 pin of RS */
+#define BACKPACK_EN			0x04	/*!< PCF8574 pin of EN */
+#define BACKPACK_LIGHT		0x08	/*!< PCF8574 pin of the backlight */
+
+#define BACKPACK_DIRTY_SIZE	(LCD_SCREEN_SIZE / 8)	/*!< Bytes of the dirty bits */
+#define BACKPACK_CONTROL_ON	0x0C	/*!< Display on, cursor off, blink off */
+#define BACKPACK_CURSOR_SHOWN	0x03	/*!< Cursor or blink bits of display control */
+
+#define BACKPACK_INIT_NB_STEPS	8		/*!< Steps of the power-on sequence */
+#define BACKPACK_INIT_NB_NIBBLES	4	/*!< First steps : a nibble only */
+#define BACKPACK_INIT_DELAY		15		/*!< Time before each step (ms) */
+
+const uint8_t gpui8_backpack_init_seq[BACKPACK_INIT_NB_STEPS] = {0x30, 0x30, 0x30, 0x20, 0x28, 0x08, 0x01, 0x06};
+
+bank2 uint8_t gpui8_backpack_shadow_1[LCD_SCREEN_SIZE];	/*!< Screen to show of the first backpack */
+#if BACKPACK_NB > 1
+// no bank has room for both screens
+bank3 uint8_t gpui8_backpack_shadow_2[LCD_SCREEN_SIZE];	/*!< Screen to show of the second backpack */
+#endif
+uint8_t * const gppui8_backpack_shadow[BACKPACK_NB] = {
+#if BACKPACK_NB > 1
+	gpui8_backpack_shadow_1, gpui8_backpack_shadow_2
+#else
+	gpui8_backpack_shadow_1
+#endif
+};
+bank1 uint8_t gppui8_backpack_dirty[BACKPACK_NB][BACKPACK_DIRTY_SIZE];	/*!< Cells to send */
+bank1 uint8_t gpui8_backpack_cursor[BACKPACK_NB];		/*!< DDRAM address of the next character */
+bank1 uint8_t gpui8_backpack_addr[BACKPACK_NB];		/*!< DDRAM address counter of the LCD */
+bank1 uint8_t gpui8_backpack_control[BACKPACK_NB];	/*!< Display control command */
+bank1 uint8_t gpui8_backpack_control_dirty[BACKPACK_NB];	/*!< Display control to send */
+bank1 uint8_t gui8_backpack_init_step = 0;			/*!< Next step of the power-on sequence */
+bank1 uint16_t gui16_backpack_init_start = 0;			/*!< Tick of the last step */
+
+/*************************************************************************
+ * Prototype(s)
+ *************************************************************************/
+
+void backpack_bus_start(void);
+
+void backpack_bus_stop(void);
+
+uint8_t backpack_bus_write(const uint8_t /* in */ ui8_byte);
+
+void backpack_write(const uint8_t /* in */ ui8_backpack,
+		    const uint8_t /* in */ ui8_value,
+		    const uint8_t /* in */ ui8_rs,
+		    const uint8_t /* in */ ui8_nb_nibbles);
+
+void backpack_store(const uint8_t /* in */ ui8_backpack,
+		    const uint8_t /* in */ ui8_cell,
+		    const uint8_t /* in */ ui8_value);
+
+void backpack_flush(const uint8_t /* in */ ui8_backpack);
+
+/*************************************************************************
+ * Fonction(s)
+ *************************************************************************/
+
+/**
+ * @fn void backpack_bus_start(void)
+ * @brief start condition on the backpack bus
+ * @param none
+ * @return nothing
+ */
+void backpack_bus_start(void) {
+	BACKPACK_SDA_HIGH();
+	BACKPACK_SCL_HIGH();
+	BACKPACK_HALF_BIT();
+	BACKPACK_SDA_LOW();
+	BACKPACK_HALF_BIT();
+	BACKPACK_SCL_LOW();
+}
+
+/**
+ * @fn void backpack_bus_stop(void)
+ * @brief stop condition on the backpack bus
+ * @param none
+ * @return nothing
+ */
+void backpack_bus_stop(void) {
+	BACKPACK_SDA_LOW();
+	BACKPACK_HALF_BIT();
+	BACKPACK_SCL_HIGH();
+	BACKPACK_HALF_BIT();
+	BACKPACK_SDA_HIGH();
+	BACKPACK_HALF_BIT();
+}
+
+/**
+ * @fn uint8_t backpack_bus_write(const uint8_t ui8_byte)
+ * @brief write a byte on the backpack bus, MSB first
+ * @param [in] ui8_byte	byte to write
+ * @return 0 if the byte is acknowledged otherwise 1
+ */
+uint8_t backpack_bus_write(const uint8_t /* in */ ui8_byte) {
+	uint8_t ui8_idx = 0;
+	uint8_t ui8_nack = 0;
+
+	for(ui8_idx = 0; ui8_idx < 8; ui8_idx ++) {
+		if(((ui8_byte << ui8_idx) & 0x80) != 0) {
+			BACKPACK_SDA_HIGH();
+		}
+		else {
+			BACKPACK_SDA_LOW();
+		}
+		BACKPACK_HALF_BIT();
+		BACKPACK_SCL_HIGH();
+		BACKPACK_HALF_BIT();
+		BACKPACK_SCL_LOW();
+	}
+
+	// acknowledge bit
+	BACKPACK_SDA_HIGH();
+	BACKPACK_HALF_BIT();
+	BACKPACK_SCL_HIGH();
+	BACKPACK_HALF_BIT();
+	ui8_nack = BACKPACK_SDA;
+	BACKPACK_SCL_LOW();
+	return ui8_nack;
+}
+
+/**
+ * @fn void backpack_write(const uint8_t ui8_backpack, const uint8_t ui8_value,
+ *			   const uint8_t ui8_rs, const uint8_t ui8_nb_nibbles)
+ * @brief write a byte (or its upper nibble) to the LCD of a backpack,
+ *        each nibble is set on P4-P7 with EN high then low
+ *
+ * The instruction lasts less than the bus transfer of the next one, only
+ * the power-on sequence waits (clear display isn't used).
+ *
+ * @param [in] ui8_backpack	index of the backpack
+ * @param [in] ui8_value	byte to write
+ * @param [in] ui8_rs		BACKPACK_RS for a character, 0 for a command
+ * @param [in] ui8_nb_nibbles	2 or 1 (upper nibble only)
+ * @return nothing
+ */
+void backpack_write(const uint8_t /* in */ ui8_backpack,
+		    const uint8_t /* in */ ui8_value,
+		    const uint8_t /* in */ ui8_rs,
+		    const uint8_t /* in */ ui8_nb_nibbles) {
+	uint8_t ui8_pins = ui8_rs;
+	uint8_t ui8_data = ui8_value;
+	uint8_t ui8_idx = 0;
+
+	if((gpui8_backpack_control[ui8_backpack] & 0x04) != 0) {
+		ui8_pins |= BACKPACK_LIGHT;
+	}
+	/* else nothing to do */
+
+	backpack_bus_start();
+	if(backpack_bus_write((BACKPACK_ADDR - ui8_backpack) << 1) == 0) {
+		for(ui8_idx = 0; ui8_idx < ui8_nb_nibbles; ui8_idx ++) {
+			backpack_bus_write((ui8_data & 0xF0) | ui8_pins | BACKPACK_EN);
+			backpack_bus_write((ui8_data & 0xF0) | ui8_pins);
+			ui8_data <<= 4;
+		}
+	}
+	/* else no backpack at this address */
+	backpack_bus_stop();
+}
+
+/**
+ * @fn void backpack_init(void)
+ * @brief release the bus and start the power-on sequence of the backpacks
+ * @param none
+ * @return nothing
+ */
+void backpack_init(void) {
+	uint8_t ui8_backpack = 0;
+	uint8_t ui8_idx = 0;
+
+	BACKPACK_SDA_HIGH();
+	BACKPACK_SCL_HIGH();
+
+	for(ui8_backpack = 0; ui8_backpack < BACKPACK_NB; ui8_backpack ++) {
+		// cleared by the power-on sequence
+		for(ui8_idx = 0; ui8_idx < LCD_SCREEN_SIZE; ui8_idx ++) {
+			gppui8_backpack_shadow[ui8_backpack][ui8_idx] = ' ';
+		}
+		for(ui8_idx = 0; ui8_idx < BACKPACK_DIRTY_SIZE; ui8_idx ++) {
+			gppui8_backpack_dirty[ui8_backpack][ui8_idx] = 0;
+		}
+		gpui8_backpack_cursor[ui8_backpack] = 0;
+		gpui8_backpack_addr[ui8_backpack] = 0;
+		gpui8_backpack_control[ui8_backpack] = BACKPACK_CONTROL_ON;
+		// the display is switched on after the power-on sequence
+		gpui8_backpack_control_dirty[ui8_backpack] = 1;
+	}
+
+	gui8_backpack_init_step = 0;
+	gui16_backpack_init_start = timer_get_tick();
+}
+
+/**
+ * @fn void backpack_task(void)
+ * @brief go on with the power-on sequence, then send a changed cell (or
+ *        the display control) of each backpack
+ * @param none
+ * @return nothing
+ */
+void backpack_task(void) {
+	uint8_t ui8_backpack = 0;
+	uint8_t ui8_nb_nibbles = 2;
+
+	if(gui8_backpack_init_step < BACKPACK_INIT_NB_STEPS) {
+		if(timer_elapsed(gui16_backpack_init_start,
+				 (BACKPACK_INIT_DELAY / TIMER_TICK_MS) + 1) == 0) {
+			return;
+		}
+		/* else nothing to do */
+
+		// 8 bits function sets then four bits interface
+		if(gui8_backpack_init_step < BACKPACK_INIT_NB_NIBBLES) {
+			ui8_nb_nibbles = 1;
+		}
+		/* else nothing to do */
+		for(ui8_backpack = 0; ui8_backpack < BACKPACK_NB; ui8_backpack ++) {
+			backpack_write(ui8_backpack, gpui8_backpack_init_seq[gui8_backpack_init_step],
+				       0, ui8_nb_nibbles);
+		}
+		gui8_backpack_init_step ++;
+		gui16_backpack_init_start = timer_get_tick();
+		return;
+	}
+	/* else nothing to do */
+
+	for(ui8_backpack = 0; ui8_backpack < BACKPACK_NB; ui8_backpack ++) {
+		backpack_flush(ui8_backpack);
+	}
+}
+
+/**
+ * @fn void backpack_flush(const uint8_t ui8_backpack)
+ * @brief send the display control if it changed, otherwise the first
+ *        cell which changed, otherwise move the visible cursor
+ * @param [in] ui8_backpack	index of the backpack
+ * @return nothing
+ */
+void backpack_flush(const uint8_t /* in */ ui8_backpack) {
+	uint8_t ui8_cell = 0;
+	uint8_t ui8_addr = 0;
+	uint8_t ui8_bit = 0;
+
+	if(gpui8_backpack_control_dirty[ui8_backpack] == 1) {
+		gpui8_backpack_control_dirty[ui8_backpack] = 0;
+		backpack_write(ui8_backpack, gpui8_backpack_control[ui8_backpack], 0, 2);
+		return;
+	}
+	/* else nothing to do */
+
+	// unchanged bytes of cells are skipped
+	while((ui8_cell < LCD_SCREEN_SIZE) &&
+	      (gppui8_backpack_dirty[ui8_backpack][ui8_cell >> 3] == 0)) {
+		ui8_cell += 8;
+	}
+
+	if(ui8_cell == LCD_SCREEN_SIZE) {
+		ui8_addr = gpui8_backpack_cursor[ui8_backpack];
+		if(((gpui8_backpack_control[ui8_backpack] & BACKPACK_CURSOR_SHOWN) != 0) &&
+		   (gpui8_backpack_addr[ui8_backpack] != ui8_addr)) {
+			backpack_write(ui8_backpack, 0x80 | ui8_addr, 0, 2);
+			gpui8_backpack_addr[ui8_backpack] = ui8_addr;
+		}
+		/* else nothing to do */
+		return;
+	}
+	/* else nothing to do */
+
+	ui8_bit = 0x01;
+	while((gppui8_backpack_dirty[ui8_backpack][ui8_cell >> 3] & ui8_bit) == 0) {
+		ui8_bit <<= 1;
+		ui8_cell ++;
+	}
+	gppui8_backpack_dirty[ui8_backpack][ui8_cell >> 3] &= ~ui8_bit;
+
+	ui8_addr = lcd_cell_to_addr(ui8_cell);
+	if(gpui8_backpack_addr[ui8_backpack] != ui8_addr) {
+		backpack_write(ui8_backpack, 0x80 | ui8_addr, 0, 2);
+	}
+	/* else consecutive cells */
+	backpack_write(ui8_backpack, gppui8_backpack_shadow[ui8_backpack][ui8_cell], BACKPACK_RS, 2);
+	gpui8_backpack_addr[ui8_backpack] = lcd_next_addr(ui8_addr);
+}
+
+/**
+ * @fn void backpack_store(const uint8_t ui8_backpack, const uint8_t ui8_cell,
+ *			   const uint8_t ui8_value)
+ * @brief write a character in the shadow and mark the cell if it changes
+ * @param [in] ui8_backpack	index of the backpack
+ * @param [in] ui8_cell		index of the cell (0 to LCD_SCREEN_SIZE - 1)
+ * @param [in] ui8_value	character to write
+ * @return nothing
+ */
+void backpack_store(const uint8_t /* in */ ui8_backpack,
+		    const uint8_t /* in */ ui8_cell,
+		    const uint8_t /* in */ ui8_value) {
+	if(gppui8_backpack_shadow[ui8_backpack][ui8_cell] == ui8_value) {
+		return;
+	}
+	/* else nothing to do */
+
+	gppui8_backpack_shadow[ui8_backpack][ui8_cell] = ui8_value;
+	gppui8_backpack_dirty[ui8_backpack][ui8_cell >> 3] |= (uint8_t)(1 << (ui8_cell & 0x07));
+}
+
+/**
+ * @fn void backpack_clear(const uint8_t ui8_backpack)
+ * @brief clear the screen of a backpack and home its cursor, only the
+ *        cells which aren't blank are sent
+ * @param [in] ui8_backpack	index of the backpack
+ * @return nothing
+ */
+void backpack_clear(const uint8_t /* in */ ui8_backpack) {
+	uint8_t ui8_cell = 0;
+
+	for(ui8_cell = 0; ui8_cell < LCD_SCREEN_SIZE; ui8_cell ++) {
+		backpack_store(ui8_backpack, ui8_cell, ' ');
+	}
+	gpui8_backpack_cursor[ui8_backpack] = 0;
+}
+
+/**
+ * @fn void backpack_return_home(const uint8_t ui8_backpack)
+ * @brief move the cursor of a backpack to the top left
+ * @param [in] ui8_backpack	index of the backpack
+ * @return nothing
+ */
+void backpack_return_home(const uint8_t /* in */ ui8_backpack) {
+	gpui8_backpack_cursor[ui8_backpack] = 0;
+}
+
+/**
+ * @fn void backpack_set_cursor(const uint8_t ui8_backpack,
+ *				const uint8_t ui8_row, const uint8_t ui8_column)
+ * @brief move the cursor of a backpack
+ * @param [in] ui8_backpack	index of the backpack
+ * @param [in] ui8_row		1 or 2
+ * @param [in] ui8_column	1 to 40, columns 17 to 40 are never visible
+ * @return nothing
+ */
+void backpack_set_cursor(const uint8_t /* in */ ui8_backpack,
+			 const uint8_t /* in */ ui8_row,
+			 const uint8_t /* in */ ui8_column) {
+	uint8_t ui8_addr = ui8_column - 1;
+
+	if(ui8_row == 2) {
+		ui8_addr += 0x40;
+	}
+	/* else nothing to do */
+	gpui8_backpack_cursor[ui8_backpack] = ui8_addr & 0x7F;
+}
+
+/**
+ * @fn void backpack_put_char(const uint8_t ui8_backpack, const uint8_t ui8_value)
+ * @brief write a character at the cursor of a backpack
+ * @param [in] ui8_backpack	index of the backpack
+ * @param [in] ui8_value	character to write
+ * @return nothing
+ */
+void backpack_put_char(const uint8_t /* in */ ui8_backpack,
+		       const uint8_t /* in */ ui8_value) {
+	uint8_t ui8_addr = gpui8_backpack_cursor[ui8_backpack];
+	uint8_t ui8_cell = lcd_addr_to_cell(ui8_addr);
+
+	if(ui8_cell < LCD_SCREEN_SIZE) {
+		backpack_store(ui8_backpack, ui8_cell, ui8_value);
+	}
+	/* else hidden column */
+	gpui8_backpack_cursor[ui8_backpack] = lcd_next_addr(ui8_addr);
+}
+
+/**
+ * @fn int8_t backpack_set_control(const uint8_t ui8_backpack,
+ *				   const uint8_t ui8_display,
+ *				   const uint8_t ui8_cursor,
+ *				   const uint8_t ui8_blink)
+ * @brief set the display control of a backpack, the backlight is on
+ *        with the display
+ * @param [in] ui8_backpack	index of the backpack
+ * @param [in] ui8_display	display on (1) / off (0)
+ * @param [in] ui8_cursor	cursor on (1) / off (0)
+ * @param [in] ui8_blink	blink on (1) / off (0)
+ * @return RET_NOK if a parameter is invalid otherwise RET_OK
+ */
+int8_t backpack_set_control(const uint8_t /* in */ ui8_backpack,
+			    const uint8_t /* in */ ui8_display,
+			    const uint8_t /* in */ ui8_cursor,
+			    const uint8_t /* in */ ui8_blink) {
+	if((ui8_display > 1) ||
+	   (ui8_cursor > 1) ||
+	   (ui8_blink > 1)) {
+		return RET_NOK;
+	}
+	/* else nothing to do */
+
+	gpui8_backpack_control[ui8_backpack] = 0x08 | (ui8_display << 2) | (ui8_cursor << 1) | ui8_blink;
+	gpui8_backpack_control_dirty[ui8_backpack] = 1;
+	return RET_OK;
+}
@@ -0,0 +1,285 @@
+/*************************************************************************
+ * Projet Raspberry pi lcd controller
+ *************************************************************************
+ * File : pic16f876a_controller_eeprom.c
+ *************************************************************************
+ * Date : 19 Octobre 2026
+ * Author : Sinseman44
+ * Organization : Coloc's bar
+ *************************************************************************/
+
+/*
+ * A write cycle of the internal EEPROM lasts about 4 ms. Instead of 
+ * waiting for each cycle, bytes are queued and the next write is started 
+ * from the EEPROM write interrupt (EEIF) :
+ *
+ *   eeprom_async_write()             EEIF                 EEIF
+ *   ---------------------> | queue | -----> write cycle -----> write cycle ...
+ *
+ * Before a write cycle is started, the stored byte is read back and the
+ * write is skipped if it doesn't change the stored value.
+ *
+ * The main loop only waits when the queue is full, or when it reads an
+ * address while a write cycle is in progress (EEADR/EEDATA are used by
+ * the write cycle).
+ *
+ * Queue limit :
+ * -------------
+ * Only EEPROM_QUEUE_SIZE writes are absorbed without waiting. Beyond
+ * that, each queued byte waits for a write cycle (about 4 ms) and the
+ * decoding of frames stalls meanwhile :
+ *  - SAVE_SCREEN queues up to 34 bytes : about 120 ms if they all change,
+ *  - a macro record queues one byte per recorded frame byte : the 
+ *    decoding is paced at about 4 ms per byte and the text lane (32
+ *    bytes) doesn't absorb a record sent at full rate,
+ *  - lcd_erase_internal_mem() queues 255 bytes : about 1 s.
+ * Bytes already holding the value are skipped by the interrupt and only
+ * cost a queue entry.
+ *
+ * Host emulator (make emu, 6 cycles per block, modelled not measured on
+ * the board), a 4 ms write cycle :
+ *  - a text frame sent 1 ms after SAVE_SCREEN of a full screen is 
+ *    written 121 ms later (0.5 ms without SAVE_SCREEN, 2.2 ms when the
+ *    saved screen is unchanged),
+ *  - recording a PUT_STRING frame of a row (18 bytes) takes 57 ms of 
+ *    decoding : a master pausing 5 ms between the 11 frames of a record
+ *    loses 8 of them, it needs 60 ms between the frames to lose none.
+ */
+
+/*************************************************************************
+ * Inclusion(s)
+ *************************************************************************/
+
+#include "pic16f876a_controller_eeprom.h"
+
+/*************************************************************************
+ * Constante(s)/Macro(s)
+ *************************************************************************/
+
+#define EEPROM_QUEUE_SIZE		4		/*!< Queue size (power of 2) */
+#define EEPROM_QUEUE_MASK		(EEPROM_QUEUE_SIZE - 1)
+
+bank3 uint8_t gpui8_eeprom_addr[EEPROM_QUEUE_SIZE];	/*!< Queued addresses */
+bank3 uint8_t gpui8_eeprom_value[EEPROM_QUEUE_SIZE];	/*!< Queued values */
+bank3 volatile uint8_t gui8_eeprom_head = 0;			/*!< Next free entry (main loop) */
+bank3 volatile uint8_t gui8_eeprom_tail = 0;			/*!< Next entry to write (interrupt) */
+volatile bit gb_flag_eeprom_busy;			/*!< Write cycle in progress */
+bank3 uint8_t gui8_eeprom_cur_addr = 0;				/*!< Address being written */
+bank3 uint8_t gui8_eeprom_cur_value = 0;				/*!< Value being written */
+
+/*************************************************************************
+ * Prototype(s)
+ *************************************************************************/
+
+uint8_t eeprom_read_now(const uint8_t /* in */ ui8_addr);
+
+void eeprom_start_next(void);
+
+uint8_t eeprom_find_pending(const uint8_t /* in */ ui8_addr,
+			    uint8_t * const /* out */ pui8_value);
+
+/*************************************************************************
+ * Fonction(s)
+ *************************************************************************/
+
+/**
+ * @fn void eeprom_init(void)
+ * @brief initialise the write queue and the EEPROM write interrupt
+ * @param none
+ * @return none
+ */
+void eeprom_init(void) {
+	gui8_eeprom_head = 0;
+	gui8_eeprom_tail = 0;
+	gb_flag_eeprom_busy = 0;
+
+	// clear EEIF interrupt flag
+	EEIF = 0;
+	// enable EEPROM write interrupt
+	EEIE = 1;
+}
+
+/**
+ * @fn uint8_t eeprom_read_now(const uint8_t ui8_addr)
+ * @brief read a byte from the EEPROM
+ *        (no write cycle must be in progress)
+ * @param [in] ui8_addr
+ * @return the stored value
+ */
+uint8_t eeprom_read_now(const uint8_t /* in */ ui8_addr) {
+	EEADR = ui8_addr;
+	EEPGD = 0;
+	RD = 1;
+	return EEDATA;
+}
+
+/**
+ * @fn void eeprom_start_next(void)
+ * @brief start the write cycle of the next queued byte which changes
+ *        the stored value. Interrupts must be disabled.
+ * @param none
+ * @return none
+ */
+void eeprom_start_next(void) {
+	uint8_t ui8_addr = 0;
+	uint8_t ui8_value = 0;
+
+	gb_flag_eeprom_busy = 0;
+	while(gui8_eeprom_tail != gui8_eeprom_head) {
+		ui8_addr = gpui8_eeprom_addr[gui8_eeprom_tail];
+		ui8_value = gpui8_eeprom_value[gui8_eeprom_tail];
+		gui8_eeprom_tail = (gui8_eeprom_tail + 1) & EEPROM_QUEUE_MASK;
+
+		// skip writes which don't change the stored byte
+		if(eeprom_read_now(ui8_addr) != ui8_value) {
+			gui8_eeprom_cur_addr = ui8_addr;
+			gui8_eeprom_cur_value = ui8_value;
+
+			EEADR = ui8_addr;
+			EEDATA = ui8_value;
+			EEPGD = 0;
+			WREN = 1;
+			// required sequence
+			EECON2 = 0x55;
+			EECON2 = 0xAA;
+			WR = 1;
+			// the current write cycle isn't affected
+			WREN = 0;
+
+			gb_flag_eeprom_busy = 1;
+			return;
+		}
+		/* else nothing to do */
+	}
+}
+
+/**
+ * @fn void eeprom_write_done(void)
+ * @brief called from the EEPROM write interrupt to start the next write
+ * @param none
+ * @return none
+ */
+void eeprom_write_done(void) {
+	eeprom_start_next();
+}
+
+/**
+ * @fn int8_t eeprom_async_write(const uint8_t ui8_addr,
+ *				 const uint8_t ui8_value)
+ * @brief queue a byte to write in the EEPROM. Only waits if the queue
+ *        is full (about 4 ms per byte beyond EEPROM_QUEUE_SIZE writes).
+ *        Interrupts must be enabled.
+ *
+ * @param [in] ui8_addr		EEPROM address
+ * @param [in] ui8_value	value to write
+ * @return RET_EEPROM_OK
+ */
+int8_t eeprom_async_write(const uint8_t /* in */ ui8_addr,
+			  const uint8_t /* in */ ui8_value) {
+	uint8_t ui8_next = (gui8_eeprom_head + 1) & EEPROM_QUEUE_MASK;
+
+	// wait for a free entry
+	while(ui8_next == gui8_eeprom_tail) {
+	}
+
+	gpui8_eeprom_addr[gui8_eeprom_head] = ui8_addr;
+	gpui8_eeprom_value[gui8_eeprom_head] = ui8_value;
+
+	di();
+	gui8_eeprom_head = ui8_next;
+	if(gb_flag_eeprom_busy == 0) {
+		eeprom_start_next();
+	}
+	/* else the write interrupt will start it */
+	ei();
+
+	return RET_EEPROM_OK;
+}
+
+/**
+ * @fn uint8_t eeprom_find_pending(const uint8_t ui8_addr,
+ *				   uint8_t * const pui8_value)
+ * @brief look for the newest value not yet written at an address.
+ *        Interrupts must be disabled.
+ *
+ * @param [in] ui8_addr		EEPROM address
+ * @param [out] pui8_value	pending value
+ * @return 1 if a value is pending otherwise 0
+ */
+uint8_t eeprom_find_pending(const uint8_t /* in */ ui8_addr,
+			    uint8_t * const /* out */ pui8_value) {
+	uint8_t ui8_idx = gui8_eeprom_head;
+
+	// newest queued value first
+	while(ui8_idx != gui8_eeprom_tail) {
+		ui8_idx = (ui8_idx - 1) & EEPROM_QUEUE_MASK;
+		if(gpui8_eeprom_addr[ui8_idx] == ui8_addr) {
+			*(pui8_value) = gpui8_eeprom_value[ui8_idx];
+			return 1;
+		}
+		/* else nothing to do */
+	}
+
+	if((WR == 1) && (gui8_eeprom_cur_addr == ui8_addr)) {
+		*(pui8_value) = gui8_eeprom_cur_value;
+		return 1;
+	}
+	/* else nothing to do */
+	return 0;
+}
+
+/**
+ * @fn uint8_t eeprom_async_read(const uint8_t ui8_addr)
+ * @brief read a byte from the EEPROM, the pending writes are taken into 
+ *        account. Waits for the end of the current write cycle if the 
+ *        address isn't pending.
+ *
+ * @param [in] ui8_addr		EEPROM address
+ * @return the value of the byte
+ */
+uint8_t eeprom_async_read(const uint8_t /* in */ ui8_addr) {
+	uint8_t ui8_value = 0;
+
+	di();
+	if(eeprom_find_pending(ui8_addr, &ui8_value) == 1) {
+		ei();
+		return ui8_value;
+	}
+	/* else nothing to do */
+	ei();
+
+	// wait for the end of the current write cycle
+	while(1) {
+		while(WR == 1) {
+		}
+		di();
+		if(WR == 0) {
+			break;
+		}
+		/* else a write has been started by the interrupt */
+		ei();
+	}
+
+	if(eeprom_find_pending(ui8_addr, &ui8_value) == 0) {
+		ui8_value = eeprom_read_now(ui8_addr);
+	}
+	/* else nothing to do */
+	ei();
+
+	return ui8_value;
+}
+
+/**
+ * @fn uint8_t eeprom_async_busy(void)
+ * @brief indicate if writes are pending or in progress
+ * @param none
+ * @return 1 if writes are pending otherwise 0
+ */
+uint8_t eeprom_async_busy(void) {
+	if((gui8_eeprom_head != gui8_eeprom_tail) || 
+	   (gb_flag_eeprom_busy == 1)) {
+		return 1;
+	}
+	/* else nothing to do */
+	return 0;
+}
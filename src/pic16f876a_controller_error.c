@@ -0,0 +1,251 @@
+/*************************************************************************
+ * Projet Raspberry pi lcd controller
+ *************************************************************************
+ * File : pic16f876a_controller_error.c
+ *************************************************************************
+ * Date : 19 Octobre 2026
+ * Author : Sinseman44
+ * Organization : Coloc's bar
+ *************************************************************************/
+
+/*
+ * Error log :
+ * -----------
+ * Errors are counted (saturated at 255) and the last ones are kept in a
+ * ring, both read by the master on the I2C bus. Nothing is shown on the
+ * LCD unless the banner is enabled.
+ *
+ *   entry : | Code | Frame Id | Time LSB | Time MSB |   (master time, ms)
+ *
+ * Each counter is only written by one context : the reception errors by
+ * the interrupt (error_isr_log), the decoding errors by the main loop 
+ * (error_log). Both write their entries in the ring at once, stamped when
+ * the error occurs, the main loop with the interrupts disabled.
+ */
+
+/*************************************************************************
+ * Inclusion(s)
+ *************************************************************************/
+
+#include "pic16f876a_controller_error.h"
+#include "pic16f876a_controller_timer.h"
+#include "pic16f876a_controller_schedule.h"
+
+/*************************************************************************
+ * Constante(s)/Macro(s)
+ *************************************************************************/
+
+bank1 uint8_t gpui8_error_count[ERROR_NB_CODES];		/*!< Counters per code */
+bank1 uint8_t gpui8_error_code[ERROR_LOG_SIZE];		/*!< Ring : codes */
+bank1 uint8_t gpui8_error_opcode[ERROR_LOG_SIZE];		/*!< Ring : frame ids */
+uint16_t gpui16_error_time[ERROR_LOG_SIZE];		/*!< Ring : master times */
+volatile uint8_t gui8_error_head = 0;			/*!< Next entry written */
+volatile uint8_t gui8_error_nb_entries = 0;		/*!< Entries in the ring */
+bit gb_flag_error_banner;					/*!< Errors shown on the LCD */
+
+/*************************************************************************
+ * Prototype(s)
+ *************************************************************************/
+
+void error_add_entry(const uint8_t /* in */ ui8_code,
+		     const uint8_t /* in */ ui8_opcode);
+
+/*************************************************************************
+ * Fonction(s)
+ *************************************************************************/
+
+/**
+ * @fn void error_init(void)
+ * @brief empty the log and reset the counters
+ * @param none
+ * @return none
+ */
+void error_init(void) {
+	uint8_t ui8_idx = 0;
+
+	di();
+	for(ui8_idx = 0; ui8_idx < ERROR_NB_CODES; ui8_idx ++) {
+		gpui8_error_count[ui8_idx] = 0;
+	}
+	gui8_error_head = 0;
+	gui8_error_nb_entries = 0;
+	ei();
+}
+
+/**
+ * @fn void error_setup(const uint8_t ui8_flags)
+ * @brief enable the banner and/or clear the log
+ *
+ * @param [in] ui8_flags	ERROR_SETUP_BANNER | ERROR_SETUP_CLEAR
+ * @return none
+ */
+void error_setup(const uint8_t /* in */ ui8_flags) {
+	gb_flag_error_banner = 0;
+	if((ui8_flags & ERROR_SETUP_BANNER) != 0) {
+		gb_flag_error_banner = 1;
+	}
+	/* else nothing to do */
+
+	if((ui8_flags & ERROR_SETUP_CLEAR) != 0) {
+		error_init();
+	}
+	/* else nothing to do */
+}
+
+/**
+ * @fn uint8_t error_is_banner(void)
+ * @brief indicate if the errors are shown on the LCD
+ * @param none
+ * @return 1 if the banner is enabled otherwise 0
+ */
+uint8_t error_is_banner(void) {
+	return gb_flag_error_banner;
+}
+
+/**
+ * @fn void error_add_entry(const uint8_t ui8_code, const uint8_t ui8_opcode)
+ * @brief write an entry in the ring, the oldest one is overwritten
+ *        (main loop, the interrupt writes the ring too)
+ *
+ * @param [in] ui8_code		error code
+ * @param [in] ui8_opcode	frame id
+ * @return none
+ */
+void error_add_entry(const uint8_t /* in */ ui8_code,
+		     const uint8_t /* in */ ui8_opcode) {
+	uint16_t ui16_time = timer_get_tick() + gui16_schedule_offset;
+
+	di();
+	gpui8_error_code[gui8_error_head] = ui8_code;
+	gpui8_error_opcode[gui8_error_head] = ui8_opcode;
+	gpui16_error_time[gui8_error_head] = ui16_time;
+
+	gui8_error_head ++;
+	if(gui8_error_head == ERROR_LOG_SIZE) {
+		gui8_error_head = 0;
+	}
+	/* else nothing to do */
+
+	if(gui8_error_nb_entries < ERROR_LOG_SIZE) {
+		gui8_error_nb_entries ++;
+	}
+	/* else nothing to do */
+	ei();
+}
+
+/**
+ * @fn void error_log(const uint8_t ui8_code, const uint8_t ui8_opcode)
+ * @brief record a decoding error (main loop)
+ *
+ * @param [in] ui8_code		error code
+ * @param [in] ui8_opcode	frame id
+ * @return none
+ */
+void error_log(const uint8_t /* in */ ui8_code,
+	       const uint8_t /* in */ ui8_opcode) {
+	if(gpui8_error_count[ui8_code] != 0xFF) {
+		gpui8_error_count[ui8_code] ++;
+	}
+	/* else nothing to do */
+	error_add_entry(ui8_code, ui8_opcode);
+}
+
+/**
+ * @fn void error_isr_log(const uint8_t ui8_code, const uint8_t ui8_opcode)
+ * @brief record a reception error, every one gets its entry (only called
+ *        from the interrupt, error_add_entry() can't be shared)
+ *
+ * @param [in] ui8_code		error code
+ * @param [in] ui8_opcode	frame id
+ * @return none
+ */
+void error_isr_log(const uint8_t /* in */ ui8_code,
+		   const uint8_t /* in */ ui8_opcode) {
+	if(gpui8_error_count[ui8_code] != 0xFF) {
+		gpui8_error_count[ui8_code] ++;
+	}
+	/* else nothing to do */
+
+	gpui8_error_code[gui8_error_head] = ui8_code;
+	gpui8_error_opcode[gui8_error_head] = ui8_opcode;
+	// the tick can't change meanwhile
+	gpui16_error_time[gui8_error_head] = gui16_timer_tick + gui16_schedule_offset;
+
+	gui8_error_head ++;
+	if(gui8_error_head == ERROR_LOG_SIZE) {
+		gui8_error_head = 0;
+	}
+	/* else nothing to do */
+
+	if(gui8_error_nb_entries < ERROR_LOG_SIZE) {
+		gui8_error_nb_entries ++;
+	}
+	/* else nothing to do */
+}
+
+/**
+ * @fn uint8_t error_read_counters(const uint8_t ui8_idx)
+ * @brief retrieve a byte of the counters page (only called from the
+ *        interrupt)
+ *
+ * | Count code 1 | Count code 2 | ... | Count code 8 |
+ *
+ * @param [in] ui8_idx	index of the byte
+ * @return byte to send
+ */
+uint8_t error_read_counters(const uint8_t /* in */ ui8_idx) {
+	if(ui8_idx < (ERROR_NB_CODES - 1)) {
+		return gpui8_error_count[ui8_idx + 1];
+	}
+	/* else nothing to do */
+
+	return 0;
+}
+
+/**
+ * @fn uint8_t error_read_log(const uint8_t ui8_idx)
+ * @brief retrieve a byte of the log page, newest entry first (only 
+ *        called from the interrupt)
+ *
+ * | Nb entries | Entry 1 (4 bytes) | Entry 2 | ... |
+ *
+ * @param [in] ui8_idx	index of the byte
+ * @return byte to send
+ */
+uint8_t error_read_log(const uint8_t /* in */ ui8_idx) {
+	uint8_t ui8_entry = 0;
+	uint8_t ui8_pos = gui8_error_head;
+
+	if(ui8_idx == 0) {
+		return gui8_error_nb_entries;
+	}
+	/* else nothing to do */
+
+	ui8_entry = (ui8_idx - 1) >> 2;
+	if(ui8_entry >= gui8_error_nb_entries) {
+		return 0;
+	}
+	/* else nothing to do */
+
+	// newest first
+	ui8_entry ++;
+	if(ui8_entry > ui8_pos) {
+		ui8_pos += ERROR_LOG_SIZE;
+	}
+	/* else nothing to do */
+	ui8_pos -= ui8_entry;
+
+	switch((ui8_idx - 1) & 0x03) {
+		case 0:
+			return gpui8_error_code[ui8_pos];
+
+		case 1:
+			return gpui8_error_opcode[ui8_pos];
+
+		case 2:
+			return (uint8_t)gpui16_error_time[ui8_pos];
+
+		default:
+			return (uint8_t)(gpui16_error_time[ui8_pos] >> 8);
+	}
+}
@@ -10,14 +10,27 @@
 
 /*
  *                      -----------
- *  Read Pointer -----> |         |
+ *  Read Index  ------> |         |
  *                      -----------
- *                      |         | <------ Write Pointer
+ *                      |         | <------ Write Index
  *                      -----------
  *                      |         |
  *                      -----------
  *                      |         |
  *                      -----------
+ *
+ * Two lanes : a small one for the control frames and a bigger one for the
+ * text, so a control frame never waits behind a backlog of text.
+ *
+ * The write index is only changed by the interrupt (fifo_put) and the 
+ * read index by the main loop (fifo_get). One byte is kept free to tell
+ * a full lane from an empty one. The high-water mark of a lane is the
+ * most bytes it held since the last fifo_clear_hwm().
+ *
+ * The indexes are used on every byte received : they are kept in bank 0
+ * with the SSP and PORT registers. The buffers go in the upper banks, 
+ * the text lane may use a second segment in bank 3 to be larger than a 
+ * bank allows.
  */
 
 /*************************************************************************
@@ -33,10 +46,33 @@
 #define BUFFER_STAT_EMPTY		0 		/*!< Status buffer empty */
 #define BUFFER_STAT_NOT_EMPTY	1 		/*!< Status buffer not empty */
 #define BUFFER_STAT_FULL		2 		/*!< Status buffer full */
-#define FIFO_MAX_SIZE			64 		/*!< Buffer size max */
+#define FIFO_HIGH_SIZE			8 		/*!< Control lane size */
+#define FIFO_BULK_SIZE			32 		/*!< Text lane size, first segment */
+#define FIFO_BULK_EXT_SIZE		8 		/*!< Text lane size, second segment */
+
+#if FIFO_BULK_EXT_SIZE > 0
+// the cells of the text lane beyond the first segment are in the second
+// one (the control lane is smaller than the first segment)
+#define FIFO_CELL(ui8_lane, ui8_idx)	(*(((ui8_idx) < FIFO_BULK_SIZE) ? \
+	&gppui8_fifo_buffer[ui8_lane][ui8_idx] : &gpui8_fifo_bulk_ext[(ui8_idx) - FIFO_BULK_SIZE]))
+#else
+#define FIFO_CELL(ui8_lane, ui8_idx)	(gppui8_fifo_buffer[ui8_lane][ui8_idx])
+#endif
 
-uint8_t gb_flag_cur_state_buf = 0;		/*!< Flag to indicate buffer status */
-uint8_t gpui8_buffer[FIFO_MAX_SIZE];	/*!< Static buffer */
+bank1 uint8_t gpui8_fifo_high[FIFO_HIGH_SIZE];	/*!< Control lane buffer */
+bank2 uint8_t gpui8_fifo_bulk[FIFO_BULK_SIZE];	/*!< Text lane buffer */
+#if FIFO_BULK_EXT_SIZE > 0
+bank3 uint8_t gpui8_fifo_bulk_ext[FIFO_BULK_EXT_SIZE];	/*!< Text lane buffer, second segment */
+#endif
+uint8_t * const gppui8_fifo_buffer[FIFO_NB_LANES] = {
+	gpui8_fifo_high, gpui8_fifo_bulk
+};
+const uint8_t gpui8_fifo_size[FIFO_NB_LANES] = {
+	FIFO_HIGH_SIZE, FIFO_BULK_SIZE + FIFO_BULK_EXT_SIZE
+};
+bank0 volatile uint8_t gpui8_fifo_wr[FIFO_NB_LANES];	/*!< Write indexes */
+bank0 volatile uint8_t gpui8_fifo_rd[FIFO_NB_LANES];	/*!< Read indexes */
+bank0 uint8_t gpui8_fifo_hwm[FIFO_NB_LANES];			/*!< High-water marks */
 
 /*************************************************************************
  * Prototype(s)
@@ -48,119 +84,179 @@ uint8_t gpui8_buffer[FIFO_MAX_SIZE];	/*!< Static buffer */
 
 /**
  * @fn void fifo_init(void)
- * @brief initialise buffer and the read and write pointers
+ * @brief initialise the read and write indexes of the lanes
  * @param none
  * @return none
  */
 void fifo_init(void) {
-	uint8_t ui8_idx = 0;
-	// initialise buffer
-	for(ui8_idx = 0; ui8_idx < FIFO_MAX_SIZE; ui8_idx ++) {
-		gpui8_buffer[ui8_idx] = 0;
-	}
+	uint8_t ui8_lane = 0;
 
-	// initialise pointers
-	gpui8_read_buf = &gpui8_buffer[0];
-	gpui8_write_buf = &gpui8_buffer[0];
-	gb_flag_cur_state_buf = BUFFER_STAT_EMPTY;
-	
-	//~ uart_printf("START pointer = 0x%x\n\0", gpui8_read_buf);
+	for(ui8_lane = 0; ui8_lane < FIFO_NB_LANES; ui8_lane ++) {
+		gpui8_fifo_wr[ui8_lane] = 0;
+		gpui8_fifo_rd[ui8_lane] = 0;
+		gpui8_fifo_hwm[ui8_lane] = 0;
+	}
 	return;
 }
 
 /**
- * @fn int8_t fifo_put(const uint8_t ui8_value)
- * @brief Save value to the buffer and increment pointer if it's possible
+ * @fn int8_t fifo_put(const uint8_t ui8_lane, const uint8_t ui8_value)
+ * @brief Save value to a lane and increment its index if it's possible
  *
- * @param [in] ui8_value	Value to save to the buffer
- * @return -1 if the buffer is full otherwise 0
+ * @param [in] ui8_lane		FIFO_LANE_HIGH or FIFO_LANE_BULK
+ * @param [in] ui8_value	Value to save to the lane
+ * @return RET_FIFO_NOK if the lane is full otherwise RET_FIFO_OK
  */
-int8_t fifo_put(const uint8_t /* in */ ui8_value) {
-	RB6 = 1;
-	if(gb_flag_cur_state_buf == BUFFER_STAT_FULL) {
+int8_t fifo_put(const uint8_t /* in */ ui8_lane,
+		const uint8_t /* in */ ui8_value) {
+	uint8_t ui8_wr = gpui8_fifo_wr[ui8_lane];
+	uint8_t ui8_next = ui8_wr + 1;
+	uint8_t ui8_rd = gpui8_fifo_rd[ui8_lane];
+	uint8_t ui8_used = 0;
+
+	if(ui8_next == gpui8_fifo_size[ui8_lane]) {
+		// return to the start of the buffer
+		ui8_next = 0;
+	}
+	/* else nothing to do */
+
+	if(ui8_next == ui8_rd) {
 		return RET_FIFO_NOK;
-	} else {
-		*(gpui8_write_buf) = ui8_value;
-		if(gpui8_write_buf == &gpui8_buffer[FIFO_MAX_SIZE - 1]) {
-			// return to the start of the buffer
-			gpui8_write_buf = &gpui8_buffer[0];
-		}
-		else {
-			// increment the pointer
-			gpui8_write_buf ++;
-		}
-
-		if(gpui8_write_buf == gpui8_read_buf) {
-			gb_flag_cur_state_buf = BUFFER_STAT_FULL;
-			return RET_FIFO_NOK;
-		}
-		else {
-			gb_flag_cur_state_buf = BUFFER_STAT_NOT_EMPTY;
-		}
 	}
-	RB6 = 0;
+	/* else nothing to do */
+
+	FIFO_CELL(ui8_lane, ui8_wr) = ui8_value;
+	gpui8_fifo_wr[ui8_lane] = ui8_next;
+
+	ui8_used = ui8_next - ui8_rd;
+	if(ui8_next < ui8_rd) {
+		ui8_used += gpui8_fifo_size[ui8_lane];
+	}
+	/* else nothing to do */
+	if(ui8_used > gpui8_fifo_hwm[ui8_lane]) {
+		gpui8_fifo_hwm[ui8_lane] = ui8_used;
+	}
+	/* else nothing to do */
 	return RET_FIFO_OK;
 }
 
 /**
- * @fn int8_t fifo_get(uint8_t * const pui8_value) 
- * @brief get a byte from the fifo and increment pointer if it's possible
+ * @fn int8_t fifo_get(const uint8_t ui8_lane, uint8_t * const pui8_value) 
+ * @brief get a byte from a lane and increment its index if it's possible
  *
+ * @param [in] ui8_lane		FIFO_LANE_HIGH or FIFO_LANE_BULK
  * @param [out] pui8_value
  * @return RET_FIFO_NOK if an error occurs
- * 		   RET_FIFO_EMPTY if the fifo is empty
+ * 		   RET_FIFO_EMPTY if the lane is empty
  * 		   RET_FIFO_OK otherwise
  */
-int8_t fifo_get(uint8_t * /* out */ const pui8_value) {
+int8_t fifo_get(const uint8_t /* in */ ui8_lane,
+		uint8_t * /* out */ const pui8_value) {
+	uint8_t ui8_rd = 0;
+
 	// test if value address is null
 	if(pui8_value == (uint8_t *)NULL) {
 		return RET_FIFO_NOK;
 	}
 	/* else nothing to do */
 
-	// test if state buffer is previously empty
-	if(gb_flag_cur_state_buf == BUFFER_STAT_EMPTY) {
+	ui8_rd = gpui8_fifo_rd[ui8_lane];
+	if(ui8_rd == gpui8_fifo_wr[ui8_lane]) {
 		return RET_FIFO_EMPTY;
 	}
 	/* else nothing to do */
 
 	// retreive buffered value
-	*(pui8_value) = *(gpui8_read_buf);
-	if(gpui8_read_buf != gpui8_write_buf) {
-		if(gpui8_read_buf == &gpui8_buffer[FIFO_MAX_SIZE - 1]) {
-			// return to the start of the buffer
-			gpui8_read_buf = &gpui8_buffer[0];
-		}
-		else {
-			// increment the pointer
-			gpui8_read_buf ++;
-		}
-
-		// re-test if state changes
-		if(gpui8_read_buf == gpui8_write_buf) {
-			gb_flag_cur_state_buf = BUFFER_STAT_EMPTY;
-			__delay_us(50);
-			return RET_FIFO_OK;
-		}
-		/* else nothing to do */
-	} else {
-		gb_flag_cur_state_buf = BUFFER_STAT_EMPTY;
-		__delay_us(50);
-		return RET_FIFO_OK;
+	*(pui8_value) = FIFO_CELL(ui8_lane, ui8_rd);
+	ui8_rd ++;
+	if(ui8_rd == gpui8_fifo_size[ui8_lane]) {
+		// return to the start of the buffer
+		ui8_rd = 0;
 	}
+	/* else nothing to do */
+	gpui8_fifo_rd[ui8_lane] = ui8_rd;
 
-
-	__delay_us(50);
 	return RET_FIFO_OK;
 }
 
 /**
- * @fn uint8_t fifo_state(void) 
- * @brief retrieve current state of the buffer
+ * @fn uint8_t fifo_state(const uint8_t ui8_lane) 
+ * @brief retrieve current state of a lane
  *
+ * @param [in] ui8_lane		FIFO_LANE_HIGH or FIFO_LANE_BULK
+ * @return the current state of the lane
+ */
+uint8_t fifo_state(const uint8_t /* in */ ui8_lane) {
+	uint8_t ui8_wr = gpui8_fifo_wr[ui8_lane];
+	uint8_t ui8_next = ui8_wr + 1;
+
+	if(ui8_wr == gpui8_fifo_rd[ui8_lane]) {
+		return BUFFER_STAT_EMPTY;
+	}
+	/* else nothing to do */
+
+	if(ui8_next == gpui8_fifo_size[ui8_lane]) {
+		ui8_next = 0;
+	}
+	/* else nothing to do */
+
+	if(ui8_next == gpui8_fifo_rd[ui8_lane]) {
+		return BUFFER_STAT_FULL;
+	}
+	/* else nothing to do */
+
+	return BUFFER_STAT_NOT_EMPTY;
+}
+
+/**
+ * @fn uint8_t fifo_mark(const uint8_t ui8_lane) 
+ * @brief retrieve the write index of a lane (only called from the 
+ *        interrupt)
+ *
+ * @param [in] ui8_lane		FIFO_LANE_HIGH or FIFO_LANE_BULK
+ * @return the write index
+ */
+uint8_t fifo_mark(const uint8_t /* in */ ui8_lane) {
+	return gpui8_fifo_wr[ui8_lane];
+}
+
+/**
+ * @fn void fifo_rollback(const uint8_t ui8_lane, const uint8_t ui8_mark) 
+ * @brief remove the bytes written in a lane since a mark (only called 
+ *        from the interrupt)
+ *
+ * @param [in] ui8_lane		FIFO_LANE_HIGH or FIFO_LANE_BULK
+ * @param [in] ui8_mark		write index returned by fifo_mark()
+ * @return none
+ */
+void fifo_rollback(const uint8_t /* in */ ui8_lane,
+		   const uint8_t /* in */ ui8_mark) {
+	gpui8_fifo_wr[ui8_lane] = ui8_mark;
+}
+
+/**
+ * @fn uint8_t fifo_read_hwm(const uint8_t ui8_lane) 
+ * @brief retrieve the high-water mark of a lane (only called from the 
+ *        interrupt)
+ *
+ * @param [in] ui8_lane		FIFO_LANE_HIGH or FIFO_LANE_BULK
+ * @return the most bytes held by the lane
+ */
+uint8_t fifo_read_hwm(const uint8_t /* in */ ui8_lane) {
+	return gpui8_fifo_hwm[ui8_lane];
+}
+
+/**
+ * @fn void fifo_clear_hwm(void) 
+ * @brief reset the high-water marks of the lanes (interrupts disabled
+ *        by the caller)
  * @param none
- * @return the current state of the buffer
+ * @return none
  */
-uint8_t fifo_state(void) {
-	return gb_flag_cur_state_buf;
+void fifo_clear_hwm(void) {
+	uint8_t ui8_lane = 0;
+
+	for(ui8_lane = 0; ui8_lane < FIFO_NB_LANES; ui8_lane ++) {
+		gpui8_fifo_hwm[ui8_lane] = 0;
+	}
 }
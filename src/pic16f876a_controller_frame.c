@@ -25,6 +25,90 @@
  * 0x04 : Put character
  * 0x05 : Put string
  * 0x06 : Control Display
+ * 0x07 : Begin record
+ * 0x08 : End record
+ * 0x09 : Run macro
+ * 0x0A : Save screen
+ * 0x0B : Begin update
+ * 0x0C : Commit
+ * 0x0D : Scroll
+ * 0x0E : Marquee
+ * 0x0F : Define char
+ * 0x10 : Animate
+ * 0x11 : Schedule
+ * 0x12 : Set tick
+ * 0x13 : Coalesce
+ * 0x14 : Read select
+ * 0x15 : Error setup
+ * 0x16 : Perf reset
+ * 0x17 : Set address
+ *
+ * Integrity :
+ * -----------
+ * Bit 7 of the frame id adds a CRC-8 (see pic16f876a_controller_crc.c) of
+ * the id, size and data bytes at the end of the frame, the size includes
+ * it. The CRC is checked while the frame is received, a bad frame is 
+ * dropped and counted without any display. 
+ *
+ * ------------------------------------------------//-----------
+ * | 0x80 + Frame Id | Frame Size + 1 | Frame datas | CRC-8 |
+ * ------------------------------------------------//-----------
+ *
+ * Display :
+ * ---------
+ * Bits 5 and 6 of the frame id select the display (0 : first LCD, 1 :
+ * second LCD of a firmware built with LCD2=1, 2 and 3 : PCF8574 backpacks
+ * of a firmware built with BACKPACK=1 or 2). Only clear display, return
+ * home, set cursor, put character, put string, control display and define
+ * char (not on a backpack) frames are sent to the other displays, the
+ * other frames always drive the first one and are ignored with another
+ * display. The frames of a display which isn't fitted are ignored. The
+ * second LCD is written while the first one executes an instruction.
+ *
+ * ----------------------------------------------------------
+ * | CRC flag | Display (2 bits) | Frame Id (5 bits) | ...
+ * ----------------------------------------------------------
+ *
+ * Sync byte 0x00 may be sent between frames. An unknown id or a bad size
+ * drops the bytes until the next sync byte or the next transfer, after a 
+ * bad CRC the next frame starts right after the CRC byte.
+ *
+ * Lanes :
+ * -------
+ * Clear display and control display frames are received in the control
+ * lane, the others in the text lane. The control lane is always decoded
+ * first. Text frames (set cursor, put character, put string) received 
+ * before a clear of the control lane are dropped since the clear would 
+ * erase them. While the text lane holds another frame (define char, run
+ * macro, schedule...), between a begin record and an end record, or a 
+ * begin update and a commit, every frame goes in the text lane to keep 
+ * the order. A frame which doesn't fit in its lane is dropped as a whole :
+ * a lane keeps a byte free, a frame has 39 bytes at most (ids and sizes
+ * included) in the text lane and 7 in the control lane. A put string of
+ * a whole screen (32 characters) fits, with its CRC.
+ * A control frame only waits for the end of the frame being decoded.
+ * Host emulator (make emu, I2C 400 kHz, modelled not measured on the 
+ * board), from the end of the transfer to the instruction of the LCD :
+ *  - control display, idle : 0.6 ms,
+ *  - behind put strings of 8 characters (4 sent back to back) : 2.6 ms
+ *    at worst for a control display, 2.1 ms for a clear, while a put
+ *    string sent at the same time waits 7.3 ms,
+ *  - behind a put string of 32 characters : 8.4 ms at worst.
+ *
+ * Options :
+ * ---------
+ * Marquee and animate frames are decoded by the default firmware, one
+ * built with MARQUEE=0 or ANIMATE=0 ignores them. With PERF=0 the
+ * performance counters read 0. The second LCD needs LCD2=1, its state
+ * takes 10 bytes of the bank 3 and the schedule queue is 22 bytes by
+ * default then. One or two backpacks need BACKPACK=1 or 2, they take the
+ * RAM of the animation and of the counters (ANIMATE=0 and PERF=0), the
+ * second one takes 32 bytes of the bank 3 and the marquee text and the
+ * schedule queue are 16 bytes each by default then. The marquee text and
+ * the schedule queue have their own buffers, sized when building : 32
+ * bytes each by default, MARQUEE_SIZE + SCHEDULE_SIZE can't exceed 64, 10
+ * less with LCD2=1 and 32 less with BACKPACK=2 (for instance make
+ * MARQUEE_SIZE=56 SCHEDULE_SIZE=8 for a longer text).
  *
  * Frame =>  Clear Display :
  * -------------------------
@@ -71,6 +155,214 @@
  * ------------------------------------------
  * | 0x06 | 0x05 | Display | Cursor | Blink |
  * ------------------------------------------
+ *
+ * Frame => Begin record :
+ * -----------------------
+ * Macro Id => 1 to 3
+ * The following frames are saved in the macro (not executed) until the
+ * end record frame. The macro takes the largest free space left by the
+ * other ones, 215 bytes of frames (ids and sizes included) when it is
+ * alone : a longer record is dropped at the end record frame, the macro
+ * stays empty and the error is logged (Macro). A record without frames
+ * frees the macro. Each recorded byte waits for an EEPROM write cycle 
+ * (about 4 ms) : the master has to pause between the recorded frames
+ * (60 ms after a frame of 18 bytes) or the frames are dropped.
+ *
+ * --------------------------
+ * | 0x07 | 0x03 | MACRO_ID |
+ * --------------------------
+ *
+ * Frame => End record :
+ * ---------------------
+ *
+ * ---------------
+ * | 0x08 | 0x02 |
+ * ---------------
+ *
+ * Frame => Run macro :
+ * --------------------
+ * Macro Id => 1 to 3
+ * Recorded frames are decoded as if they were received from the bus.
+ *
+ * --------------------------
+ * | 0x09 | 0x03 | MACRO_ID |
+ * --------------------------
+ *
+ * Frame => Save screen :
+ * ----------------------
+ * The current screen is saved in the EEPROM and restored after a
+ * warm reset (brown-out, watchdog, MCLR).
+ *
+ * ---------------
+ * | 0x0A | 0x02 |
+ * ---------------
+ *
+ * Frame => Begin update :
+ * -----------------------
+ * Clear display, return home, set cursor, put character and put string
+ * frames are done in an off-screen page until the commit frame.
+ *
+ * ---------------
+ * | 0x0B | 0x02 |
+ * ---------------
+ *
+ * Frame => Commit :
+ * -----------------
+ * Only the cells of the off-screen page which differ from the screen
+ * are written. Sent to the general call address (I2C), every panel shows
+ * its staged page at once.
+ *
+ * ---------------
+ * | 0x0C | 0x02 |
+ * ---------------
+ *
+ * Frame => Scroll :
+ * -----------------
+ * Direction : left (0) / right (1)
+ * Count : number of steps (0 : endless with a period)
+ * Period : time between steps in 10 ms unit (0 : all steps at once)
+ * Both lines are shifted with the display shift instruction, each line
+ * is 40 columns long (Set Cursor accepts columns 1 to 40).
+ *
+ * --------------------------------------------
+ * | 0x0D | 0x05 | Direction | Count | Period |
+ * --------------------------------------------
+ *
+ * Frame => Marquee :
+ * ------------------
+ * Row => 1 to 2
+ * Period : time between steps in 10 ms unit (0 : stopped)
+ * Offset : index of the first character of the frame in the text
+ * The text (up to 32 characters, see Options) is scrolled across the 
+ * row without any other frame. A long text is sent in several frames, 
+ * the size of the text is the offset plus the number of characters of
+ * the last one.
+ *
+ * -----------------------------------------------------------------
+ * | 0x0E | 0x05 + STRING SIZE | Row | Period | Offset | STRING BYTES |
+ * -----------------------------------------------------------------
+ *
+ * Frame => Define char :
+ * ----------------------
+ * Glyph => CGRAM character code (0 to 7)
+ * Bitmap : 8 rows, 5 lower bits per row
+ * Every cell showing the glyph is updated at once.
+ *
+ * -----------------------------------------
+ * | 0x0F | 0x0B | Glyph | 8 BITMAP BYTES |
+ * -----------------------------------------
+ *
+ * Frame => Animate :
+ * ------------------
+ * Row => 1 to 2, Column => 1 to 16
+ * Period : time between glyphs in 10 ms unit (0 : stopped)
+ * The cell cycles through the glyphs (1 to 8 characters, ROM or CGRAM)
+ * without any other frame, 2 cells can be animated at the same time.
+ *
+ * ------------------------------------------------------------------
+ * | 0x10 | 0x05 + GLYPHS SIZE | Row | Column | Period | GLYPHS BYTES |
+ * ------------------------------------------------------------------
+ *
+ * Frame => Schedule :
+ * -------------------
+ * Deadline : master time (ms) of the execution of the frame
+ * The frame is kept in a queue (32 bytes, see Options) until the 
+ * deadline, it is executed at once if the deadline is passed and dropped
+ * if the queue is full. A schedule frame run by a scheduled frame (a 
+ * macro included) is logged as a value error and ignored.
+ *
+ * ---------------------------------------------------------------
+ * | 0x11 | 0x04 + FRAME SIZE | Deadline LSB | Deadline MSB | FRAME |
+ * ---------------------------------------------------------------
+ *
+ * Frame => Set tick :
+ * -------------------
+ * Set the master time (ms), it wraps after 65.5 s.
+ *
+ * ----------------------------------------
+ * | 0x12 | 0x04 | Time LSB | Time MSB |
+ * ----------------------------------------
+ *
+ * Frame => Coalesce :
+ * -------------------
+ * On => 1 : the writes are done in RAM and the cells which changed are 
+ *           copied to the screen in the background, a cell written again
+ *           before being copied only shows its last value. The frames 
+ *           are decoded faster than the LCD writes them and the screen 
+ *           converges to the last state sent.
+ *       0 : the writes are done at once (default)
+ *
+ * ----------------------
+ * | 0x13 | 0x03 | On |
+ * ----------------------
+ *
+ * Frame => Read select :
+ * ----------------------
+ * Page => 0 : master time (default)
+ *         1 : error counters
+ *         2 : error log
+ *         3 : performance counters
+ *
+ * ------------------------
+ * | 0x14 | 0x03 | Page |
+ * ------------------------
+ *
+ * Frame => Error setup :
+ * ----------------------
+ * Flags => bit 0 : show the decoding errors on the LCD (off by default)
+ *          bit 1 : clear the error log and the counters
+ *
+ * -------------------------
+ * | 0x15 | 0x03 | Flags |
+ * -------------------------
+ *
+ * Frame => Perf reset :
+ * ---------------------
+ * Reset the performance counters and the high-water marks.
+ *
+ * ---------------
+ * | 0x16 | 0x02 |
+ * ---------------
+ *
+ * Frame => Set address :
+ * ----------------------
+ * Address => I2C slave address 0x08 to 0x77 saved in the EEPROM and used
+ *            at once, 0xFF : address of the straps RB4/RB5 (default)
+ * Only sent to the own address of a controller : sent to the general call,
+ * or run by a macro or a schedule frame sent to it, the frame is logged as
+ * a value error and ignored.
+ *
+ * --------------------------
+ * | 0x17 | 0x03 | Address |
+ * --------------------------
+ *
+ * Read :
+ * ------
+ * A read on the I2C bus returns the page selected, the page is latched
+ * when the address is received.
+ *
+ * Master time :
+ * ------------------------
+ * | Time LSB | Time MSB |
+ * ------------------------
+ *
+ * Error counters (saturated at 255), one byte per error code :
+ * -------------------------------------------------------------------
+ * | Value | Empty | CRC | Sync | Overflow | Partial | Full | Macro |
+ * -------------------------------------------------------------------
+ *
+ * Error log, newest entry first :
+ * ------------------------------------------------------------------------
+ * | Nb entries | Code | Frame Id | Time LSB | Time MSB | Code | ... (x4) |
+ * ------------------------------------------------------------------------
+ *
+ * Performance counters (16 bits little endian, times in us, the counters
+ * of frames received per id wrap at 256) :
+ * ---------------------------------------------------------------------
+ * | Bytes dropped | SSPOV | Hwm control lane | Hwm text lane |
+ * | Longest decoding | Its frame Id | Longest interrupt | Frames decoded |
+ * | Frames received id 0x01 | ... | Frames received id 0x17 |
+ * ---------------------------------------------------------------------
  */
 
 /*************************************************************************
@@ -79,6 +371,21 @@
 
 #include "pic16f876a_controller_frame.h"
 #include "pic16f876a_controller_lcd.h"
+#include "pic16f876a_controller_macro.h"
+#include "pic16f876a_controller_marquee.h"
+#include "pic16f876a_controller_animate.h"
+#include "pic16f876a_controller_schedule.h"
+#include "pic16f876a_controller_timer.h"
+#include "pic16f876a_controller_crc.h"
+#include "pic16f876a_controller_error.h"
+#include "pic16f876a_controller_perf.h"
+#include "pic16f876a_controller_trace.h"
+#include "pic16f876a_controller_transport.h"
+#include "pic16f876a_controller_backpack.h"
+
+#if defined(MARQUEE_ENABLE) && ((MARQUEE_MAX_SIZE + SCHEDULE_BUFFER_SIZE + LCD_BANK3_SIZE + BACKPACK_BANK3_SIZE) > 64)
+#error "MARQUEE_SIZE + SCHEDULE_SIZE don't fit in the bank 3 (64 bytes, 10 less with LCD2=1, 32 less with BACKPACK=2)"
+#endif
 
 /*************************************************************************
  * Constante(s)/Macro(s)
@@ -88,123 +395,844 @@
 #define HOME_FRAME_SIZE		2
 #define CURSOR_FRAME_SIZE	4
 #define CONTROL_FRAME_SIZE	5
+#define MACRO_FRAME_SIZE	3
+#define END_RECORD_FRAME_SIZE	2
+#define SAVE_FRAME_SIZE		2
+#define UPDATE_FRAME_SIZE	2
+#define SCROLL_FRAME_SIZE	5
+#define MARQUEE_FRAME_SIZE	5
+#define DEFINE_CHAR_FRAME_SIZE	11
+#define ANIMATE_FRAME_SIZE	5
+#define SCHEDULE_FRAME_SIZE	4
+#define SET_TICK_FRAME_SIZE	4
+#define COALESCE_FRAME_SIZE	3
+#define READ_SELECT_FRAME_SIZE	3
+#define ERROR_SETUP_FRAME_SIZE	3
+#define PERF_RESET_FRAME_SIZE	2
+#define SET_ADDRESS_FRAME_SIZE	3
+#define MIN_FRAME_SIZE		2
+
+#define FRAME_GENERAL_CALL	0x80	/*!< Id bit of a frame stored from the general call */
+#define FRAME_IS_TEXT(id)	(((id) == SET_CURSOR) || ((id) == PUT_CHAR) || \
+				 ((id) == PUT_STRING))	/*!< Frames erased by a clear */
+
+#define FRAME_SRC_FIFO		0	/*!< Frames are read from the reception fifo */
+#define FRAME_SRC_MACRO		1	/*!< Frames are read from a macro slot */
+#define FRAME_SRC_SCHEDULE	2	/*!< Frames are read from the schedule queue */
+
+#define FRAME_READ_TIME		0	/*!< Read page : master time */
+#define FRAME_READ_ERRORS	1	/*!< Read page : error counters */
+#define FRAME_READ_LOG		2	/*!< Read page : error log */
+#define FRAME_READ_PERF		3	/*!< Read page : performance counters */
+
+uint8_t gui8_frame_source = FRAME_SRC_FIFO;	/*!< Source of the decoded frames */
+uint8_t gui8_frame_origin = FRAME_SRC_FIFO;	/*!< Source of the frame starting a macro */
+uint8_t gui8_frame_lane = FIFO_LANE_BULK;		/*!< Lane of the decoded frame */
+bank0 uint8_t gui8_frame_recv_idx = 0;				/*!< Index of the byte received */
+bank0 uint8_t gui8_frame_recv_size = 0;				/*!< Index of the last byte */
+bank0 uint8_t gui8_frame_recv_id = 0;					/*!< Id of the frame received */
+bank0 uint8_t gui8_frame_recv_lane = FIFO_LANE_BULK;	/*!< Lane of the frame received */
+bank0 uint8_t gui8_frame_recv_mark = 0;				/*!< Lane index of the frame received */
+bit gb_flag_frame_recv_drop;				/*!< Frame received dropped */
+bit gb_flag_frame_recv_crc;					/*!< Frame received with a CRC */
+bit gb_flag_frame_recv_hunt;				/*!< Waiting for a sync byte */
+bit gb_flag_frame_recv_general;				/*!< Transfer to the general call */
+bank0 uint8_t gui8_frame_recv_crc = 0;				/*!< CRC of the bytes received */
+bit gb_flag_frame_recv_record;				/*!< Record received */
+bit gb_flag_frame_recv_update;				/*!< Update received */
+bank0 volatile uint8_t gpui8_frame_token[FIFO_NB_LANES];	/*!< Frames received per lane */
+bank0 volatile uint8_t gui8_frame_stale = 0;			/*!< Text frames erased by a clear */
+bank0 volatile uint8_t gui8_frame_ordered = 0;		/*!< Other frames in the text lane */
+uint16_t gui16_frame_read_time = 0;			/*!< Master time sent on the I2C bus */
+uint8_t gui8_frame_read_page = FRAME_READ_TIME;	/*!< Page selected for the reads */
+uint8_t gui8_frame_read_latch = FRAME_READ_TIME;	/*!< Page of the read in progress */
+uint8_t gui8_frame_cur_id = 0;					/*!< Id of the frame decoded */
+uint8_t gui8_frame_left = 0;					/*!< Bytes left in the frame decoded */
+bit gb_flag_frame_general;					/*!< Frame decoded from the general call */
+
+/*************************************************************************
+ * Prototype(s)
+ *************************************************************************/
+
+void frame_set_error(const int8_t /* in */ i8_error); 
+
+int8_t frame_get(uint8_t * /* out */ const pui8_value);
+
+int8_t frame_decode(void);
+
+int8_t frame_run(const uint8_t /* in */ ui8_source);
+
+void frame_flush(void);
+
+uint8_t frame_lane(const uint8_t /* in */ ui8_frame_id);
+
+void frame_receive_drop(void);
+
+int8_t frame_record(const uint8_t /* in */ ui8_frame_id,
+		    const uint8_t /* in */ ui8_frame_size);
+
+int8_t frame_decode_backpack(const uint8_t /* in */ ui8_backpack,
+			     const uint8_t /* in */ ui8_frame_id,
+			     const uint8_t /* in */ ui8_frame_size);
+
+/*************************************************************************
+ * Fonction(s)
+ *************************************************************************/
+
+/**
+ * @fn void frame_init(const uint8_t ui8_warm_boot)
+ * @brief
+ * @param [in] ui8_warm_boot	1 if the reset isn't a power-on reset
+ * @return
+ */
+void frame_init(const uint8_t /* in */ ui8_warm_boot) {
+	macro_init();
+#ifdef MARQUEE_ENABLE
+	marquee_init();
+#endif
+#ifdef ANIMATE_ENABLE
+	animate_init();
+#endif
+	schedule_init();
+	error_init();
+#ifdef BACKPACK_ENABLE
+	backpack_init();
+#endif
+	lcd_init(ui8_warm_boot);
+}
+
+/**
+ * @fn void frame_task(void)
+ * @brief run the timed tasks (LCD initialisation, scroll, marquee, 
+ *        animation, scheduled frames, coalesced writes, backpacks)
+ * @param none
+ * @return none
+ */
+void frame_task(void) {
+#ifdef BACKPACK_ENABLE
+	backpack_task();
+#endif
+	if(lcd_is_ready() == 0) {
+		lcd_init_task();
+	}
+	else {
+		lcd_busy_task();
+		lcd_scroll_task();
+		lcd_flush_task();
+#ifdef MARQUEE_ENABLE
+		marquee_task();
+#endif
+#ifdef ANIMATE_ENABLE
+		animate_task();
+#endif
+		if(schedule_is_due() == 1) {
+			frame_run(FRAME_SRC_SCHEDULE);
+			schedule_pop();
+		}
+		/* else nothing to do */
+	}
+}
+
+/**
+ * @fn uint8_t frame_is_ready(void)
+ * @brief frames are kept in the fifo until the end of the LCD 
+ *        initialisation
+ * @param none
+ * @return 1 if frames can be decoded otherwise 0
+ */
+uint8_t frame_is_ready(void) {
+	return lcd_is_ready();
+}
+
+/**
+ * @fn uint8_t frame_lane(const uint8_t ui8_frame_id)
+ * @brief select the lane of a frame received (only called from the 
+ *        interrupt)
+ *
+ * @param [in] ui8_frame_id	frame identifier
+ * @return FIFO_LANE_HIGH or FIFO_LANE_BULK
+ */
+uint8_t frame_lane(const uint8_t /* in */ ui8_frame_id) {
+	// a clear can't overtake a frame it doesn't erase
+	if((gb_flag_frame_recv_record == 0) &&
+	   (gb_flag_frame_recv_update == 0) &&
+	   (gui8_frame_ordered == 0) &&
+	   ((ui8_frame_id == CLEAR_DISPLAY) || (ui8_frame_id == CONTROL_DISPLAY))) {
+		return FIFO_LANE_HIGH;
+	}
+	/* else nothing to do */
+
+	return FIFO_LANE_BULK;
+}
+
+/**
+ * @fn void frame_receive_start(void)
+ * @brief a new transfer starts on the bus (only called from the 
+ *        interrupt)
+ * @param none
+ * @return none
+ */
+void frame_receive_start(void) {
+	if(gui8_frame_recv_idx != 0) {
+		// the previous transfer stopped inside a frame
+		fifo_rollback(gui8_frame_recv_lane, gui8_frame_recv_mark);
+		if(gb_flag_frame_recv_drop == 0) {
+			error_isr_log(ERROR_PARTIAL, gui8_frame_recv_id);
+			perf_isr_drop(gui8_frame_recv_idx);
+		}
+		/* else already counted */
+	}
+	/* else nothing to do */
+	gui8_frame_recv_idx = 0;
+	gui8_frame_recv_size = 0;
+	gb_flag_frame_recv_hunt = 0;
+	gb_flag_frame_recv_general = 0;
+}
+
+/**
+ * @fn void frame_receive_general_call(void)
+ * @brief the transfer started by frame_receive_start() is written to the
+ *        general call address (only called from the interrupt)
+ * @param none
+ * @return none
+ */
+void frame_receive_general_call(void) {
+	gb_flag_frame_recv_general = 1;
+}
+
+/**
+ * @fn void frame_receive_resync(void)
+ * @brief bytes have been lost by the transport : drop the frame being 
+ *        received and wait for a sync byte (only called from the 
+ *        interrupt)
+ * @param none
+ * @return none
+ */
+void frame_receive_resync(void) {
+	frame_receive_start();
+	gb_flag_frame_recv_hunt = 1;
+}
+
+/**
+ * @fn void frame_receive_drop(void)
+ * @brief drop the frame being received, the current byte included (only
+ *        called from the interrupt)
+ * @param none
+ * @return none
+ */
+void frame_receive_drop(void) {
+	if(gui8_frame_recv_idx != 0) {
+		fifo_rollback(gui8_frame_recv_lane, gui8_frame_recv_mark);
+	}
+	/* else nothing to do */
+	perf_isr_drop(gui8_frame_recv_idx + 1);
+	gui8_frame_recv_idx = 0;
+}
+
+/**
+ * @fn void frame_receive(const uint8_t ui8_value)
+ * @brief save a byte received in the lane of its frame (only called from
+ *        the interrupt)
+ *
+ * @param [in] ui8_value	byte received
+ * @return none
+ */
+void frame_receive(const uint8_t /* in */ ui8_value) {
+	uint8_t ui8_stored = ui8_value;
+	uint8_t ui8_trailer = 0;
+
+	if(gb_flag_frame_recv_hunt == 1) {
+		if(ui8_value == FRAME_SYNC) {
+			gb_flag_frame_recv_hunt = 0;
+		}
+		else {
+			perf_isr_drop(1);
+		}
+		return;
+	}
+	/* else nothing to do */
+
+	if(gui8_frame_recv_idx == 0) {
+		if(ui8_value == FRAME_SYNC) {
+			return;
+		}
+		/* else nothing to do */
+
+		// the display bits are kept with the id
+		ui8_stored = ui8_value & (~FRAME_CRC_FLAG);
+		if(((ui8_stored & FRAME_ID_MASK) == 0) ||
+		   ((ui8_stored & FRAME_ID_MASK) > FRAME_ID_LAST)) {
+			error_isr_log(ERROR_SYNC, ui8_value);
+			perf_isr_drop(1);
+			gb_flag_frame_recv_hunt = 1;
+			return;
+		}
+		/* else nothing to do */
+
+		gui8_frame_recv_id = ui8_stored;
+		gb_flag_frame_recv_crc = 0;
+		if((ui8_value & FRAME_CRC_FLAG) != 0) {
+			gb_flag_frame_recv_crc = 1;
+		}
+		/* else nothing to do */
+		gui8_frame_recv_crc = CRC8_INIT;
+		gui8_frame_recv_lane = frame_lane(ui8_stored);
+		gui8_frame_recv_mark = fifo_mark(gui8_frame_recv_lane);
+		gb_flag_frame_recv_drop = 0;
+		if(gb_flag_frame_recv_general == 1) {
+			ui8_stored |= FRAME_GENERAL_CALL;
+		}
+		/* else nothing to do */
+	}
+	else if(gui8_frame_recv_idx == 1) {
+		if(ui8_value < (MIN_FRAME_SIZE + gb_flag_frame_recv_crc)) {
+			error_isr_log(ERROR_SYNC, gui8_frame_recv_id);
+			frame_receive_drop();
+			gb_flag_frame_recv_hunt = 1;
+			return;
+		}
+		/* else nothing to do */
+		// the CRC byte isn't stored
+		ui8_stored = ui8_value - gb_flag_frame_recv_crc;
+	}
+	/* else nothing to do */
+
+	// the CRC of a frame already dropped isn't checked
+	if((gb_flag_frame_recv_crc == 1) && (gb_flag_frame_recv_drop == 0)) {
+		if((gui8_frame_recv_idx == gui8_frame_recv_size) && 
+		   (gui8_frame_recv_idx > 1)) {
+			// last byte : CRC of the frame
+			if(ui8_value != gui8_frame_recv_crc) {
+				error_isr_log(ERROR_CRC, gui8_frame_recv_id);
+				frame_receive_drop();
+				return;
+			}
+			/* else nothing to do */
+			ui8_trailer = 1;
+		}
+		else {
+			gui8_frame_recv_crc = crc8_update(gui8_frame_recv_crc, ui8_value);
+		}
+	}
+	/* else nothing to do */
+
+	if(gb_flag_frame_recv_drop == 1) {
+		perf_isr_drop(1);
+	}
+	else if(ui8_trailer == 0) {
+		if(fifo_put(gui8_frame_recv_lane, ui8_stored) != RET_FIFO_OK) {
+			// lane full : the whole frame is dropped, never a part of it
+			fifo_rollback(gui8_frame_recv_lane, gui8_frame_recv_mark);
+			gb_flag_frame_recv_drop = 1;
+			error_isr_log(ERROR_OVERFLOW, gui8_frame_recv_id);
+			perf_isr_drop(gui8_frame_recv_idx + 1);
+		}
+		/* else nothing to do */
+	}
+	/* else nothing to do */
+
+	// copy frame size byte
+	if(gui8_frame_recv_idx == 1) {
+		gui8_frame_recv_size = ui8_value - 1;
+	}
+	/* else nothing to do */
+
+	// indicate that is the last byte received
+	if((gui8_frame_recv_size == gui8_frame_recv_idx) && 
+	   (gui8_frame_recv_idx != 0)) {
+		if(gb_flag_frame_recv_drop == 0) {
+			gpui8_frame_token[gui8_frame_recv_lane] ++; // increase the number of frames received
+			perf_isr_frame(gui8_frame_recv_id);
+			// a record or an update is open once its frame is committed
+			if(gui8_frame_recv_id == BEGIN_RECORD) {
+				gb_flag_frame_recv_record = 1;
+			}
+			else if(gui8_frame_recv_id == END_RECORD) {
+				gb_flag_frame_recv_record = 0;
+			}
+			else if(gui8_frame_recv_id == BEGIN_UPDATE) {
+				gb_flag_frame_recv_update = 1;
+			}
+			else if(gui8_frame_recv_id == COMMIT) {
+				gb_flag_frame_recv_update = 0;
+			}
+			/* else nothing to do */
+			if((gui8_frame_recv_lane == FIFO_LANE_BULK) &&
+			   !FRAME_IS_TEXT(gui8_frame_recv_id)) {
+				gui8_frame_ordered ++;
+			}
+			/* else nothing to do */
+		}
+		/* else nothing to do */
+		if((gb_flag_frame_recv_drop == 0) &&
+		   (gui8_frame_recv_lane == FIFO_LANE_HIGH) &&
+		   (gui8_frame_recv_id == CLEAR_DISPLAY)) {
+			// the text waiting in the other lane will be erased
+			gui8_frame_stale = gpui8_frame_token[FIFO_LANE_BULK];
+		}
+		/* else nothing to do */
+		// next frame of the transfer
+		gui8_frame_recv_idx = 0;
+	}
+	else {
+		gui8_frame_recv_idx ++;
+	}
+}
+
+/**
+ * @fn uint8_t frame_is_pending(void)
+ * @brief indicate if a frame has been received
+ * @param none
+ * @return 1 if a frame is waiting in a lane otherwise 0
+ */
+uint8_t frame_is_pending(void) {
+	if((gpui8_frame_token[FIFO_LANE_HIGH] != 0) ||
+	   (gpui8_frame_token[FIFO_LANE_BULK] != 0)) {
+		return 1;
+	}
+	/* else nothing to do */
+
+	return 0;
+}
+
+/**
+ * @fn uint8_t frame_read_byte(const uint8_t ui8_idx)
+ * @brief retrieve a byte sent to the master on a read (only called
+ *        from the interrupt)
+ *
+ * @param [in] ui8_idx	index of the byte in the read
+ * @return byte to send
+ */
+uint8_t frame_read_byte(const uint8_t /* in */ ui8_idx) {
+	if(ui8_idx == 0) {
+		gui8_frame_read_latch = gui8_frame_read_page;
+	}
+	/* else nothing to do */
+
+	if(gui8_frame_read_latch == FRAME_READ_ERRORS) {
+		return error_read_counters(ui8_idx);
+	}
+	else if(gui8_frame_read_latch == FRAME_READ_LOG) {
+		return error_read_log(ui8_idx);
+	}
+	else if(gui8_frame_read_latch == FRAME_READ_PERF) {
+		return perf_read_byte(ui8_idx);
+	}
+	/* else master time */
+
+	if(ui8_idx == 0) {
+		// the time is frozen for the whole read
+		gui16_frame_read_time = gui16_timer_tick + gui16_schedule_offset;
+		return (uint8_t)gui16_frame_read_time;
+	}
+	else if(ui8_idx == 1) {
+		return (uint8_t)(gui16_frame_read_time >> 8);
+	}
+	/* else nothing to do */
+
+	return 0;
+}
+
+/**
+ * @fn int8_t frame_get(uint8_t * const pui8_value)
+ * @brief get the next frame byte from the current source
+ *        (reception fifo, macro being replayed or scheduled frame)
+ *
+ * @param [out] pui8_value
+ * @return RET_FIFO_NOK if an error occurs
+ * 		   RET_FIFO_EMPTY if the source or the frame is empty
+ * 		   RET_FIFO_OK otherwise
+ */
+int8_t frame_get(uint8_t * /* out */ const pui8_value) {
+	// never read beyond the frame decoded
+	if(gui8_frame_left == 0) {
+		return RET_FIFO_EMPTY;
+	}
+	/* else nothing to do */
+	gui8_frame_left --;
+
+	if(gui8_frame_source == FRAME_SRC_MACRO) {
+		return macro_get(pui8_value);
+	}
+	/* else nothing to do */
+	if(gui8_frame_source == FRAME_SRC_SCHEDULE) {
+		return schedule_get(pui8_value);
+	}
+	/* else nothing to do */
+	return fifo_get(gui8_frame_lane, pui8_value);
+}
+
+/**
+ * @fn int8_t frame_decode_fifo(void)
+ * @brief decode a frame from the fifo (control lane first) then replay 
+ *        the macro it may have started
+ * @param none
+ * @return RET_NOK if an error occurs otherwise RET_OK
+ */
+int8_t frame_decode_fifo(void) {
+	int8_t i8_ret = RET_OK;
+
+	if(gpui8_frame_token[FIFO_LANE_HIGH] != 0) {
+		gui8_frame_lane = FIFO_LANE_HIGH;
+	}
+	else if(gpui8_frame_token[FIFO_LANE_BULK] != 0) {
+		gui8_frame_lane = FIFO_LANE_BULK;
+	}
+	else {
+		return RET_OK;
+	}
+
+	i8_ret = frame_run(FRAME_SRC_FIFO);
+
+	di();
+	gpui8_frame_token[gui8_frame_lane] --; // decrease number of frames in the lane
+	if((gui8_frame_lane == FIFO_LANE_BULK) && (gui8_frame_stale != 0)) {
+		gui8_frame_stale --;
+	}
+	/* else nothing to do */
+	ei();
+
+	return i8_ret;
+}
+
+/**
+ * @fn int8_t frame_run(const uint8_t ui8_source)
+ * @brief decode a frame from a source then replay the macro it may
+ *        have started
+ *
+ * @param [in] ui8_source	FRAME_SRC_FIFO or FRAME_SRC_SCHEDULE
+ * @return RET_NOK if an error occurs otherwise RET_OK
+ */
+int8_t frame_run(const uint8_t /* in */ ui8_source) {
+	int8_t i8_ret = -1;
+
+	gui8_frame_source = ui8_source;
+	gui8_frame_origin = ui8_source;
+	gb_flag_frame_general = 0;
+	TRACE_BEGIN(TRACE_DECODE);
+	perf_decode_begin();
+	i8_ret = frame_decode();
+	frame_flush();
+	perf_decode_end(gui8_frame_cur_id);
+	TRACE_END(TRACE_DECODE);
+
+	// frames of a macro are decoded one after the other 
+	// (no recursion on the compiled stack)
+	gui8_frame_source = FRAME_SRC_MACRO;
+	while((i8_ret == RET_OK) && (macro_is_playing() == 1)) {
+		TRACE_BEGIN(TRACE_DECODE);
+		perf_decode_begin();
+		i8_ret = frame_decode();
+		frame_flush();
+		perf_decode_end(gui8_frame_cur_id);
+		TRACE_END(TRACE_DECODE);
+	}
+	macro_stop();
+	gui8_frame_source = FRAME_SRC_FIFO;
+	gb_flag_frame_general = 0;
+
+	return i8_ret;
+}
+
+/**
+ * @fn void frame_flush(void)
+ * @brief drop the bytes of the frame decoded which haven't been read, 
+ *        the next frame always starts on its id
+ * @param none
+ * @return none
+ */
+void frame_flush(void) {
+	uint8_t ui8_value = 0;
+
+	while(gui8_frame_left != 0) {
+		if(frame_get(&ui8_value) != RET_FIFO_OK) {
+			gui8_frame_left = 0;
+		}
+		/* else nothing to do */
+	}
+}
+
+/**
+ * @fn int8_t frame_record(const uint8_t ui8_frame_id,
+ *			  const uint8_t ui8_frame_size)
+ * @brief copy a frame in the macro being recorded instead of executing it
+ *
+ * @param [in] ui8_frame_id	frame identifier
+ * @param [in] ui8_frame_size	frame size
+ * @return RET_NOK if an error occurs otherwise RET_OK
+ */
+int8_t frame_record(const uint8_t /* in */ ui8_frame_id,
+		    const uint8_t /* in */ ui8_frame_size) {
+	int8_t i8_ret = -1;
+	uint8_t ui8_idx = 0;
+	uint8_t ui8_value = 0;
+
+	macro_record_byte(ui8_frame_id);
+	macro_record_byte(ui8_frame_size);
+	for(ui8_idx = 2; ui8_idx < ui8_frame_size; ui8_idx ++) {
+		i8_ret = frame_get(&ui8_value);
+		if(i8_ret != RET_FIFO_OK) {
+			frame_set_error(i8_ret);
+			return i8_ret;
+		}
+		/* else nothing to do */
+		// an overflowed record keeps consuming the frame
+		macro_record_byte(ui8_value);
+	}
+	return RET_OK;
+}
+
+#ifdef BACKPACK_ENABLE
+/**
+ * @fn int8_t frame_decode_backpack(const uint8_t ui8_backpack,
+ *				    const uint8_t ui8_frame_id,
+ *				    const uint8_t ui8_frame_size)
+ * @brief decode a frame of a PCF8574 backpack, only its shadow is
+ *        written (the LCD is written by backpack_task())
+ *
+ * @param [in] ui8_backpack	index of the backpack
+ * @param [in] ui8_frame_id	frame identifier (display bits removed)
+ * @param [in] ui8_frame_size	frame size
+ * @return RET_NOK if an error occurs otherwise RET_OK
+ */
+int8_t frame_decode_backpack(const uint8_t /* in */ ui8_backpack,
+			     const uint8_t /* in */ ui8_frame_id,
+			     const uint8_t /* in */ ui8_frame_size) {
+	int8_t i8_ret = RET_OK;
+	uint8_t ui8_idx = 0;
+	uint8_t pui8_value[3] = {0, 0, 0};
+
+	if(ui8_backpack >= BACKPACK_NB) {
+		// not fitted, dropped by frame_flush()
+		return RET_OK;
+	}
+	/* else nothing to do */
+
+	switch(ui8_frame_id) {
+		case CLEAR_DISPLAY:
+			if(ui8_frame_size == CLEAR_FRAME_SIZE) {
+				backpack_clear(ui8_backpack);
+			}
+			/* else nothing to do */
+			break;
+
+		case RETURN_HOME:
+			if(ui8_frame_size == HOME_FRAME_SIZE) {
+				backpack_return_home(ui8_backpack);
+			}
+			/* else nothing to do */
+			break;
 
-/*************************************************************************
- * Prototype(s)
- *************************************************************************/
+		case SET_CURSOR:
+			if(ui8_frame_size == CURSOR_FRAME_SIZE) {
+				for(ui8_idx = 0; ui8_idx < 2; ui8_idx ++) {
+					i8_ret = frame_get(&pui8_value[ui8_idx]);
+					if(i8_ret != RET_FIFO_OK) {
+						frame_set_error(i8_ret);
+						return i8_ret;
+					}
+					/* else nothing to do */
+				}
+				backpack_set_cursor(ui8_backpack, pui8_value[0], pui8_value[1]);
+			}
+			/* else nothing to do */
+			break;
 
-void frame_set_error(const int8_t /* in */ i8_error); 
+		case CONTROL_DISPLAY:
+			if(ui8_frame_size == CONTROL_FRAME_SIZE) {
+				for(ui8_idx = 0; ui8_idx < 3; ui8_idx ++) {
+					i8_ret = frame_get(&pui8_value[ui8_idx]);
+					if(i8_ret != RET_FIFO_OK) {
+						frame_set_error(i8_ret);
+						return i8_ret;
+					}
+					/* else nothing to do */
+				}
+				backpack_set_control(ui8_backpack, pui8_value[0], pui8_value[1], pui8_value[2]);
+			}
+			/* else nothing to do */
+			break;
 
-/*************************************************************************
- * Fonction(s)
- *************************************************************************/
+		case PUT_CHAR:
+		case PUT_STRING:
+			for(ui8_idx = 0; ui8_idx < (ui8_frame_size - 2); ui8_idx ++) {
+				i8_ret = frame_get(&pui8_value[0]);
+				if(i8_ret != RET_FIFO_OK) {
+					frame_set_error(i8_ret);
+					return i8_ret;
+				}
+				/* else nothing to do */
+				backpack_put_char(ui8_backpack, pui8_value[0]);
+			}
+			break;
 
-/**
- * @fn void frame_init(void)
- * @brief
- * @param
- * @return
- */
-void frame_init(void) {
-	lcd_init();
+		default:
+			// only the first display, dropped by frame_flush()
+			break;
+	}
+	return RET_OK;
 }
+#endif
 
 /**
- * @fn int8_t frame_decode(uint8_t * const pui8_frame)
- * @brief
+ * @fn int8_t frame_decode(void)
+ * @brief decode a frame from the current source and execute actions
  * @param none
  * @return RET_NOK if an error occurs otherwise RET_OK
  */
-int8_t frame_decode_fifo(void) {
+int8_t frame_decode(void) {
 	int8_t i8_ret = -1;
 	uint8_t ui8_frame_id = 0;
 	uint8_t ui8_frame_size = 0;
+	uint8_t ui8_display = 0;
 	uint8_t ui8_idx = 0;
+	uint8_t ui8_value = 0;
 	uint8_t pui8_value[3] = {0, 0, 0};
+	uint8_t pui8_data[LCD_GLYPH_SIZE];
 	
-	i8_ret = fifo_get(&ui8_frame_id);
+	gui8_frame_cur_id = 0;
+	gui8_frame_left = 2;
+	i8_ret = frame_get(&ui8_frame_id);
 	if(i8_ret != RET_FIFO_OK) {
 		frame_set_error(i8_ret);
 		return i8_ret;
 	}
 	/* else nothing to do */
+	// a macro run or a frame scheduled from the general call keeps the flag
+	if((ui8_frame_id & FRAME_GENERAL_CALL) != 0) {
+		gb_flag_frame_general = 1;
+		ui8_frame_id &= (~FRAME_GENERAL_CALL);
+	}
+	/* else nothing to do */
+	gui8_frame_cur_id = ui8_frame_id;
+
+	if((gui8_frame_source == FRAME_SRC_FIFO) &&
+	   (gui8_frame_lane == FIFO_LANE_BULK) &&
+	   !FRAME_IS_TEXT(ui8_frame_id)) {
+		// the control lane is used again once the lane holds only text
+		di();
+		gui8_frame_ordered --;
+		ei();
+	}
+	/* else nothing to do */
 
-	i8_ret = fifo_get(&ui8_frame_size);
+	i8_ret = frame_get(&ui8_frame_size);
 	if(i8_ret != RET_FIFO_OK) {
 		frame_set_error(i8_ret);
 		return i8_ret;
 	}
 	/* else nothing to do */
 
+	if(ui8_frame_size > MIN_FRAME_SIZE) {
+		gui8_frame_left = ui8_frame_size - MIN_FRAME_SIZE;
+	}
+	/* else nothing to do */
+
+	// text erased by a clear received after it (the text of the other
+	// displays has display bits in its id and is never erased)
+	if((gui8_frame_source == FRAME_SRC_FIFO) &&
+	   (gui8_frame_lane == FIFO_LANE_BULK) &&
+	   (gui8_frame_stale != 0) &&
+	   FRAME_IS_TEXT(ui8_frame_id)) {
+		// dropped by frame_flush()
+		return RET_OK;
+	}
+	/* else nothing to do */
+
+	// frames are saved in the EEPROM until the end of the record
+	if((macro_is_recording() == 1) && 
+	   (ui8_frame_id != END_RECORD) &&
+	   (gui8_frame_source == FRAME_SRC_FIFO)) {
+		if(gb_flag_frame_general == 1) {
+			ui8_frame_id |= FRAME_GENERAL_CALL;
+		}
+		/* else nothing to do */
+		return frame_record(ui8_frame_id, ui8_frame_size);
+	}
+	/* else nothing to do */
+
+	ui8_display = (ui8_frame_id & FRAME_DISPLAY_MASK) >> FRAME_DISPLAY_SHIFT;
+	ui8_frame_id &= FRAME_ID_MASK;
+	if((ui8_display != LCD_DISPLAY_1) &&
+	   (ui8_frame_id > CONTROL_DISPLAY) &&
+	   (ui8_frame_id != DEFINE_CHAR)) {
+		// only the first display, dropped by frame_flush()
+		return RET_OK;
+	}
+	/* else nothing to do */
+
+#ifdef BACKPACK_ENABLE
+	if(ui8_display >= BACKPACK_DISPLAY) {
+		return frame_decode_backpack(ui8_display - BACKPACK_DISPLAY, ui8_frame_id, ui8_frame_size);
+	}
+	/* else nothing to do */
+#endif
+
+	if(lcd_select(ui8_display) != RET_OK) {
+		// display not fitted, dropped by frame_flush()
+		return RET_OK;
+	}
+	/* else nothing to do */
+
 	switch(ui8_frame_id) {
 		case CLEAR_DISPLAY:
 			// test frame size 
 			if(ui8_frame_size == CLEAR_FRAME_SIZE) {
-				di();
 				lcd_clear_display();
-				ei();
 			}
 			/* else nothing to do */
 			break;
 
 		case RETURN_HOME:
 			if(ui8_frame_size == HOME_FRAME_SIZE) {
-				di();
 				lcd_return_home();
-				ei();
 			}
 			/* else nothing to do */
 			break;
 
 		case SET_CURSOR:
 			if(ui8_frame_size == CURSOR_FRAME_SIZE) {
-				i8_ret = fifo_get(&pui8_value[0]);
+				i8_ret = frame_get(&pui8_value[0]);
 				if(i8_ret != RET_FIFO_OK) {
 					frame_set_error(i8_ret);	
 					return i8_ret;
 				}
 				/* else nothing to do */
 
-				i8_ret = fifo_get(&pui8_value[1]);
+				i8_ret = frame_get(&pui8_value[1]);
 				if(i8_ret != RET_FIFO_OK) {
 					frame_set_error(i8_ret);
 					return i8_ret;
 				}
 				/* else nothing to do */
 
-				di();
 				lcd_set_cursor(pui8_value[0], pui8_value[1]);
-				ei();
 			}
 			/* else nothing to do */			
 			break;
 
 		case PUT_CHAR:
 			if(ui8_frame_size == 3) {
-				i8_ret = fifo_get(&pui8_value[0]);
+				i8_ret = frame_get(&pui8_value[0]);
 				if(i8_ret != RET_OK) {
 					frame_set_error(i8_ret);
 					return i8_ret;
 				}
 				/* else nothing to do */
-				di();
 				lcd_put_char((char_t)pui8_value[0]);
-				ei();
 			}
 			/* else nothing to do */
 			break;
 
 		case PUT_STRING:
 			for(ui8_idx = 0; ui8_idx < (ui8_frame_size - 2); ui8_idx ++) {
-				i8_ret = fifo_get(&pui8_value[0]);
+				i8_ret = frame_get(&pui8_value[0]);
 				if(i8_ret != RET_OK) {
 					frame_set_error(i8_ret);
 					return i8_ret;
 				}
 				/* else nothing to do */
-				di();
 				lcd_put_char((char_t)pui8_value[0]);
-				ei();
 			}
 			
 			break;
@@ -212,7 +1240,7 @@ int8_t frame_decode_fifo(void) {
 		case CONTROL_DISPLAY:
 			if(ui8_frame_size == CONTROL_FRAME_SIZE) {
 				for(ui8_idx = 0; ui8_idx < (ui8_frame_size - 2); ui8_idx ++) {
-					i8_ret = fifo_get(&pui8_value[ui8_idx]);
+					i8_ret = frame_get(&pui8_value[ui8_idx]);
 					if(i8_ret != RET_FIFO_OK) {
 						frame_set_error(i8_ret);	
 						return i8_ret;
@@ -220,13 +1248,297 @@ int8_t frame_decode_fifo(void) {
 					/* else nothing to do */
 				}
 				
-				di();
 				lcd_set_control(pui8_value[0], pui8_value[1], pui8_value[2]);
-				ei();
 			}
 			/* else nothing to do */	
 			break;
 
+		case BEGIN_RECORD:
+			if(ui8_frame_size == MACRO_FRAME_SIZE) {
+				i8_ret = frame_get(&pui8_value[0]);
+				if(i8_ret != RET_FIFO_OK) {
+					frame_set_error(i8_ret);
+					return i8_ret;
+				}
+				/* else nothing to do */
+
+				// a macro can't record another one
+				if(gui8_frame_source == FRAME_SRC_FIFO) {
+					macro_begin_record(pui8_value[0]);
+				}
+				/* else nothing to do */
+			}
+			/* else nothing to do */
+			break;
+
+		case END_RECORD:
+			if((ui8_frame_size == END_RECORD_FRAME_SIZE) &&
+			   (gui8_frame_source == FRAME_SRC_FIFO)) {
+				if(macro_end_record() == RET_MACRO_FULL) {
+					error_log(ERROR_MACRO, ui8_frame_id);
+				}
+				/* else nothing to do */
+			}
+			/* else nothing to do */
+			break;
+
+		case RUN_MACRO:
+			if(ui8_frame_size == MACRO_FRAME_SIZE) {
+				i8_ret = frame_get(&pui8_value[0]);
+				if(i8_ret != RET_FIFO_OK) {
+					frame_set_error(i8_ret);
+					return i8_ret;
+				}
+				/* else nothing to do */
+
+				// a macro can't run another one
+				if(gui8_frame_source != FRAME_SRC_MACRO) {
+					macro_play(pui8_value[0]);
+				}
+				/* else nothing to do */
+			}
+			/* else nothing to do */
+			break;
+
+		case SAVE_SCREEN:
+			if(ui8_frame_size == SAVE_FRAME_SIZE) {
+				lcd_save_screen();
+			}
+			/* else nothing to do */
+			break;
+
+		case BEGIN_UPDATE:
+			if(ui8_frame_size == UPDATE_FRAME_SIZE) {
+				lcd_begin_update();
+			}
+			/* else nothing to do */
+			break;
+
+		case SCROLL:
+			if(ui8_frame_size == SCROLL_FRAME_SIZE) {
+				for(ui8_idx = 0; ui8_idx < (ui8_frame_size - 2); ui8_idx ++) {
+					i8_ret = frame_get(&pui8_value[ui8_idx]);
+					if(i8_ret != RET_FIFO_OK) {
+						frame_set_error(i8_ret);	
+						return i8_ret;
+					}
+					/* else nothing to do */
+				}
+
+				lcd_scroll(pui8_value[0], pui8_value[1], pui8_value[2]);
+			}
+			/* else nothing to do */
+			break;
+
+#ifdef MARQUEE_ENABLE
+		case MARQUEE:
+			if(ui8_frame_size >= MARQUEE_FRAME_SIZE) {
+				for(ui8_idx = 0; ui8_idx < 3; ui8_idx ++) {
+					i8_ret = frame_get(&pui8_value[ui8_idx]);
+					if(i8_ret != RET_FIFO_OK) {
+						frame_set_error(i8_ret);	
+						return i8_ret;
+					}
+					/* else nothing to do */
+				}
+
+				// pui8_value[2] : offset of the next character
+				for(ui8_idx = MARQUEE_FRAME_SIZE; ui8_idx < ui8_frame_size; ui8_idx ++) {
+					i8_ret = frame_get(&ui8_value);
+					if(i8_ret != RET_FIFO_OK) {
+						frame_set_error(i8_ret);	
+						return i8_ret;
+					}
+					/* else nothing to do */
+					marquee_put(pui8_value[2], ui8_value);
+					pui8_value[2] ++;
+				}
+
+				marquee_start(pui8_value[0], pui8_value[1], pui8_value[2]);
+			}
+			/* else nothing to do */
+			break;
+#endif /* MARQUEE_ENABLE */
+
+		case DEFINE_CHAR:
+			if(ui8_frame_size == DEFINE_CHAR_FRAME_SIZE) {
+				i8_ret = frame_get(&ui8_value);
+				for(ui8_idx = 0; (ui8_idx < LCD_GLYPH_SIZE) && (i8_ret == RET_FIFO_OK); ui8_idx ++) {
+					i8_ret = frame_get(&pui8_data[ui8_idx]);
+				}
+				if(i8_ret != RET_FIFO_OK) {
+					frame_set_error(i8_ret);	
+					return i8_ret;
+				}
+				/* else nothing to do */
+
+				lcd_define_custom_char(LCD_GLYPH_SIZE, (const char_t *)pui8_data, ui8_value);
+			}
+			/* else nothing to do */
+			break;
+
+#ifdef ANIMATE_ENABLE
+		case ANIMATE:
+			if((ui8_frame_size >= ANIMATE_FRAME_SIZE) && 
+			   (ui8_frame_size <= (ANIMATE_FRAME_SIZE + ANIMATE_MAX_GLYPHS))) {
+				for(ui8_idx = 0; ui8_idx < (ui8_frame_size - 2); ui8_idx ++) {
+					if(ui8_idx < 3) {
+						i8_ret = frame_get(&pui8_value[ui8_idx]);
+					}
+					else {
+						i8_ret = frame_get(&pui8_data[ui8_idx - 3]);
+					}
+					if(i8_ret != RET_FIFO_OK) {
+						frame_set_error(i8_ret);	
+						return i8_ret;
+					}
+					/* else nothing to do */
+				}
+
+				animate_start(pui8_value[0], pui8_value[1], pui8_value[2], 
+					      pui8_data, ui8_frame_size - ANIMATE_FRAME_SIZE);
+			}
+			/* else nothing to do */
+			break;
+#endif /* ANIMATE_ENABLE */
+
+		case SCHEDULE:
+			if(ui8_frame_size > SCHEDULE_FRAME_SIZE) {
+				for(ui8_idx = 0; ui8_idx < 2; ui8_idx ++) {
+					i8_ret = frame_get(&pui8_value[ui8_idx]);
+					if(i8_ret != RET_FIFO_OK) {
+						frame_set_error(i8_ret);	
+						return i8_ret;
+					}
+					/* else nothing to do */
+				}
+
+				// a scheduled frame, or a macro it runs, can't schedule 
+				// another one : the frame due is read from the head of 
+				// the queue until schedule_pop()
+				if(gui8_frame_origin == FRAME_SRC_SCHEDULE) {
+					error_log(ERROR_VALUE, ui8_frame_id);
+				}
+				else {
+					i8_ret = schedule_open(((uint16_t)pui8_value[1] << 8) | pui8_value[0],
+							       ui8_frame_size - SCHEDULE_FRAME_SIZE);
+					if(i8_ret != RET_SCHEDULE_OK) {
+						error_log(ERROR_FULL, ui8_frame_id);
+					}
+					/* else nothing to do */
+				}
+
+				for(ui8_idx = SCHEDULE_FRAME_SIZE; ui8_idx < ui8_frame_size; ui8_idx ++) {
+					i8_ret = frame_get(&ui8_value);
+					if(i8_ret != RET_FIFO_OK) {
+						frame_set_error(i8_ret);	
+						return i8_ret;
+					}
+					/* else nothing to do */
+					if((ui8_idx == SCHEDULE_FRAME_SIZE) && (gb_flag_frame_general == 1)) {
+						ui8_value |= FRAME_GENERAL_CALL;
+					}
+					/* else nothing to do */
+					// dropped if the queue is full
+					schedule_put(ui8_value);
+				}
+			}
+			/* else nothing to do */
+			break;
+
+		case SET_TICK:
+			if(ui8_frame_size == SET_TICK_FRAME_SIZE) {
+				for(ui8_idx = 0; ui8_idx < 2; ui8_idx ++) {
+					i8_ret = frame_get(&pui8_value[ui8_idx]);
+					if(i8_ret != RET_FIFO_OK) {
+						frame_set_error(i8_ret);	
+						return i8_ret;
+					}
+					/* else nothing to do */
+				}
+
+				schedule_set_time(((uint16_t)pui8_value[1] << 8) | pui8_value[0]);
+			}
+			/* else nothing to do */
+			break;
+
+		case COALESCE:
+			if(ui8_frame_size == COALESCE_FRAME_SIZE) {
+				i8_ret = frame_get(&pui8_value[0]);
+				if(i8_ret != RET_FIFO_OK) {
+					frame_set_error(i8_ret);
+					return i8_ret;
+				}
+				/* else nothing to do */
+
+				lcd_set_coalesce(pui8_value[0]);
+			}
+			/* else nothing to do */
+			break;
+
+		case READ_SELECT:
+			if(ui8_frame_size == READ_SELECT_FRAME_SIZE) {
+				i8_ret = frame_get(&pui8_value[0]);
+				if(i8_ret != RET_FIFO_OK) {
+					frame_set_error(i8_ret);
+					return i8_ret;
+				}
+				/* else nothing to do */
+
+				gui8_frame_read_page = pui8_value[0];
+			}
+			/* else nothing to do */
+			break;
+
+		case ERROR_SETUP:
+			if(ui8_frame_size == ERROR_SETUP_FRAME_SIZE) {
+				i8_ret = frame_get(&pui8_value[0]);
+				if(i8_ret != RET_FIFO_OK) {
+					frame_set_error(i8_ret);
+					return i8_ret;
+				}
+				/* else nothing to do */
+
+				error_setup(pui8_value[0]);
+			}
+			/* else nothing to do */
+			break;
+
+		case PERF_RESET:
+			if(ui8_frame_size == PERF_RESET_FRAME_SIZE) {
+				perf_reset();
+			}
+			/* else nothing to do */
+			break;
+
+		case SET_ADDRESS:
+			if(ui8_frame_size == SET_ADDRESS_FRAME_SIZE) {
+				i8_ret = frame_get(&pui8_value[0]);
+				if(i8_ret != RET_FIFO_OK) {
+					frame_set_error(i8_ret);
+					return i8_ret;
+				}
+				/* else nothing to do */
+
+				// the general call would give the same address to 
+				// every controller of the bus
+				if(gb_flag_frame_general == 1) {
+					error_log(ERROR_VALUE, ui8_frame_id);
+				}
+				else {
+					TRANSPORT_SET_ADDR(pui8_value[0]);
+				}
+			}
+			/* else nothing to do */
+			break;
+
+		case COMMIT:
+			if(ui8_frame_size == UPDATE_FRAME_SIZE) {
+				lcd_commit();
+			}
+			/* else nothing to do */
+			break;
+
 		default:
 			break;
 	}
@@ -236,11 +1548,24 @@ int8_t frame_decode_fifo(void) {
 
 /**
  * @fn void frame_set_error(const int8_t i8_error) 
- * @brief
- * @param
+ * @brief record a decoding error in the log, it is only shown on the 
+ *        LCD if the banner is enabled
+ * @param [in] i8_error		value returned by frame_get()
  * @return none
  */
 void frame_set_error(const int8_t /* in */ i8_error) {
+	if(i8_error == RET_FIFO_EMPTY) {
+		error_log(ERROR_EMPTY, gui8_frame_cur_id);
+	}
+	else {
+		error_log(ERROR_VALUE, gui8_frame_cur_id);
+	}
+
+	if(error_is_banner() == 0) {
+		return;
+	}
+	/* else nothing to do */
+
 	lcd_clear_display();
 	switch(i8_error) {
 		case RET_FIFO_NOK:
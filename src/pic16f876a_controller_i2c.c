@@ -16,7 +16,16 @@
  * 
  * Address:
  * --------
- * Slave address (7 bits) : 0x06 => 0 0 0 0 1 1 0 R/W
+ * Slave address (7 bits) read at the start :
+ *  - the byte saved in the EEPROM (0xFF) by the set address frame if it is
+ *    a valid address (0x08 to 0x77),
+ *  - otherwise 0x76 with the bits 0 and 1 inverted by the straps RB4 and
+ *    RB5 tied to 0 V (weak pull-ups) : 0x74 to 0x77.
+ * The general call address (0x00) is also acknowledged (GCEN) : a frame
+ * written to it is received by every controller of the bus, a commit
+ * shows the staged screens of all the panels at once, a banner is written
+ * to all the panels with the same frames. The reads use the own address,
+ * a set address frame is only accepted from the own address.
  *
  * Process:
  * -------- 
@@ -53,6 +62,19 @@
  *
  * 
  * After writing data to SSPBUF, the user should check the WCOL bit to ensure that a write collision did not occur.
+ *
+ * Fast mode (make I2C_SPEED=400) : a byte lasts 22.5 us (45 cycles). The clock is released as soon as SSPBUF is
+ * read, the byte is saved while the next one is received and the clock is held (SEN) until the interrupt has read
+ * the next one. Only the read operations release the clock at the end of the interrupt : a byte received meanwhile
+ * would be overwritten, or lost after the stop condition.
+ *
+ * With the host emulator (make emu, 6 cycles per basic block, modelled and not measured on the board), 100 transfers
+ * of 18 bytes sent back to back :
+ *  - 100 kHz : 0 SSPOV, the clock is held 62 ms in all, the last transfer ends after 167 ms,
+ *  - 400 kHz : 0 SSPOV, the clock is held 120 ms in all, the last transfer ends after 146 ms,
+ *  - without the clock held (-n) : an SSPOV on every transfer at 400 kHz, down to 2 cycles per block, and at 100 kHz
+ *    from 4 cycles per block : the interrupt of a byte lasts longer than the byte.
+ * The interrupt and not the clock sets the rate, 100 kHz stays the default.
  */
 
 /*************************************************************************
@@ -60,6 +82,9 @@
  *************************************************************************/
 
 #include "pic16f876a_controller_i2c.h"
+#include "pic16f876a_controller_perf.h"
+#include "pic16f876a_controller_frame.h"
+#include "pic16f876a_controller_eeprom.h"
 
 /*************************************************************************
  * Constante(s)
@@ -68,7 +93,12 @@
 #define SCL				RC3
 #define SDA				RC4
 
-#define PIC16F876A_I2C_SLAVE_ADDR	0x76
+#define PIC16F876A_I2C_SLAVE_ADDR	0x76	/*!< Address with no strap */
+#define I2C_ADDR_EEPROM			0xFF	/*!< EEPROM address of the saved address */
+#define I2C_ADDR_MIN			0x08	/*!< First address not reserved */
+#define I2C_ADDR_MAX			0x77	/*!< Last address not reserved */
+#define I2C_ADDR_STRAP_1		RB4	/*!< Inverts the bit 0 when tied to 0 V */
+#define I2C_ADDR_STRAP_2		RB5	/*!< Inverts the bit 1 when tied to 0 V */
 
 #define I2C_STAT_MASK			0x2D
 #define STATE_1				0x09
@@ -76,16 +106,60 @@
 #define STATE_3				0x0C
 #define STATE_4				0x2C
 
-uint8_t gui8_slave_token = 0;
+bank0 uint8_t gui8_slave_token = 0;
+bank0 uint8_t gui8_i2c_send_idx = 0;	/*!< Index of the byte sent on a read */
 
 /*************************************************************************
  * Prototype(s)
  *************************************************************************/
 
+uint8_t i2c_own_addr(void);
+
 /*************************************************************************
  * Fonction(s)
  *************************************************************************/
 
+/**
+ * @fn uint8_t i2c_own_addr(void)
+ * @brief select the slave address : the one saved in the EEPROM if it is
+ *        valid otherwise the one of the straps
+ * @param none
+ * @return the slave address (7 bits)
+ */
+uint8_t i2c_own_addr(void) {
+	uint8_t ui8_addr = eeprom_async_read(I2C_ADDR_EEPROM);
+
+	if((ui8_addr >= I2C_ADDR_MIN) && (ui8_addr <= I2C_ADDR_MAX)) {
+		return ui8_addr;
+	}
+	/* else nothing to do */
+
+	ui8_addr = PIC16F876A_I2C_SLAVE_ADDR;
+	if(I2C_ADDR_STRAP_1 == 0) {
+		ui8_addr ^= 0x01;
+	}
+	/* else nothing to do */
+	if(I2C_ADDR_STRAP_2 == 0) {
+		ui8_addr ^= 0x02;
+	}
+	/* else nothing to do */
+	return ui8_addr;
+}
+
+/**
+ * @fn void i2c_set_own_addr(const uint8_t ui8_addr)
+ * @brief save the slave address in the EEPROM and use it at once,
+ *        an invalid address (0xFF) gives the straps back
+ * @param [in] ui8_addr	slave address (7 bits)
+ * @return nothing
+ */
+void i2c_set_own_addr(const uint8_t /* in */ ui8_addr) {
+	eeprom_async_write(I2C_ADDR_EEPROM, ui8_addr);
+
+	// the address is compared from the next start condition
+	SSPADD = i2c_own_addr() << 1;
+}
+
 /**
  * @fn void i2c_wait_for_idle(void)
  * @brief Wait for i2c bus is in IDLE state
@@ -121,6 +195,19 @@ uint8_t i2c_slave_read(void) {
 	return (SSPBUF);
 }
 
+/**
+ * @fn void i2c_slave_write(const uint8_t ui8_value)
+ * @brief load a byte to send to the master (read operation)
+ * @param [in] ui8_value
+ * @return nothing
+ */
+void i2c_slave_write(const uint8_t /* in */ ui8_value) {
+	do {
+		WCOL = 0;
+		SSPBUF = ui8_value;
+	} while(WCOL == 1);
+}
+
 /**
  * @fn int8_t i2c_slave_scan(void)
  * @brief poll on i2c bus to retrieve data(s) or send data(s) from/to raspberry pi
@@ -129,33 +216,34 @@ uint8_t i2c_slave_read(void) {
  *         RET_OK
  */
 int8_t i2c_slave_state(uint8_t * pui8_state) {
-	// State 1: I2C master write operation (slave read), last byte was an address byte
-	if((SSPSTAT & I2C_STAT_MASK) == STATE_1) {
-		if(SSPOV == 1) { // clear SSPOV bit
-			SSPOV = 0;
-		}
-		/* else nothing to do */
+	// SSPSTAT is read once
+	uint8_t ui8_stat = SSPSTAT & I2C_STAT_MASK;
+
+	// the byte received while BF was set is lost and not acknowledged,
+	// BF may be clear already : SSPOV is cleared in every state, the MSSP
+	// acknowledges no other byte until then
+	if(SSPOV == 1) {
+		SSPOV = 0;
+		perf_isr_overflow();
+	}
+	/* else nothing to do */
 
+	// State 1: I2C master write operation (slave read), last byte was an address byte
+	if(ui8_stat == STATE_1) {
 		*pui8_state = 1;
 		gui8_slave_token = 1;
 	}
 	// State 2: I2C master write operation (slave read), last byte was a data byte.
-	else if(((SSPSTAT & I2C_STAT_MASK) == STATE_2) && 
+	else if((ui8_stat == STATE_2) && 
 		(gui8_slave_token == 1)) {
-		if(SSPOV == 1) {
-			// clear SSPOV bit
-			SSPOV = 0;
-		}
-		/* else nothing to do */
-		
 		*pui8_state = 2;
 	}
 	//State 3: I2C master read operation (slave write), last byte was an address byte
-	else if((SSPSTAT & I2C_STAT_MASK) == STATE_3) {
+	else if(ui8_stat == STATE_3) {
 		*pui8_state = 3;
 	}
 	// State 4: I2C master read operation (slave write), last byte was a data byte.
-	else if((SSPSTAT & I2C_STAT_MASK) == STATE_4) {
+	else if(ui8_stat == STATE_4) {
 		*pui8_state = 4;
 		// clear WCOL bit
 		WCOL = 0;
@@ -168,6 +256,48 @@ int8_t i2c_slave_state(uint8_t * pui8_state) {
 	return RET_OK;
 }
 
+/**
+ * @fn void i2c_isr(void)
+ * @brief give the bytes written by the master to the frame layer and
+ *        send the page selected on a read (SSP interrupt)
+ * @param none
+ * @return nothing
+ */
+void i2c_isr(void) {
+	uint8_t ui8_slave_state = 0;
+	uint8_t ui8_i2c_value = 0;
+
+	SSPIF = 0; // Reset IRQ flag
+	i2c_slave_state(&ui8_slave_state);
+	if(ui8_slave_state == 1) {
+		ui8_i2c_value = i2c_slave_read(); // Read SSPBUF to clear BF bit, address byte
+		CKP = 1; // release the clock, the next byte is received meanwhile
+		frame_receive_start();
+		if(ui8_i2c_value == 0x00) {
+			frame_receive_general_call();
+		}
+		/* else own address */
+	}
+	else if(ui8_slave_state == 2) {
+		ui8_i2c_value = i2c_slave_read(); // Read SSPBUF to clear BF bit and read data from master
+		CKP = 1; // release the clock, the next byte is received meanwhile
+		frame_receive(ui8_i2c_value); // save it in the lane of its frame
+	}
+	else if(ui8_slave_state == 3) {
+		i2c_slave_read(); // Read SSPBUF to clear BF bit but don't care about returned value
+		frame_receive_start();
+		gui8_i2c_send_idx = 0;
+	}
+	/* else nothing to do */
+
+	if((ui8_slave_state == 3) || (ui8_slave_state == 4)) {
+		i2c_slave_write(frame_read_byte(gui8_i2c_send_idx));
+		gui8_i2c_send_idx ++;
+		CKP = 1;
+	}
+	/* else nothing to do */
+}
+
 /**
  * @fn int8_t i2c_init(void)
  * @brief Initialise the I2C in slave mode
@@ -199,8 +329,15 @@ int8_t i2c_init(void) {
 	SSPM1 = 1;
 	SSPM0 = 0;
 
+	// address straps with the weak pull-ups of the port B
+	TRISB4 = 1;
+	TRISB5 = 1;
+	nRBPU = 0;
+	// an open strap is pulled up through the pin capacitance
+	__delay_us(10);
+
 	// Set the Slave address
-	SSPADD = PIC16F876A_I2C_SLAVE_ADDR << 1;  // 7 bits address = Bits 7654 321 <7:1>
+	SSPADD = i2c_own_addr() << 1;  // 7 bits address = Bits 7654 321 <7:1>
 	
 	// CKP: SCK Release Control bit
 	CKP = 1;
@@ -208,10 +345,17 @@ int8_t i2c_init(void) {
 	// Synchronous Serial Port Enable bit
 	SSPEN = 1;
 	
-	SSPCON2 = 0x01;
+	// GCEN : the general call address (0x00) is acknowledged too
+	// SEN : the clock is stretched after each byte received until CKP is
+	// set, the interrupt of a byte may last longer than the next byte
+	SSPCON2 = 0x81;
 		
 	//SMP: Slew Rate Control bit
-	SMP = 1;
+#ifdef I2C_FAST_MODE
+	SMP = 0; // enabled for the fast mode (400 kHz)
+#else
+	SMP = 1; // disabled for the standard speed (100 kHz)
+#endif
 
 	//enable I²C interrupt
 	SSPIE = 1;
@@ -17,6 +17,12 @@
   *       ---------------------------------------------------------------------------------
   * Row 2 | 40 | 41 | 42 | 43 | 44 | 45 | 46 | 47 | 48 | 49 | 4A | 4B | 4C | 4D | 4E | 4F |
   *       ---------------------------------------------------------------------------------
+  *
+  * Each line is 40 characters long (0x00-0x27 and 0x40-0x67), the display
+  * shift instructions move the 16 visible columns along the line :
+  *
+  *       0x18 : shift left  => columns 2 to 17 are visible
+  *       0x1C : shift right => columns 40, 1 to 15 are visible
   *      
   *         
   *                    VCC
@@ -49,6 +55,19 @@
   *                     ---
   *                     VCC
   * 
+  * Second display (make LCD2=1) : another HD44780 wired in parallel (D4-D7
+  * and RS shared) with its EN on RB1. Each display keeps its address
+  * counter, cursor, display control and busy time (5 bytes), selecting one
+  * only changes the index. The shadow is only kept for the first display :
+  * the second one doesn't scroll, isn't updated in the off-screen page nor
+  * saved, its characters are always written. Both are initialised
+  * together, the logo is only shown on the first one.
+  *
+  * Execution time : the bytes are written without waiting, Timer0 (32 us per
+  * count) times the instruction and the next write to the same display
+  * waits for its end. The other display is written meanwhile. The driver
+  * shares no variable with the interrupt : it is called with the interrupts
+  * enabled and the bus is served while it waits.
   */                   
 
 /*************************************************************************
@@ -56,6 +75,8 @@
  *************************************************************************/
 
 #include "pic16f876a_controller_lcd.h"
+#include "pic16f876a_controller_eeprom.h"
+#include "pic16f876a_controller_timer.h"
 
 /*************************************************************************
  * Constante(s)/Macro(s)
@@ -69,6 +90,96 @@
 #define LCD_D6			RA2
 #define LCD_D7			RA3
 
+#define LCD2_EN			RB1
+
+#ifdef LCD2_ENABLE
+#define LCD_SELECTED	gui8_lcd_display	/*!< Index of the state of the display selected */
+#define LCD_STATE_BANK	bank3				/*!< See LCD_BANK3_SIZE */
+#else
+#define LCD_SELECTED	LCD_DISPLAY_1
+#define LCD_STATE_BANK	bank2
+#endif
+#define LCD_IS_FIRST	(LCD_SELECTED == LCD_DISPLAY_1)	/*!< Display with a shadow */
+
+#define LCD_TMR0_US		32		/*!< Timer0 count (Fosc/4, prescaler 1:64) */
+#define LCD_WAIT_DATA	((200 / LCD_TMR0_US) + 2)	/*!< Data write time (counts) */
+#define LCD_WAIT_CMD	((5000 / LCD_TMR0_US) + 2)	/*!< Command time (counts) */
+
+#define LCD_ROW2_ADDR		0x40	/*!< DDRAM address of the second row */
+#define LCD_CONTROL_ON		0x0C	/*!< Display on, cursor off, blink off */
+#define LCD_CURSOR_SHOWN	0x03	/*!< Cursor or blink bits of display control */
+#define LCD_SHIFT_LEFT		0x18	/*!< Display shift left command */
+#define LCD_SHIFT_RIGHT		0x1C	/*!< Display shift right command */
+#define LCD_SCROLL_UNIT		10		/*!< Unit of the scroll period (ms) */
+#define LCD_CELL_UNKNOWN	0x10	/*!< Shadow of a cell shifted in (blank in the ROM) */
+
+#define LCD_MASK_SIZE		(LCD_SCREEN_SIZE / 8)	/*!< Bytes of a mask of cells (1 bit each) */
+#define LCD_IS_MARKED(mask, cell)	(((mask)[(cell) >> 3] & gpui8_lcd_bit[(cell) & 0x07]) != 0)
+#define LCD_MARK(mask, cell)		((mask)[(cell) >> 3] |= gpui8_lcd_bit[(cell) & 0x07])
+#define LCD_UNMARK(mask, cell)		((mask)[(cell) >> 3] &= ~gpui8_lcd_bit[(cell) & 0x07])
+
+#define LCD_SNAPSHOT_ADDR	0xDD	/*!< EEPROM address of the saved screen */
+#define LCD_SNAPSHOT_MAGIC	0x5A	/*!< Marker of a valid saved screen */
+
+#define LCD_INIT_WAKE_UP_1	0		/*!< First 8 bits function set */
+#define LCD_INIT_WAKE_UP_2	1		/*!< Second 8 bits function set */
+#define LCD_INIT_WAKE_UP_3	2		/*!< Third 8 bits function set */
+#define LCD_INIT_4_BITS		3		/*!< Four bits interface */
+#define LCD_INIT_COMMANDS	4		/*!< Initialisation commands */
+#define LCD_INIT_SPLASH		5		/*!< Logo or saved screen */
+#define LCD_READY			6		/*!< Initialisation done */
+
+#define LCD_INIT_NB_CMD		5		/*!< Number of initialisation commands */
+#define LCD_LOGO_DELAY		2500	/*!< Time the logo stays alone (ms) */
+
+const uint8_t gpui8_lcd_init_cmd[LCD_INIT_NB_CMD] = {0x28, 0x08, 0x01, 0x06, LCD_CONTROL_ON};
+const uint8_t gpui8_lcd_bit[8] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
+
+bank2 uint8_t gui8_lcd_init_state = LCD_INIT_WAKE_UP_1;	/*!< Current initialisation step */
+bank2 uint8_t gui8_lcd_init_cmd = 0;				/*!< Next initialisation command */
+bank2 uint16_t gui16_lcd_init_start = 0;			/*!< Tick at the start of the step delay */
+bank2 uint16_t gui16_lcd_init_delay = 0;			/*!< Step delay (ticks) */
+bit gb_flag_lcd_warm_boot;				/*!< Restore the saved screen */
+
+bank1 uint8_t gpui8_lcd_shadow[LCD_SCREEN_SIZE];	/*!< Copy of the visible DDRAM */
+
+bank2 uint8_t gui8_lcd_shift = 0;					/*!< First visible column of the lines */
+bank2 uint8_t gui8_lcd_scroll_cmd = 0;			/*!< Shift command of the scroll */
+bank2 uint8_t gui8_lcd_scroll_count = 0;			/*!< Remaining steps (0 : endless) */
+bank2 uint8_t gui8_lcd_scroll_period = 0;			/*!< Scroll period (0 : stopped) */
+bank2 uint16_t gui16_lcd_scroll_start = 0;		/*!< Tick of the last step */
+
+/*
+ * Off-screen page : instead of a second copy of the screen, two masks
+ * mark the cells which aren't shown yet. A cell to write holds its new
+ * value in the shadow, a cell cleared to a space keeps the value shown
+ * so that writing it back costs nothing.
+ *
+ * This is where the address and data sequences are reordered : the
+ * commit writes the marked cells in address order whatever the order of
+ * the frames, a run of cells costs one set address command. Out of an
+ * update the frames are written in their order, reordering them would
+ * hold the characters back.
+ */
+bank3 uint8_t gpui8_lcd_dirty[LCD_MASK_SIZE];	/*!< Cells to write with their shadow */
+bank3 uint8_t gpui8_lcd_blank[LCD_MASK_SIZE];	/*!< Cells to write with a space */
+bank2 uint8_t gui8_lcd_stage_addr = 0;			/*!< DDRAM address in the off-screen page */
+bit gb_flag_lcd_staging;				/*!< Update in progress */
+bit gb_flag_lcd_coalesce;				/*!< Writes coalesced in the off-screen page */
+bit gb_flag_lcd_hold;					/*!< Update in progress while coalescing */
+bank2 uint8_t gui8_lcd_flush_cell = 0;			/*!< Next cell checked by the flush */
+
+bank2 uint8_t gui8_lcd_display = LCD_DISPLAY_1;	/*!< Display selected */
+
+/*
+ * State of each display, indexed by the display selected
+ */
+LCD_STATE_BANK uint8_t gpui8_lcd_addr[LCD_NB_DISPLAYS];		/*!< DDRAM address counter of the LCD */
+LCD_STATE_BANK uint8_t gpui8_lcd_cursor[LCD_NB_DISPLAYS];		/*!< DDRAM address of the next character */
+LCD_STATE_BANK uint8_t gpui8_lcd_control[LCD_NB_DISPLAYS];	/*!< Current display control command */
+LCD_STATE_BANK uint8_t gpui8_lcd_busy_start[LCD_NB_DISPLAYS];	/*!< Timer0 at the last write */
+LCD_STATE_BANK uint8_t gpui8_lcd_busy_wait[LCD_NB_DISPLAYS];	/*!< Time of the last write (0 : over) */
+
 /*************************************************************************
  * Prototype(s)
  *************************************************************************/
@@ -78,12 +189,77 @@
  */
 int8_t lcd_write_byte(const uint8_t /* in */ ui8_byte);
 
-/* 
- * Initialise custom characters 
+/*
+ * Write 4 bits to the LCD
  */
-int8_t lcd_define_custom_char(const uint8_t /* in */ ui8_custom_char_size,
-							  const char_t * /* in */ pi8_custom_char,
-							  const uint8_t /* in */ ui8_addr_offset);
+void lcd_write_nibble(const uint8_t /* in */ ui8_nibble);
+
+/*
+ * Wait for the end of the last instruction of the display selected
+ */
+void lcd_wait_ready(void);
+
+/*
+ * Fill the shadow of the visible cells with spaces
+ */
+void lcd_reset_shadow(void);
+
+/*
+ * Go to the next step of the initialisation after a delay
+ */
+void lcd_init_wait(const uint8_t /* in */ ui8_next_state,
+		   const uint16_t /* in */ ui16_delay_ms);
+
+/*
+ * Write a character at the current address and follow the address counter
+ */
+void lcd_write_data(const uint8_t /* in */ ui8_value);
+
+/*
+ * Write a character in the off-screen page
+ */
+void lcd_store_data(const uint8_t /* in */ ui8_value);
+
+/*
+ * Set the DDRAM address
+ */
+void lcd_set_addr(const uint8_t /* in */ ui8_addr);
+
+/*
+ * Send the pending set address command
+ */
+void lcd_sync_cursor(void);
+
+/*
+ * Shift the visible columns one step
+ */
+void lcd_shift_display(const uint8_t /* in */ ui8_command);
+
+/*
+ * Follow a display shift in the shadow and the mask of the cells to write
+ */
+void lcd_shift_cells(const uint8_t /* in */ ui8_command);
+
+/*
+ * Move the marks of a cell along with its shadow
+ */
+void lcd_copy_marks(const uint8_t /* in */ ui8_cell,
+		    const uint8_t /* in */ ui8_from);
+
+/*
+ * Value of a cell in the off-screen page
+ */
+uint8_t lcd_stage_value(const uint8_t /* in */ ui8_cell);
+
+/*
+ * Visible cell of a DDRAM address with the display shift
+ */
+uint8_t lcd_view_cell(const uint8_t /* in */ ui8_addr);
+
+/*
+ * DDRAM address of a visible cell with the display shift
+ */
+uint8_t lcd_view_addr(const uint8_t /* in */ ui8_cell);
 
 /* 
  * Load EEPROM data(s) in RAM 
@@ -104,47 +280,481 @@ int8_t lcd_alf_set_track_name(const uint8_t /* in */ ui8_eeprom_addr,
  * Fonction(s)
  *************************************************************************/
 
+/**
+ * @fn void lcd_write_nibble(const uint8_t ui8_nibble) 
+ * 
+ * @brief write the 4 lower bits on D4-D7 and pulse EN of the display
+ *        selected (of both displays until the logo)
+ * 
+ * @param [in] ui8_nibble	bits to write to the bus
+ * @return nothing
+ */
+void lcd_write_nibble(const uint8_t /* in */ ui8_nibble) {
+	LCD_D4 = ui8_nibble & 0x01;
+	LCD_D5 = (ui8_nibble >> 1) & 0x01;
+	LCD_D6 = (ui8_nibble >> 2) & 0x01;
+	LCD_D7 = (ui8_nibble >> 3) & 0x01;
+	
+#ifdef LCD2_ENABLE
+	if((gui8_lcd_display == LCD_DISPLAY_2) ||
+	   (gui8_lcd_init_state < LCD_INIT_SPLASH)) {
+		LCD2_EN = 1;
+	}
+	/* else nothing to do */
+	if(gui8_lcd_display == LCD_DISPLAY_1) {
+		LCD_EN = 1;
+	}
+	/* else nothing to do */
+	NOP();
+	LCD_EN = 0;
+	LCD2_EN = 0;
+#else
+	LCD_EN = 1; 
+	NOP();
+	LCD_EN = 0;
+#endif
+}
+
+/**
+ * @fn void lcd_wait_ready(void)
+ * @brief wait for the end of the last instruction written to the
+ *        display selected
+ * @param none
+ * @return nothing
+ */
+void lcd_wait_ready(void) {
+	while((gpui8_lcd_busy_wait[LCD_SELECTED] != 0) &&
+	      ((uint8_t)(TMR0 - gpui8_lcd_busy_start[LCD_SELECTED]) < gpui8_lcd_busy_wait[LCD_SELECTED])) {
+	}
+	gpui8_lcd_busy_wait[LCD_SELECTED] = 0;
+}
+
 /**
  * @fn void lcd_write_byte(uint8_t ui8_char) 
  * 
- * @brief write a byte to the LCD in 4 bit mode 
+ * @brief write a byte to the LCD in 4 bit mode, the instruction is
+ *        executed while the caller goes on
  * 
  * @param [in] ui8_char		byte to write to the bus
  * @return RET_NOK if an error occurs during execution otherwise
  *         RET_OK
  */
 int8_t lcd_write_byte(const uint8_t /* in */ ui8_byte) {
-	LCD_D4 = (ui8_byte >> 4) & 0x01;
-	LCD_D5 = (ui8_byte >> 5) & 0x01;
-	LCD_D6 = (ui8_byte >> 6) & 0x01;
-	LCD_D7 = (ui8_byte >> 7) & 0x01;
-	
-	LCD_EN = 1; 
-	NOP();
-	LCD_EN = 0;
+	lcd_wait_ready();
+	lcd_write_nibble(ui8_byte >> 4);
+	lcd_write_nibble(ui8_byte);
+
+	gpui8_lcd_busy_start[LCD_SELECTED] = TMR0;
 	if(LCD_RS == 1) {
-		__delay_us(200);
+		gpui8_lcd_busy_wait[LCD_SELECTED] = LCD_WAIT_DATA;
 	}
 	else {
-		__delay_ms(5);
+		gpui8_lcd_busy_wait[LCD_SELECTED] = LCD_WAIT_CMD;
 	}
-	LCD_D4 = ui8_byte & 0x01;
-	LCD_D5 = (ui8_byte >> 1) & 0x01;
-	LCD_D6 = (ui8_byte >> 2) & 0x01;
-	LCD_D7 = (ui8_byte >> 3) & 0x01;
-	
-	LCD_EN = 1; 
-	NOP();
-	LCD_EN = 0;
-	if(LCD_RS == 1) {
-		__delay_us(200);
+	return RET_OK;
+}
+
+/**
+ * @fn void lcd_busy_task(void)
+ * @brief forget the instructions which are over, Timer0 wraps after
+ *        8 ms (an instruction over but seen late is only waited for
+ *        again)
+ * @param none
+ * @return nothing
+ */
+void lcd_busy_task(void) {
+	uint8_t ui8_idx = 0;
+
+	for(ui8_idx = 0; ui8_idx < LCD_NB_DISPLAYS; ui8_idx ++) {
+		if((uint8_t)(TMR0 - gpui8_lcd_busy_start[ui8_idx]) >= gpui8_lcd_busy_wait[ui8_idx]) {
+			gpui8_lcd_busy_wait[ui8_idx] = 0;
+		}
+		/* else nothing to do */
 	}
-	else {
-		__delay_ms(5);
+}
+
+/**
+ * @fn int8_t lcd_select(const uint8_t ui8_display)
+ * @brief select the display written by the next calls
+ *
+ * Only the first display scrolls, is updated in the off-screen page or
+ * is saved in the EEPROM.
+ *
+ * @param [in] ui8_display	LCD_DISPLAY_1 or LCD_DISPLAY_2
+ * @return RET_NOK if the display isn't fitted otherwise RET_OK
+ */
+int8_t lcd_select(const uint8_t /* in */ ui8_display) {
+	if(ui8_display >= LCD_NB_DISPLAYS) {
+		return RET_NOK;
 	}
+	/* else nothing to do */
+
+	gui8_lcd_display = ui8_display;
 	return RET_OK;
 }
 
+/**
+ * @fn uint8_t lcd_next_addr(const uint8_t ui8_addr)
+ * @brief follow the auto-increment of the address counter after a data
+ *        write (0x27 -> 0x40 and 0x67 -> 0x00)
+ * @param [in] ui8_addr		DDRAM address
+ * @return the next DDRAM address
+ */
+uint8_t lcd_next_addr(const uint8_t /* in */ ui8_addr) {
+	if(ui8_addr == (LCD_LINE_SIZE - 1)) {
+		return LCD_ROW2_ADDR;
+	}
+	else if(ui8_addr == (LCD_ROW2_ADDR + LCD_LINE_SIZE - 1)) {
+		return 0;
+	}
+	/* else nothing to do */
+	return ui8_addr + 1;
+}
+
+/**
+ * @fn uint8_t lcd_addr_to_cell(const uint8_t ui8_addr)
+ * @brief retrieve the index of a visible cell in the shadow, the display
+ *        isn't shifted
+ * @param [in] ui8_addr		DDRAM address
+ * @return the index of the cell, LCD_SCREEN_SIZE if the address
+ *         isn't visible
+ */
+uint8_t lcd_addr_to_cell(const uint8_t /* in */ ui8_addr) {
+	uint8_t ui8_column = ui8_addr & 0x3F;
+
+	if(ui8_column >= LCD_NB_COLUMNS) {
+		return LCD_SCREEN_SIZE;
+	}
+	/* else nothing to do */
+
+	if(ui8_addr >= LCD_ROW2_ADDR) {
+		ui8_column += LCD_NB_COLUMNS;
+	}
+	/* else nothing to do */
+	return ui8_column;
+}
+
+/**
+ * @fn uint8_t lcd_cell_to_addr(const uint8_t ui8_cell)
+ * @brief retrieve the DDRAM address of a visible cell, the display isn't
+ *        shifted
+ * @param [in] ui8_cell		index of the cell in the shadow
+ * @return the DDRAM address
+ */
+uint8_t lcd_cell_to_addr(const uint8_t /* in */ ui8_cell) {
+	if(ui8_cell >= LCD_NB_COLUMNS) {
+		return LCD_ROW2_ADDR + (ui8_cell - LCD_NB_COLUMNS);
+	}
+	/* else nothing to do */
+	return ui8_cell;
+}
+
+/**
+ * @fn uint8_t lcd_view_cell(const uint8_t ui8_addr)
+ * @brief retrieve the index of the visible cell showing a DDRAM address,
+ *        the columns are counted from the first visible one
+ * @param [in] ui8_addr		DDRAM address
+ * @return the index of the cell, LCD_SCREEN_SIZE if the address
+ *         isn't visible
+ */
+uint8_t lcd_view_cell(const uint8_t /* in */ ui8_addr) {
+	uint8_t ui8_column = ui8_addr & 0x3F;
+
+	if(ui8_column >= LCD_LINE_SIZE) {
+		return LCD_SCREEN_SIZE;
+	}
+	/* else nothing to do */
+
+	// modulo the line size
+	if(ui8_column < gui8_lcd_shift) {
+		ui8_column += LCD_LINE_SIZE;
+	}
+	/* else nothing to do */
+	ui8_column -= gui8_lcd_shift;
+	return lcd_addr_to_cell((ui8_addr & LCD_ROW2_ADDR) | ui8_column);
+}
+
+/**
+ * @fn uint8_t lcd_view_addr(const uint8_t ui8_cell)
+ * @brief retrieve the DDRAM address shown by a visible cell
+ * @param [in] ui8_cell		index of the cell in the shadow
+ * @return the DDRAM address
+ */
+uint8_t lcd_view_addr(const uint8_t /* in */ ui8_cell) {
+	uint8_t ui8_addr = lcd_cell_to_addr(ui8_cell);
+	uint8_t ui8_column = (ui8_addr & 0x3F) + gui8_lcd_shift;
+
+	// modulo the line size
+	if(ui8_column >= LCD_LINE_SIZE) {
+		ui8_column -= LCD_LINE_SIZE;
+	}
+	/* else nothing to do */
+	return (ui8_addr & LCD_ROW2_ADDR) | ui8_column;
+}
+
+/**
+ * @fn void lcd_set_addr(const uint8_t ui8_addr)
+ * @brief set the DDRAM address
+ * @param [in] ui8_addr		DDRAM address
+ * @return nothing
+ */
+void lcd_set_addr(const uint8_t /* in */ ui8_addr) {
+	LCD_RS = 0;
+	lcd_write_byte(0x80 | ui8_addr);
+	gpui8_lcd_addr[LCD_SELECTED] = ui8_addr;
+	gpui8_lcd_cursor[LCD_SELECTED] = ui8_addr;
+}
+
+/**
+ * @fn void lcd_sync_cursor(void)
+ * @brief send the pending set address command, if the address counter
+ *        of the LCD isn't already there
+ * @param none
+ * @return nothing
+ */
+void lcd_sync_cursor(void) {
+	if(gpui8_lcd_cursor[LCD_SELECTED] != gpui8_lcd_addr[LCD_SELECTED]) {
+		lcd_set_addr(gpui8_lcd_cursor[LCD_SELECTED]);
+	}
+	/* else nothing to do */
+}
+
+/**
+ * @fn void lcd_write_data(const uint8_t ui8_value)
+ * @brief write a character at the cursor, keep the shadow of the 
+ *        visible cells up to date
+ *
+ * The set address command is only sent here, when the address counter
+ * of the LCD isn't already at the cursor.
+ *
+ * @param [in] ui8_value	character to write
+ * @return nothing
+ */
+void lcd_write_data(const uint8_t /* in */ ui8_value) {
+	uint8_t ui8_cell = lcd_view_cell(gpui8_lcd_cursor[LCD_SELECTED]);
+
+	lcd_sync_cursor();
+	LCD_RS = 1;	// write character
+	lcd_write_byte(ui8_value);
+	LCD_RS = 0;
+
+	if((ui8_cell < LCD_SCREEN_SIZE) && LCD_IS_FIRST) {
+		gpui8_lcd_shadow[ui8_cell] = ui8_value;
+	}
+	/* else nothing to do */
+	// the address counter is auto-incremented
+	gpui8_lcd_addr[LCD_SELECTED] = lcd_next_addr(gpui8_lcd_addr[LCD_SELECTED]);
+	gpui8_lcd_cursor[LCD_SELECTED] = gpui8_lcd_addr[LCD_SELECTED];
+}
+
+/**
+ * @fn void lcd_write_cell(const uint8_t ui8_cell, const uint8_t ui8_value)
+ * @brief write a character in a visible cell if it changes, the cursor
+ *        of the frames isn't moved
+ *
+ * @param [in] ui8_cell		index of the cell (0 to LCD_SCREEN_SIZE - 1)
+ * @param [in] ui8_value	character to write
+ * @return nothing
+ */
+void lcd_write_cell(const uint8_t /* in */ ui8_cell,
+		    const uint8_t /* in */ ui8_value) {
+	uint8_t ui8_cursor = 0;
+
+	if(ui8_cell >= LCD_SCREEN_SIZE) {
+		return;
+	}
+	/* else nothing to do */
+
+	// marquee and animation of the first display
+	lcd_select(LCD_DISPLAY_1);
+	ui8_cursor = gpui8_lcd_cursor[LCD_SELECTED];
+
+	// a cell of the off-screen page isn't shown yet, it's written anyway
+	// and isn't overwritten by the commit
+	if(LCD_IS_MARKED(gpui8_lcd_dirty, ui8_cell) ||
+	   LCD_IS_MARKED(gpui8_lcd_blank, ui8_cell)) {
+		LCD_UNMARK(gpui8_lcd_dirty, ui8_cell);
+		LCD_UNMARK(gpui8_lcd_blank, ui8_cell);
+	}
+	else if((gpui8_lcd_shadow[ui8_cell] == ui8_value) &&
+		(ui8_value != LCD_CELL_UNKNOWN)) {
+		return;
+	}
+	/* else nothing to do */
+
+	gpui8_lcd_cursor[LCD_SELECTED] = lcd_view_addr(ui8_cell);
+	lcd_write_data(ui8_value);
+	gpui8_lcd_cursor[LCD_SELECTED] = ui8_cursor;
+}
+
+/**
+ * @fn void lcd_store_data(const uint8_t ui8_value)
+ * @brief write a character in the off-screen page during an update
+ *
+ * @param [in] ui8_value	character to write
+ * @return nothing
+ */
+void lcd_store_data(const uint8_t /* in */ ui8_value) {
+	uint8_t ui8_cell = lcd_view_cell(gui8_lcd_stage_addr);
+
+	if(ui8_cell < LCD_SCREEN_SIZE) {
+		// a cleared cell written back with the value shown is left as it is
+		LCD_UNMARK(gpui8_lcd_blank, ui8_cell);
+		if(gpui8_lcd_shadow[ui8_cell] != ui8_value) {
+			gpui8_lcd_shadow[ui8_cell] = ui8_value;
+			LCD_MARK(gpui8_lcd_dirty, ui8_cell);
+		}
+		/* else nothing to do */
+	}
+	/* else nothing to do */
+	gui8_lcd_stage_addr = lcd_next_addr(gui8_lcd_stage_addr);
+}
+
+/**
+ * @fn void lcd_begin_update(void)
+ * @brief start an update : the next writes are done in the off-screen 
+ *        page until lcd_commit() 
+ * @param none
+ * @return nothing
+ */
+void lcd_begin_update(void) {
+	if(gb_flag_lcd_staging == 1) {
+		// the coalesced writes aren't flushed until the commit
+		gb_flag_lcd_hold = gb_flag_lcd_coalesce;
+		return;
+	}
+	/* else nothing to do */
+
+	// no cell is marked out of an update
+	gui8_lcd_stage_addr = gpui8_lcd_cursor[LCD_SELECTED];
+	gb_flag_lcd_staging = 1;
+}
+
+/**
+ * @fn void lcd_commit(void)
+ * @brief end an update : only the cells marked in the off-screen page
+ *        are written, then the cursor is set where the update left it
+ * @param none
+ * @return nothing
+ */
+void lcd_commit(void) {
+	uint8_t ui8_idx = 0;
+	uint8_t ui8_value = 0;
+
+	if(gb_flag_lcd_staging == 0) {
+		return;
+	}
+	/* else nothing to do */
+
+	if(gb_flag_lcd_coalesce == 1) {
+		// the off-screen page stays in use
+		gb_flag_lcd_hold = 0;
+	}
+	else {
+		gb_flag_lcd_staging = 0;
+	}
+
+	for(ui8_idx = 0; ui8_idx < LCD_SCREEN_SIZE; ui8_idx ++) {
+		if(LCD_IS_MARKED(gpui8_lcd_dirty, ui8_idx) ||
+		   LCD_IS_MARKED(gpui8_lcd_blank, ui8_idx)) {
+			ui8_value = lcd_stage_value(ui8_idx);
+			LCD_UNMARK(gpui8_lcd_dirty, ui8_idx);
+			LCD_UNMARK(gpui8_lcd_blank, ui8_idx);
+			// consecutive cells are written without setting the address
+			gpui8_lcd_cursor[LCD_SELECTED] = lcd_view_addr(ui8_idx);
+			lcd_write_data(ui8_value);
+		}
+		/* else nothing to do */
+	}
+
+	gpui8_lcd_cursor[LCD_SELECTED] = gui8_lcd_stage_addr;
+	if((gpui8_lcd_control[LCD_SELECTED] & LCD_CURSOR_SHOWN) != 0) {
+		lcd_sync_cursor();
+	}
+	/* else the address is set with the next character */
+}
+
+/**
+ * @fn void lcd_set_coalesce(const uint8_t ui8_on)
+ * @brief start (or stop) coalescing the writes : they are done in the
+ *        off-screen page and lcd_flush_task() copies the marked cells
+ *        to the screen, a cell written several times before
+ *        being flushed is only written once with its last value
+ *
+ * @param [in] ui8_on	1 to coalesce the writes, 0 to write them at once
+ * @return nothing
+ */
+void lcd_set_coalesce(const uint8_t /* in */ ui8_on) {
+	uint8_t ui8_update = gb_flag_lcd_staging;
+
+	if(ui8_on == 1) {
+		if(gb_flag_lcd_coalesce == 0) {
+			lcd_begin_update();
+			// an update may already be in progress
+			gb_flag_lcd_hold = ui8_update;
+			gb_flag_lcd_coalesce = 1;
+			gui8_lcd_flush_cell = 0;
+		}
+		/* else nothing to do */
+	}
+	else if(gb_flag_lcd_coalesce == 1) {
+		gb_flag_lcd_coalesce = 0;
+		if(gb_flag_lcd_hold == 1) {
+			// the update ends with its commit
+			gb_flag_lcd_hold = 0;
+		}
+		else {
+			lcd_commit();
+		}
+	}
+	/* else nothing to do */
+}
+
+/**
+ * @fn void lcd_flush_task(void)
+ * @brief write the next marked cell of the off-screen page (one cell
+ *        per call) when the writes are coalesced
+ * @param none
+ * @return nothing
+ */
+void lcd_flush_task(void) {
+	uint8_t ui8_idx = 0;
+	uint8_t ui8_value = 0;
+	uint8_t ui8_cell = gui8_lcd_flush_cell;
+
+	if((gb_flag_lcd_coalesce == 0) || (gb_flag_lcd_hold == 1)) {
+		return;
+	}
+	/* else nothing to do */
+	lcd_select(LCD_DISPLAY_1);
+
+	for(ui8_idx = 0; ui8_idx < LCD_SCREEN_SIZE; ui8_idx ++) {
+		if(LCD_IS_MARKED(gpui8_lcd_dirty, ui8_cell) ||
+		   LCD_IS_MARKED(gpui8_lcd_blank, ui8_cell)) {
+			ui8_value = lcd_stage_value(ui8_cell);
+			LCD_UNMARK(gpui8_lcd_dirty, ui8_cell);
+			LCD_UNMARK(gpui8_lcd_blank, ui8_cell);
+			gpui8_lcd_cursor[LCD_SELECTED] = lcd_view_addr(ui8_cell);
+			lcd_write_data(ui8_value);
+			gpui8_lcd_cursor[LCD_SELECTED] = gui8_lcd_stage_addr;
+			if((gpui8_lcd_control[LCD_SELECTED] & LCD_CURSOR_SHOWN) != 0) {
+				lcd_sync_cursor();
+			}
+			/* else the address is set with the next character */
+			ui8_idx = LCD_SCREEN_SIZE;
+		}
+		/* else nothing to do */
+
+		// the following cell is checked first on the next call
+		ui8_cell ++;
+		if(ui8_cell == LCD_SCREEN_SIZE) {
+			ui8_cell = 0;
+		}
+		/* else nothing to do */
+	}
+	gui8_lcd_flush_cell = ui8_cell;
+}
+
 /**
  * @fn void lcd_clear_display(void)
  * 
@@ -154,8 +764,54 @@ int8_t lcd_write_byte(const uint8_t /* in */ ui8_byte) {
  * @return nothing
  */
 void lcd_clear_display(void) {
+	uint8_t ui8_idx = 0;
+
+	// the second display is always written at once
+	if((gb_flag_lcd_staging == 1) && LCD_IS_FIRST) {
+		for(ui8_idx = 0; ui8_idx < LCD_SCREEN_SIZE; ui8_idx ++) {
+			if(LCD_IS_MARKED(gpui8_lcd_dirty, ui8_idx)) {
+				// the value shown isn't known anymore
+				gpui8_lcd_shadow[ui8_idx] = ' ';
+			}
+			else if(gpui8_lcd_shadow[ui8_idx] != ' ') {
+				LCD_MARK(gpui8_lcd_blank, ui8_idx);
+			}
+			/* else nothing to do */
+		}
+		gui8_lcd_stage_addr = 0;
+		return;
+	}
+	/* else nothing to do */
+
 	LCD_RS = 0;
 	lcd_write_byte(0x01);
+	lcd_reset_shadow();
+}
+
+/**
+ * @fn void lcd_reset_shadow(void)
+ * 
+ * @brief fill the shadow of the visible cells with spaces and home the
+ *        address counter (as the clear display command does), the
+ *        second display only homes its address counter
+ * 
+ * @param none
+ * @return nothing
+ */
+void lcd_reset_shadow(void) {
+	uint8_t ui8_idx = 0;
+
+	gpui8_lcd_addr[LCD_SELECTED] = 0;
+	gpui8_lcd_cursor[LCD_SELECTED] = 0;
+	if(LCD_SELECTED != LCD_DISPLAY_1) {
+		return;
+	}
+	/* else nothing to do */
+
+	for(ui8_idx = 0; ui8_idx < LCD_SCREEN_SIZE; ui8_idx ++) {
+		gpui8_lcd_shadow[ui8_idx] = ' ';
+	}
+	gui8_lcd_shift = 0;
 }
 
 /**
@@ -166,8 +822,202 @@ void lcd_clear_display(void) {
  * @return none
  */
 void lcd_return_home(void) {
+	if((gb_flag_lcd_staging == 1) && LCD_IS_FIRST) {
+		gui8_lcd_stage_addr = 0;
+		return;
+	}
+	/* else nothing to do */
+
 	LCD_RS = 0;
 	lcd_write_byte(0x02);
+	gpui8_lcd_addr[LCD_SELECTED] = 0;
+	gpui8_lcd_cursor[LCD_SELECTED] = 0;
+	// the display shift (of the first display) is cancelled too
+	while((gui8_lcd_shift != 0) && LCD_IS_FIRST) {
+		if(gui8_lcd_shift > (LCD_LINE_SIZE / 2)) {
+			lcd_shift_cells(LCD_SHIFT_LEFT);
+		}
+		else {
+			lcd_shift_cells(LCD_SHIFT_RIGHT);
+		}
+	}
+}
+
+/**
+ * @fn void lcd_shift_display(const uint8_t ui8_command)
+ * @brief shift the visible columns one step along the lines
+ *
+ * @param [in] ui8_command	LCD_SHIFT_LEFT or LCD_SHIFT_RIGHT
+ * @return nothing
+ */
+void lcd_shift_display(const uint8_t /* in */ ui8_command) {
+	LCD_RS = 0;
+	lcd_write_byte(ui8_command);
+	lcd_shift_cells(ui8_command);
+}
+
+/**
+ * @fn void lcd_shift_cells(const uint8_t ui8_command)
+ * @brief move the cells of the shadow and their marks as the display
+ *        shift moves them on the screen, the cell shifted in shows a
+ *        hidden column which isn't known (LCD_CELL_UNKNOWN)
+ *
+ * @param [in] ui8_command	LCD_SHIFT_LEFT or LCD_SHIFT_RIGHT
+ * @return nothing
+ */
+void lcd_shift_cells(const uint8_t /* in */ ui8_command) {
+	uint8_t ui8_row = 0;
+	uint8_t ui8_idx = 0;
+
+	for(ui8_row = 0; ui8_row < LCD_SCREEN_SIZE; ui8_row += LCD_NB_COLUMNS) {
+		if(ui8_command == LCD_SHIFT_LEFT) {
+			for(ui8_idx = ui8_row; ui8_idx < (ui8_row + LCD_NB_COLUMNS - 1); ui8_idx ++) {
+				gpui8_lcd_shadow[ui8_idx] = gpui8_lcd_shadow[ui8_idx + 1];
+				lcd_copy_marks(ui8_idx, ui8_idx + 1);
+			}
+		}
+		else {
+			for(ui8_idx = ui8_row + LCD_NB_COLUMNS - 1; ui8_idx > ui8_row; ui8_idx --) {
+				gpui8_lcd_shadow[ui8_idx] = gpui8_lcd_shadow[ui8_idx - 1];
+				lcd_copy_marks(ui8_idx, ui8_idx - 1);
+			}
+		}
+		// ui8_idx : cell shifted in, never written to the off-screen page
+		gpui8_lcd_shadow[ui8_idx] = LCD_CELL_UNKNOWN;
+		LCD_UNMARK(gpui8_lcd_dirty, ui8_idx);
+		LCD_UNMARK(gpui8_lcd_blank, ui8_idx);
+	}
+
+	if(ui8_command == LCD_SHIFT_LEFT) {
+		gui8_lcd_shift ++;
+		if(gui8_lcd_shift == LCD_LINE_SIZE) {
+			gui8_lcd_shift = 0;
+		}
+		/* else nothing to do */
+	}
+	else {
+		if(gui8_lcd_shift == 0) {
+			gui8_lcd_shift = LCD_LINE_SIZE;
+		}
+		/* else nothing to do */
+		gui8_lcd_shift --;
+	}
+}
+
+/**
+ * @fn void lcd_copy_marks(const uint8_t ui8_cell, const uint8_t ui8_from)
+ * @brief mark (or unmark) a cell as the cell whose shadow it takes
+ *
+ * @param [in] ui8_cell	cell moved to
+ * @param [in] ui8_from	cell moved from
+ * @return nothing
+ */
+void lcd_copy_marks(const uint8_t /* in */ ui8_cell,
+		    const uint8_t /* in */ ui8_from) {
+	if(LCD_IS_MARKED(gpui8_lcd_dirty, ui8_from)) {
+		LCD_MARK(gpui8_lcd_dirty, ui8_cell);
+	}
+	else {
+		LCD_UNMARK(gpui8_lcd_dirty, ui8_cell);
+	}
+
+	if(LCD_IS_MARKED(gpui8_lcd_blank, ui8_from)) {
+		LCD_MARK(gpui8_lcd_blank, ui8_cell);
+	}
+	else {
+		LCD_UNMARK(gpui8_lcd_blank, ui8_cell);
+	}
+}
+
+/**
+ * @fn uint8_t lcd_stage_value(const uint8_t ui8_cell)
+ * @brief value of a cell in the off-screen page : a space for a cleared
+ *        cell, its shadow otherwise (out of an update, the value shown)
+ *
+ * @param [in] ui8_cell	cell of the screen
+ * @return the value of the cell
+ */
+uint8_t lcd_stage_value(const uint8_t /* in */ ui8_cell) {
+	if(LCD_IS_MARKED(gpui8_lcd_blank, ui8_cell)) {
+		return ' ';
+	}
+	/* else nothing to do */
+
+	return gpui8_lcd_shadow[ui8_cell];
+}
+
+/**
+ * @fn int8_t lcd_scroll(const uint8_t ui8_direction,
+ *			const uint8_t ui8_count,
+ *			const uint8_t ui8_period)
+ * @brief scroll both lines with the display shift instructions
+ *
+ * Without period the steps are done at once. With a period, the steps
+ * are done by lcd_scroll_task(), count 0 scrolls until the next scroll.
+ * Lines wrap around after 40 steps, so a text written on the whole 
+ * 40 columns scrolls as a marquee without any further write.
+ *
+ * @param [in] ui8_direction	0 : left, 1 : right
+ * @param [in] ui8_count	number of steps
+ * @param [in] ui8_period	time between steps (10 ms unit)
+ * @return RET_NOK if the direction is invalid otherwise RET_OK
+ */
+int8_t lcd_scroll(const uint8_t /* in */ ui8_direction,
+		  const uint8_t /* in */ ui8_count,
+		  const uint8_t /* in */ ui8_period) {
+	uint8_t ui8_idx = 0;
+
+	if(ui8_direction > 1) {
+		return RET_NOK;
+	}
+	/* else nothing to do */
+
+	gui8_lcd_scroll_cmd = LCD_SHIFT_LEFT;
+	if(ui8_direction == 1) {
+		gui8_lcd_scroll_cmd = LCD_SHIFT_RIGHT;
+	}
+	/* else nothing to do */
+
+	gui8_lcd_scroll_count = ui8_count;
+	gui8_lcd_scroll_period = ui8_period;
+	gui16_lcd_scroll_start = timer_get_tick();
+
+	if(ui8_period == 0) {
+		for(ui8_idx = 0; ui8_idx < ui8_count; ui8_idx ++) {
+			lcd_shift_display(gui8_lcd_scroll_cmd);
+		}
+	}
+	/* else nothing to do */
+	return RET_OK;
+}
+
+/**
+ * @fn void lcd_scroll_task(void)
+ * @brief do the next step of a timed scroll
+ * @param none
+ * @return nothing
+ */
+void lcd_scroll_task(void) {
+	if((gui8_lcd_scroll_period == 0) ||
+	   (timer_elapsed(gui16_lcd_scroll_start, 
+			  (uint16_t)gui8_lcd_scroll_period * LCD_SCROLL_UNIT) == 0)) {
+		return;
+	}
+	/* else nothing to do */
+
+	gui16_lcd_scroll_start += (uint16_t)gui8_lcd_scroll_period * LCD_SCROLL_UNIT;
+	lcd_select(LCD_DISPLAY_1);
+	lcd_shift_display(gui8_lcd_scroll_cmd);
+
+	if(gui8_lcd_scroll_count != 0) {
+		gui8_lcd_scroll_count --;
+		if(gui8_lcd_scroll_count == 0) {
+			// last step
+			gui8_lcd_scroll_period = 0;
+		}
+		/* else nothing to do */
+	}
+	/* else endless scroll */
 }
 
 /**
@@ -183,12 +1033,10 @@ int8_t lcd_put_string(const uint8_t /* in */ ui8_str_size,
 		      const char_t * /* in */ sz_string) {
 	uint8_t ui8_idx = 0;
 	if(sz_string != (char_t *)NULL) {
-		LCD_RS = 1;	// write characters
 		while(ui8_idx < ui8_str_size) {
-			lcd_write_byte(*sz_string++);
+			lcd_put_char(*sz_string++);
 			ui8_idx ++;
 		}
-		LCD_RS = 0;
 		return RET_OK;
 	}
 	else {
@@ -205,9 +1053,12 @@ int8_t lcd_put_string(const uint8_t /* in */ ui8_str_size,
  * @return nothing
  */
 void lcd_put_char(const char_t /* in */ i8_char) {
-	LCD_RS = 1;	// write character
-	lcd_write_byte(i8_char);
-	LCD_RS = 0;
+	if((gb_flag_lcd_staging == 1) && LCD_IS_FIRST) {
+		lcd_store_data(i8_char);
+	}
+	else {
+		lcd_write_data(i8_char);
+	}
 }
 
 /**
@@ -243,12 +1094,17 @@ int8_t lcd_set_control(const uint8_t /* in */ ui8_display,
 	}
 	/* else nothing to do */
 
-	if(ui8_cursor == 1) {
+	if(ui8_blink == 1) {
 		ui8_command += 0x01;
 	}
 	/* else nothing to do */
 	
 	lcd_write_byte(ui8_command);
+	gpui8_lcd_control[LCD_SELECTED] = ui8_command;
+	if((gpui8_lcd_control[LCD_SELECTED] & LCD_CURSOR_SHOWN) != 0) {
+		lcd_sync_cursor();
+	}
+	/* else nothing to do */
 	return RET_OK;
 }
 
@@ -258,13 +1114,13 @@ int8_t lcd_set_control(const uint8_t /* in */ ui8_display,
  * @brief 
  * 
  * @param [in] ui8_row
- * @param [in] ui8_column
+ * @param [in] ui8_column	1 to 40, columns 17 to 40 are hidden 
+ *                              until the display is shifted
  * @return nothing
  */
 void lcd_set_cursor(const uint8_t /* in */ ui8_row, 
 		    const uint8_t /* in */ ui8_column) {
 	uint8_t ui8_command = 0x80;
-	LCD_RS = 0;
 	switch(ui8_row) {
 		case 1:
 			ui8_command += ui8_column - 1;
@@ -278,7 +1134,21 @@ void lcd_set_cursor(const uint8_t /* in */ ui8_row,
 			break;
 	}
 	
-	lcd_write_byte(ui8_command);
+	if((gb_flag_lcd_staging == 1) && LCD_IS_FIRST) {
+		gui8_lcd_stage_addr = ui8_command & 0x7F;
+		return;
+	}
+	/* else nothing to do */
+
+	// the set address command is delayed until the next character, it's 
+	// dropped if the address counter is already there or if the cursor
+	// is set again before
+	gpui8_lcd_cursor[LCD_SELECTED] = ui8_command & 0x7F;
+	if((gpui8_lcd_control[LCD_SELECTED] & LCD_CURSOR_SHOWN) != 0) {
+		// the cursor is visible, it must move now
+		lcd_sync_cursor();
+	}
+	/* else nothing to do */
 }
 
 /**
@@ -287,10 +1157,11 @@ void lcd_set_cursor(const uint8_t /* in */ ui8_row,
  * 
  * There is enough character RAM for up to 8 custom characters to be defined
  * The character RAM pointer will auto-incriment
+ * Every cell showing the character is updated at once.
  * 
- * @param [in] ui8_custom_char_size
- * @param [in] pi8_custom_char
- * @param [in] ui8_addr_offset
+ * @param [in] ui8_custom_char_size	number of rows (LCD_GLYPH_SIZE)
+ * @param [in] pi8_custom_char		bitmap, one byte per row
+ * @param [in] ui8_addr_offset		character code (0 to 7)
  * @return RET_NOK if an error occurs during execution otherwise
  *         RET_OK
  */ 
@@ -300,11 +1171,12 @@ int8_t lcd_define_custom_char(const uint8_t /* in */ ui8_custom_char_size,
 	uint8_t ui8_idx = 0;
 	int8_t i8_ret = 0;
 	if((ui8_custom_char_size > 0) && 
+	   (ui8_custom_char_size <= LCD_GLYPH_SIZE) && 
 	   (ui8_addr_offset < 8) && 
 	   (pi8_custom_char != (char_t *)NULL)) {
 		LCD_RS = 0;
-		// Send the Command (0x40 + address)
-		i8_ret = lcd_write_byte(0x40 + ui8_addr_offset);
+		// Send the Command (0x40 + address), 8 bytes per character
+		i8_ret = lcd_write_byte(0x40 + (ui8_addr_offset << 3));
 		if(i8_ret == RET_NOK) {
 			return RET_NOK;
 		}
@@ -314,9 +1186,10 @@ int8_t lcd_define_custom_char(const uint8_t /* in */ ui8_custom_char_size,
 		// Send the Data 
 		for (ui8_idx = 0; ui8_idx < ui8_custom_char_size; ui8_idx++) {
 			lcd_write_byte(*pi8_custom_char++);
-			__delay_ms(1);
 		}
 		LCD_RS = 0;
+		// back to the DDRAM address
+		lcd_write_byte(0x80 | gpui8_lcd_addr[LCD_SELECTED]);
 		return RET_OK;
 	}
 	else {
@@ -344,7 +1217,7 @@ int8_t load_track_conf(const uint8_t /* in */ ui8_internal_eeprom_addr,
 	   (ui8_size <= 16) &&
 	   (ui8_internal_eeprom_addr < 0xFF)) {
 		for(ui8_idx = 0; ui8_idx < ui8_size; ui8_idx ++) {
-			*pui8_data_ptr = eeprom_read(ui8_internal_eeprom_addr + ui8_idx);
+			*pui8_data_ptr = eeprom_async_read(ui8_internal_eeprom_addr + ui8_idx);
 			pui8_data_ptr ++;
 		}
 		return RET_OK;
@@ -357,14 +1230,104 @@ int8_t load_track_conf(const uint8_t /* in */ ui8_internal_eeprom_addr,
 /**
  * @fn void lcd_erase_internal_mem(void)
  * @brief Erase all the internal eeprom
+ *        (bytes already erased aren't written again)
  * @param none
  * @return nothing
  */ 
 void lcd_erase_internal_mem(void) {
 	uint8_t ui8_idx = 0;
 	for(ui8_idx = 0; ui8_idx < 255; ui8_idx++) {
-		eeprom_write(ui8_idx, 0xFF);
+		eeprom_async_write(ui8_idx, 0xFF);
+	}
+}
+
+/**
+ * @fn void lcd_save_screen(void)
+ * @brief save the visible cells and the display control in the EEPROM,
+ *        the saved screen is restored on a warm boot
+ *
+ * EEPROM : | MAGIC | CONTROL | ROW 1 (16 bytes) | ROW 2 (16 bytes) |
+ *
+ * Nothing is written if the screen hasn't changed since the last save.
+ * A cell shifted in and never written since is restored as a space.
+ * During an update the cells are saved with their new value.
+ *
+ * @param none
+ * @return nothing
+ */
+void lcd_save_screen(void) {
+	uint8_t ui8_idx = 0;
+	uint8_t ui8_changed = 0;
+
+	if((eeprom_async_read(LCD_SNAPSHOT_ADDR) != LCD_SNAPSHOT_MAGIC) ||
+	   (eeprom_async_read(LCD_SNAPSHOT_ADDR + 1) != gpui8_lcd_control[LCD_SELECTED])) {
+		ui8_changed = 1;
+	}
+	/* else nothing to do */
+
+	while((ui8_changed == 0) && (ui8_idx < LCD_SCREEN_SIZE)) {
+		if(eeprom_async_read(LCD_SNAPSHOT_ADDR + 2 + ui8_idx) != lcd_stage_value(ui8_idx)) {
+			ui8_changed = 1;
+		}
+		/* else nothing to do */
+		ui8_idx ++;
+	}
+
+	if(ui8_changed == 0) {
+		return;
 	}
+	/* else nothing to do */
+
+	// invalidate the saved screen until all bytes are written
+	eeprom_async_write(LCD_SNAPSHOT_ADDR, 0xFF);
+	eeprom_async_write(LCD_SNAPSHOT_ADDR + 1, gpui8_lcd_control[LCD_SELECTED]);
+	for(ui8_idx = 0; ui8_idx < LCD_SCREEN_SIZE; ui8_idx ++) {
+		// unchanged bytes are skipped by the write queue
+		eeprom_async_write(LCD_SNAPSHOT_ADDR + 2 + ui8_idx, lcd_stage_value(ui8_idx));
+	}
+	eeprom_async_write(LCD_SNAPSHOT_ADDR, LCD_SNAPSHOT_MAGIC);
+}
+
+/**
+ * @fn int8_t lcd_restore_screen(void)
+ * @brief restore the screen saved in the EEPROM, the cursor is set
+ *        to the top left
+ * @param none
+ * @return RET_NOK if no screen has been saved otherwise RET_OK
+ */
+int8_t lcd_restore_screen(void) {
+	uint8_t ui8_idx = 0;
+	uint8_t ui8_control = 0;
+	uint8_t ui8_value = 0;
+
+	ui8_control = eeprom_async_read(LCD_SNAPSHOT_ADDR + 1);
+	if((eeprom_async_read(LCD_SNAPSHOT_ADDR) != LCD_SNAPSHOT_MAGIC) ||
+	   ((ui8_control & 0xF8) != 0x08)) {
+		return RET_NOK;
+	}
+	/* else nothing to do */
+
+	for(ui8_idx = 0; ui8_idx < LCD_SCREEN_SIZE; ui8_idx ++) {
+		if(ui8_idx == 0) {
+			lcd_set_cursor(1, 1);
+		}
+		else if(ui8_idx == LCD_NB_COLUMNS) {
+			lcd_set_cursor(2, 1);
+		}
+		/* else nothing to do */
+		ui8_value = eeprom_async_read(LCD_SNAPSHOT_ADDR + 2 + ui8_idx);
+		if(ui8_value == LCD_CELL_UNKNOWN) {
+			ui8_value = ' ';
+		}
+		/* else nothing to do */
+		lcd_write_data(ui8_value);
+	}
+	
+	LCD_RS = 0;
+	lcd_write_byte(ui8_control);
+	gpui8_lcd_control[LCD_SELECTED] = ui8_control;
+	lcd_set_cursor(1, 1);
+	return RET_OK;
 }
 
 /**
@@ -389,7 +1352,6 @@ int8_t lcd_set_logo_m2g(void) {
 		return i8_ret;
 	}
 	/* else nothing to do */
-	__delay_ms(2500);
 	
 	//lcd_clear_display();
 	
@@ -397,15 +1359,36 @@ int8_t lcd_set_logo_m2g(void) {
 }
 
 /**
- * @fn void lcd_init(void)
+ * @fn void lcd_init_wait(const uint8_t ui8_next_state, 
+ *			  const uint16_t ui16_delay_ms)
+ * @brief go to the next step of the initialisation after a delay
+ *
+ * @param [in] ui8_next_state	next step
+ * @param [in] ui16_delay_ms	minimum delay (ms)
+ * @return nothing
+ */
+void lcd_init_wait(const uint8_t /* in */ ui8_next_state,
+		   const uint16_t /* in */ ui16_delay_ms) {
+	gui8_lcd_init_state = ui8_next_state;
+	gui16_lcd_init_start = timer_get_tick();
+	// the current tick may be nearly over
+	gui16_lcd_init_delay = (ui16_delay_ms / TIMER_TICK_MS) + 1;
+}
+
+/**
+ * @fn int8_t lcd_init(const uint8_t ui8_warm_boot)
  * @brief initialize LCD driver
  * 
- * @param none
+ * The power-on sequence is only started here, it goes on in 
+ * lcd_init_task() without blocking the main loop.
+ *
+ * @param [in] ui8_warm_boot	1 if the reset isn't a power-on reset
  * @return RET_NOK if an error occurs during execution otherwise
  *         RET_OK
  */ 
-int8_t lcd_init(void) {
+int8_t lcd_init(const uint8_t /* in */ ui8_warm_boot) {
 	int8_t i8_ret = 0;
+	uint8_t ui8_idx = 0;
 	
 	ADCON1 = 0x06;
 	// make the corresponding PORTA pin an output
@@ -416,71 +1399,142 @@ int8_t lcd_init(void) {
 	// clear all three output pins
 	LCD_RS = 0;
 	LCD_EN = 0;
-	
-	// Wait for more than 15 ms after VCC rises to 4.5 V
-	__delay_ms(15);
-	// RS R/W DB7 DB6 DB5 DB4
-	// 0   0   0   0   1   1
-	LCD_D4 = 1;
-	LCD_D5 = 1;
-	LCD_D6 = 0;
-	LCD_D7 = 0;
-	// Il faut toujours envoyer une impulsion positive d'au moins 450ns, 
-	// après la mise à l'état haut des broches DB5 et DB4, sur la broche EN.
-	LCD_EN = 1; 
-	NOP();
-	LCD_EN = 0;
-	// Wait for more than 4.1 ms
-	__delay_ms(5);
-	LCD_EN = 1;
-	NOP(); 
-	LCD_EN = 0;
-	// Wait for more than 100 μs
-	__delay_us(200);
-	LCD_EN = 1;
-	NOP(); 
-	LCD_EN = 0;
-	__delay_us(200);
-	// RS R/W DB7 DB6 DB5 DB4 
-	// 0   0   0   0   1   0  => interface four bits mode 
-	LCD_D4 = 0;
-	LCD_D5 = 1;
-	LCD_D6 = 0;
-	LCD_D7 = 0;
-	
-	LCD_EN = 1;
-	NOP();
-	LCD_EN = 0;
 
-	__delay_ms(5);
-	// => Set interface length
-	// RS R/W DB7 DB6 DB5 DB4 
-	// 0   0   0   0   1   0  
-	// 0   0   N   F   *   * 
-	lcd_write_byte(0x28);
-	// => Display On, Cursor On, Cursor Blink Off
-	// RS R/W DB7 DB6 DB5 DB4 
-	// 0   0   0   0   0   0  
-	// 0   0   1   0   0   0
-	lcd_write_byte(0x08);
-	// => Clear screen
-	// RS R/W DB7 DB6 DB5 DB4 
-	// 0   0   0   0   0   0  
-	// 0   0   0   0   0   1
-	lcd_write_byte(0x01);
-	// => Set entry Mode
-	// RS R/W DB7 DB6 DB5 DB4 
-	// 0   0   0   0   0   0  
-	// 0   0   0   1   D   S
-	lcd_write_byte(0x06);
-	// RS R/W DB7 DB6 DB5 DB4 
-	// 0   0   0   0   0   0  
-	// 0   0   1   D   C   B
-	lcd_write_byte(0x0C);
-
-	// erase display
-	lcd_clear_display();
+#ifdef LCD2_ENABLE
+	LCD2_EN = 0;
+	TRISB1 = 0;
+#endif
+	// both displays are initialised together
+	for(ui8_idx = 0; ui8_idx < LCD_NB_DISPLAYS; ui8_idx ++) {
+		gpui8_lcd_addr[ui8_idx] = 0;
+		gpui8_lcd_cursor[ui8_idx] = 0;
+		gpui8_lcd_control[ui8_idx] = LCD_CONTROL_ON;
+		gpui8_lcd_busy_wait[ui8_idx] = 0;
+	}
+	gui8_lcd_display = LCD_DISPLAY_1;
+
+	// Timer0 times the instructions : Fosc/4, prescaler 1:64
+	// (OPTION_REG is shared with the pull-ups of the port B)
+	T0CS = 0;
+	PSA = 0;
+	PS2 = 1;
+	PS1 = 0;
+	PS0 = 1;
+
+	gb_flag_lcd_warm_boot = ui8_warm_boot;
+	gui8_lcd_init_cmd = 0;
 	
-	lcd_set_logo_m2g();
+	// Wait for more than 15 ms after VCC rises to 4.5 V
+	lcd_init_wait(LCD_INIT_WAKE_UP_1, 15);
 	return i8_ret;
 }
+
+/**
+ * @fn void lcd_init_task(void)
+ * @brief go on with the power-on sequence once the delay of the 
+ *        current step has elapsed
+ *
+ * On a warm boot the logo is skipped and the saved screen is restored.
+ * Host emulator (make emu, I2C, a frame sent every ms from the reset,
+ * modelled not measured on the board) : the first address is acked
+ * after 1.2 ms in both cases, the first frame is written after 2562 ms
+ * on a power-on reset (logo) and after 73 ms on a brown-out reset, the
+ * saved screen being restored from 47 ms. Frames received meanwhile
+ * are buffered while the text lane has room, the others are dropped.
+ *
+ * @param none
+ * @return nothing
+ */ 
+void lcd_init_task(void) {
+	if((gui8_lcd_init_state == LCD_READY) ||
+	   (timer_elapsed(gui16_lcd_init_start, gui16_lcd_init_delay) == 0)) {
+		return;
+	}
+	/* else nothing to do */
+
+	switch(gui8_lcd_init_state) {
+		case LCD_INIT_WAKE_UP_1:
+			// RS R/W DB7 DB6 DB5 DB4
+			// 0   0   0   0   1   1
+			// Il faut toujours envoyer une impulsion positive d'au moins 450ns, 
+			// après la mise à l'état haut des broches DB5 et DB4, sur la broche EN.
+			lcd_write_nibble(0x03);
+			// Wait for more than 4.1 ms
+			lcd_init_wait(LCD_INIT_WAKE_UP_2, 5);
+			break;
+
+		case LCD_INIT_WAKE_UP_2:
+			lcd_write_nibble(0x03);
+			// Wait for more than 100 μs
+			lcd_init_wait(LCD_INIT_WAKE_UP_3, 1);
+			break;
+
+		case LCD_INIT_WAKE_UP_3:
+			lcd_write_nibble(0x03);
+			lcd_init_wait(LCD_INIT_4_BITS, 1);
+			break;
+
+		case LCD_INIT_4_BITS:
+			// RS R/W DB7 DB6 DB5 DB4 
+			// 0   0   0   0   1   0  => interface four bits mode 
+			lcd_write_nibble(0x02);
+			lcd_init_wait(LCD_INIT_COMMANDS, 5);
+			break;
+
+		case LCD_INIT_COMMANDS:
+			// 0x28 => Set interface length
+			// 0   0   N   F   *   * 
+			// 0x08 => Display Off
+			// 0   0   1   D   C   B
+			// 0x01 => Clear screen
+			// 0   0   0   0   0   1
+			// 0x06 => Set entry Mode
+			// 0   0   0   1   D   S
+			// 0x0C => Display On, Cursor Off, Cursor Blink Off
+			// 0   0   1   D   C   B
+			lcd_write_nibble(gpui8_lcd_init_cmd[gui8_lcd_init_cmd] >> 4);
+			lcd_write_nibble(gpui8_lcd_init_cmd[gui8_lcd_init_cmd]);
+			gui8_lcd_init_cmd ++;
+			if(gui8_lcd_init_cmd < LCD_INIT_NB_CMD) {
+				// Clear screen lasts 1.52 ms, other commands 37 μs
+				lcd_init_wait(LCD_INIT_COMMANDS, 2);
+			}
+			else {
+				lcd_init_wait(LCD_INIT_SPLASH, 1);
+			}
+			break;
+
+		case LCD_INIT_SPLASH:
+			gpui8_lcd_control[LCD_SELECTED] = LCD_CONTROL_ON;
+			lcd_reset_shadow();
+			if(gb_flag_lcd_warm_boot == 1) {
+				lcd_restore_screen();
+				gui8_lcd_init_state = LCD_READY;
+			}
+			else {
+				lcd_set_logo_m2g();
+				// keep the logo on the screen
+				lcd_init_wait(LCD_READY, LCD_LOGO_DELAY);
+			}
+			break;
+
+		default:
+			gui8_lcd_init_state = LCD_READY;
+			break;
+	}
+}
+
+/**
+ * @fn uint8_t lcd_is_ready(void)
+ * @brief indicate if the power-on sequence is over
+ * @param none
+ * @return 1 if the LCD is ready otherwise 0
+ */
+uint8_t lcd_is_ready(void) {
+	if((gui8_lcd_init_state == LCD_READY) &&
+	   (timer_elapsed(gui16_lcd_init_start, gui16_lcd_init_delay) == 1)) {
+		return 1;
+	}
+	/* else nothing to do */
+	return 0;
+}
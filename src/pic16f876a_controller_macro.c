@@ -0,0 +1,324 @@
+/*************************************************************************
+ * Projet Raspberry pi lcd controller
+ *************************************************************************
+ * File : pic16f876a_controller_macro.c
+ *************************************************************************
+ * Date : 19 Octobre 2026
+ * Author : Sinseman44
+ * Organization : Coloc's bar
+ *************************************************************************/
+
+/*
+ * Macros are sequences of frames recorded in the internal EEPROM and
+ * replayed later by a single RUN_MACRO frame.
+ *
+ * EEPROM :
+ * --------
+ *
+ *          -----------------------------------------------
+ * 0x00 ->  | Start 1 | Size 1 | Start 2 | Size 2 | ...   |  Directory
+ *          -----------------------------------------------
+ * 0x06 ->  | Frames of the macros, in any order     ... |  up to 0xDC
+ *          -----------------------------------------------
+ *
+ * Size is the number of recorded frame bytes (0xFF when the macro is
+ * empty), Start the EEPROM address of its first byte. The macros have
+ * the size of their frames (ids and sizes included) : a record goes to
+ * the largest free space between the other macros, up to the 215 bytes
+ * of the area when it is the only one. A record of no frame frees the
+ * macro.
+ * The size byte is invalidated when a record begins and only written back
+ * when it ends, so a partial record is never replayed. A directory entry
+ * out of the area (erased EEPROM, older layout) reads as an empty macro.
+ *
+ * Bytes are written through the EEPROM write queue, the decoding of 
+ * frames is not stopped during the write cycles.
+ */
+
+/*************************************************************************
+ * Inclusion(s)
+ *************************************************************************/
+
+#include "pic16f876a_controller_macro.h"
+#include "pic16f876a_controller_eeprom.h"
+
+/*************************************************************************
+ * Constante(s)/Macro(s)
+ *************************************************************************/
+
+#define MACRO_REC_IDLE			0		/*!< No record in progress */
+#define MACRO_REC_ON			1		/*!< Record in progress */
+#define MACRO_REC_OVERFLOW		2		/*!< Record too big for the free space */
+
+#define MACRO_DIR_START(id)		(MACRO_EEPROM_BASE + (2 * ((id) - 1)))	/*!< Start byte of a macro */
+#define MACRO_DIR_SIZE(id)		(MACRO_DIR_START(id) + 1)				/*!< Size byte of a macro */
+
+bank2 uint8_t gui8_macro_rec_state = 0;		/*!< Record state */
+bank2 uint8_t gui8_macro_rec_id = 0;		/*!< Macro recorded */
+bank2 uint8_t gui8_macro_rec_addr = 0;		/*!< EEPROM address of the first byte recorded */
+bank2 uint8_t gui8_macro_rec_size = 0;		/*!< Number of bytes recorded */
+bank2 uint8_t gui8_macro_rec_limit = 0;		/*!< Free space of the record */
+bank2 uint8_t gui8_macro_play_addr = 0;		/*!< Next EEPROM address to replay */
+bank2 uint8_t gui8_macro_play_end = 0;		/*!< End EEPROM address of the replay */
+
+/*************************************************************************
+ * Prototype(s)
+ *************************************************************************/
+
+/*************************************************************************
+ * Fonction(s)
+ *************************************************************************/
+
+/**
+ * @fn void macro_init(void)
+ * @brief initialise record and replay states
+ * @param none
+ * @return none
+ */
+void macro_init(void) {
+	gui8_macro_rec_state = MACRO_REC_IDLE;
+	gui8_macro_rec_id = 0;
+	gui8_macro_rec_addr = 0;
+	gui8_macro_rec_size = 0;
+	gui8_macro_rec_limit = 0;
+	gui8_macro_play_addr = 0;
+	gui8_macro_play_end = 0;
+}
+
+/**
+ * @fn int8_t macro_begin_record(const uint8_t ui8_macro_id)
+ * @brief start recording frames in a macro, at the largest free space
+ *        between the other macros
+ *
+ * @param [in] ui8_macro_id	macro (1 to MACRO_NB_SLOTS)
+ * @return RET_MACRO_NOK if the macro doesn't exist or a record is
+ *         already in progress otherwise RET_MACRO_OK
+ */
+int8_t macro_begin_record(const uint8_t /* in */ ui8_macro_id) {
+	uint8_t pui8_start[MACRO_NB_SLOTS];
+	uint8_t pui8_end[MACRO_NB_SLOTS];
+	uint8_t ui8_idx = 0;
+	uint8_t ui8_other = 0;
+	uint8_t ui8_start = 0;
+	uint8_t ui8_room = 0;
+	uint8_t ui8_size = 0;
+
+	if((ui8_macro_id == 0) || 
+	   (ui8_macro_id > MACRO_NB_SLOTS) ||
+	   (gui8_macro_rec_state != MACRO_REC_IDLE)) {
+		return RET_MACRO_NOK;
+	}
+	/* else nothing to do */
+
+	// invalidate the macro until the end of the record
+	eeprom_async_write(MACRO_DIR_SIZE(ui8_macro_id), MACRO_EMPTY);
+
+	// space used by the other macros (end 0 : none)
+	for(ui8_idx = 0; ui8_idx < MACRO_NB_SLOTS; ui8_idx ++) {
+		pui8_start[ui8_idx] = eeprom_async_read(MACRO_DIR_START(ui8_idx + 1));
+		ui8_size = eeprom_async_read(MACRO_DIR_SIZE(ui8_idx + 1));
+		pui8_end[ui8_idx] = 0;
+		if((ui8_size != 0) &&
+		   (ui8_size != MACRO_EMPTY) &&
+		   (pui8_start[ui8_idx] >= MACRO_DATA_BASE) &&
+		   (pui8_start[ui8_idx] < MACRO_DATA_END) &&
+		   (ui8_size <= (MACRO_DATA_END - pui8_start[ui8_idx]))) {
+			pui8_end[ui8_idx] = pui8_start[ui8_idx] + ui8_size;
+		}
+		/* else empty macro */
+	}
+
+	// free space from the start of the area or the end of a macro up to
+	// the next macro, the largest one is recorded
+	gui8_macro_rec_addr = MACRO_DATA_BASE;
+	gui8_macro_rec_limit = 0;
+	for(ui8_idx = 0; ui8_idx <= MACRO_NB_SLOTS; ui8_idx ++) {
+		ui8_start = MACRO_DATA_BASE;
+		if(ui8_idx < MACRO_NB_SLOTS) {
+			ui8_start = pui8_end[ui8_idx];
+		}
+		/* else start of the area */
+
+		ui8_room = 0;
+		if(ui8_start != 0) {
+			ui8_room = MACRO_DATA_END - ui8_start;
+		}
+		/* else empty macro */
+		for(ui8_other = 0; ui8_other < MACRO_NB_SLOTS; ui8_other ++) {
+			if(pui8_end[ui8_other] == 0) {
+				// empty macro
+			}
+			else if(pui8_start[ui8_other] >= ui8_start) {
+				if((pui8_start[ui8_other] - ui8_start) < ui8_room) {
+					ui8_room = pui8_start[ui8_other] - ui8_start;
+				}
+				/* else nothing to do */
+			}
+			else if(pui8_end[ui8_other] > ui8_start) {
+				// inside an other macro
+				ui8_room = 0;
+			}
+			/* else nothing to do */
+		}
+
+		if(ui8_room > gui8_macro_rec_limit) {
+			gui8_macro_rec_addr = ui8_start;
+			gui8_macro_rec_limit = ui8_room;
+		}
+		/* else nothing to do */
+	}
+
+	gui8_macro_rec_id = ui8_macro_id;
+	gui8_macro_rec_size = 0;
+	gui8_macro_rec_state = MACRO_REC_ON;
+	eeprom_async_write(MACRO_DIR_START(ui8_macro_id), gui8_macro_rec_addr);
+	return RET_MACRO_OK;
+}
+
+/**
+ * @fn int8_t macro_record_byte(const uint8_t ui8_value)
+ * @brief save a frame byte in the macro being recorded
+ *
+ * @param [in] ui8_value	frame byte to save
+ * @return RET_MACRO_NOK if no record is in progress or the free space
+ *         is full otherwise RET_MACRO_OK
+ */
+int8_t macro_record_byte(const uint8_t /* in */ ui8_value) {
+	if(gui8_macro_rec_state != MACRO_REC_ON) {
+		return RET_MACRO_NOK;
+	}
+	/* else nothing to do */
+
+	if(gui8_macro_rec_size >= gui8_macro_rec_limit) {
+		// the record will be dropped at the end
+		gui8_macro_rec_state = MACRO_REC_OVERFLOW;
+		return RET_MACRO_NOK;
+	}
+	/* else nothing to do */
+
+	eeprom_async_write(gui8_macro_rec_addr + gui8_macro_rec_size, ui8_value);
+	gui8_macro_rec_size ++;
+	return RET_MACRO_OK;
+}
+
+/**
+ * @fn int8_t macro_end_record(void)
+ * @brief close the macro being recorded
+ *
+ * @param none
+ * @return RET_MACRO_NOK if no record is in progress, RET_MACRO_FULL if
+ *         the record has overflowed the free space (the macro stays 
+ *         empty) otherwise RET_MACRO_OK
+ */
+int8_t macro_end_record(void) {
+	int8_t i8_ret = RET_MACRO_OK;
+
+	if(gui8_macro_rec_state == MACRO_REC_ON) {
+		eeprom_async_write(MACRO_DIR_SIZE(gui8_macro_rec_id), gui8_macro_rec_size);
+	}
+	else if(gui8_macro_rec_state == MACRO_REC_OVERFLOW) {
+		i8_ret = RET_MACRO_FULL;
+	}
+	else {
+		i8_ret = RET_MACRO_NOK;
+	}
+
+	gui8_macro_rec_state = MACRO_REC_IDLE;
+	return i8_ret;
+}
+
+/**
+ * @fn uint8_t macro_is_recording(void)
+ * @brief indicate if frames have to be recorded instead of executed
+ * @param none
+ * @return 1 if a record is in progress otherwise 0
+ */
+uint8_t macro_is_recording(void) {
+	if(gui8_macro_rec_state != MACRO_REC_IDLE) {
+		return 1;
+	}
+	/* else nothing to do */
+	return 0;
+}
+
+/**
+ * @fn int8_t macro_play(const uint8_t ui8_macro_id)
+ * @brief prepare the replay of a macro
+ *
+ * @param [in] ui8_macro_id	macro (1 to MACRO_NB_SLOTS)
+ * @return RET_MACRO_NOK if the macro doesn't exist, RET_MACRO_EMPTY if 
+ *         nothing has been recorded in the macro otherwise RET_MACRO_OK
+ */
+int8_t macro_play(const uint8_t /* in */ ui8_macro_id) {
+	uint8_t ui8_addr = 0;
+	uint8_t ui8_size = 0;
+
+	if((ui8_macro_id == 0) || (ui8_macro_id > MACRO_NB_SLOTS)) {
+		return RET_MACRO_NOK;
+	}
+	/* else nothing to do */
+
+	ui8_addr = eeprom_async_read(MACRO_DIR_START(ui8_macro_id));
+	ui8_size = eeprom_async_read(MACRO_DIR_SIZE(ui8_macro_id));
+	if((ui8_size == 0) || 
+	   (ui8_size == MACRO_EMPTY) ||
+	   (ui8_addr < MACRO_DATA_BASE) ||
+	   (ui8_addr >= MACRO_DATA_END) ||
+	   (ui8_size > (MACRO_DATA_END - ui8_addr))) {
+		return RET_MACRO_EMPTY;
+	}
+	/* else nothing to do */
+
+	gui8_macro_play_addr = ui8_addr;
+	gui8_macro_play_end = ui8_addr + ui8_size;
+	return RET_MACRO_OK;
+}
+
+/**
+ * @fn void macro_stop(void)
+ * @brief abort the current replay
+ * @param none
+ * @return none
+ */
+void macro_stop(void) {
+	gui8_macro_play_addr = gui8_macro_play_end;
+}
+
+/**
+ * @fn int8_t macro_get(uint8_t * const pui8_value)
+ * @brief get the next byte of the macro being replayed
+ *
+ * @param [out] pui8_value
+ * @return RET_MACRO_NOK if an error occurs
+ * 		   RET_MACRO_EMPTY if the end of the macro is reached
+ * 		   RET_MACRO_OK otherwise
+ */
+int8_t macro_get(uint8_t * /* out */ const pui8_value) {
+	if(pui8_value == (uint8_t *)NULL) {
+		return RET_MACRO_NOK;
+	}
+	/* else nothing to do */
+
+	if(gui8_macro_play_addr == gui8_macro_play_end) {
+		return RET_MACRO_EMPTY;
+	}
+	/* else nothing to do */
+
+	*(pui8_value) = eeprom_async_read(gui8_macro_play_addr);
+	gui8_macro_play_addr ++;
+	return RET_MACRO_OK;
+}
+
+/**
+ * @fn uint8_t macro_is_playing(void)
+ * @brief indicate if bytes remain in the macro being replayed
+ * @param none
+ * @return 1 if a replay is in progress otherwise 0
+ */
+uint8_t macro_is_playing(void) {
+	if(gui8_macro_play_addr != gui8_macro_play_end) {
+		return 1;
+	}
+	/* else nothing to do */
+	return 0;
+}
@@ -0,0 +1,161 @@
+/*************************************************************************
+ * Projet Raspberry pi lcd controller
+ *************************************************************************
+ * File : pic16f876a_controller_marquee.c
+ *************************************************************************
+ * Date : 19 Octobre 2026
+ * Author : Sinseman44
+ * Organization : Coloc's bar
+ *************************************************************************/
+
+/*
+ * Marquee :
+ * ---------
+ * A text longer than the screen is kept in RAM and scrolled across a row
+ * by the tick, without any frame from the master. The text loops :
+ *
+ *   text  : | M | E | S | S | A | G | E | ... | (size characters)
+ *                   <----- 16 columns ----->
+ *   step n      :   visible from text[n]
+ *   step n + 1  :   visible from text[n + 1]
+ *
+ * At each step only the cells whose character changes are written, the
+ * display shift can't be used since it would move both rows.
+ */
+
+/*************************************************************************
+ * Inclusion(s)
+ *************************************************************************/
+
+#include "pic16f876a_controller_marquee.h"
+#include "pic16f876a_controller_lcd.h"
+#include "pic16f876a_controller_timer.h"
+
+/*************************************************************************
+ * Constante(s)/Macro(s)
+ *************************************************************************/
+
+#define MARQUEE_UNIT			10		/*!< Unit of the period (ms) */
+
+bank3 uint8_t gpui8_marquee_text[MARQUEE_MAX_SIZE];	/*!< Text of the marquee */
+bank2 uint8_t gui8_marquee_size = 0;					/*!< Text size */
+bank2 uint8_t gui8_marquee_row = 0;					/*!< Row of the marquee */
+bank2 uint8_t gui8_marquee_period = 0;				/*!< Step period (0 : stopped) */
+bank2 uint8_t gui8_marquee_pos = 0;					/*!< Text index of the first column */
+bank2 uint16_t gui16_marquee_start = 0;				/*!< Tick of the last step */
+
+/*************************************************************************
+ * Prototype(s)
+ *************************************************************************/
+
+/*************************************************************************
+ * Fonction(s)
+ *************************************************************************/
+
+/**
+ * @fn void marquee_init(void)
+ * @brief stop the marquee
+ * @param none
+ * @return none
+ */
+void marquee_init(void) {
+	gui8_marquee_size = 0;
+	gui8_marquee_row = 0;
+	gui8_marquee_period = 0;
+	gui8_marquee_pos = 0;
+}
+
+/**
+ * @fn int8_t marquee_put(const uint8_t ui8_offset, const uint8_t ui8_value)
+ * @brief save a character of the text
+ *
+ * @param [in] ui8_offset	index of the character in the text
+ * @param [in] ui8_value	character
+ * @return RET_NOK if the text is too long otherwise RET_OK
+ */
+int8_t marquee_put(const uint8_t /* in */ ui8_offset,
+		   const uint8_t /* in */ ui8_value) {
+	if(ui8_offset >= MARQUEE_MAX_SIZE) {
+		return RET_NOK;
+	}
+	/* else nothing to do */
+
+	gpui8_marquee_text[ui8_offset] = ui8_value;
+	return RET_OK;
+}
+
+/**
+ * @fn int8_t marquee_start(const uint8_t ui8_row,
+ *			    const uint8_t ui8_period,
+ *			    const uint8_t ui8_size)
+ * @brief start (or stop) scrolling the text across a row
+ *
+ * @param [in] ui8_row		row of the marquee (1 to 2)
+ * @param [in] ui8_period	time between steps (10 ms unit), 0 stops
+ * @param [in] ui8_size		text size
+ * @return RET_NOK if a parameter is invalid otherwise RET_OK
+ */
+int8_t marquee_start(const uint8_t /* in */ ui8_row,
+		     const uint8_t /* in */ ui8_period,
+		     const uint8_t /* in */ ui8_size) {
+	if((ui8_row == 0) || 
+	   (ui8_row > LCD_NB_ROWS) ||
+	   (ui8_size == 0) ||
+	   (ui8_size > MARQUEE_MAX_SIZE)) {
+		gui8_marquee_period = 0;
+		return RET_NOK;
+	}
+	/* else nothing to do */
+
+	gui8_marquee_row = ui8_row;
+	gui8_marquee_size = ui8_size;
+	gui8_marquee_period = ui8_period;
+	if(gui8_marquee_pos >= ui8_size) {
+		gui8_marquee_pos = 0;
+	}
+	/* else nothing to do */
+
+	// first step now
+	gui16_marquee_start = timer_get_tick() - ((uint16_t)ui8_period * MARQUEE_UNIT);
+	return RET_OK;
+}
+
+/**
+ * @fn void marquee_task(void)
+ * @brief do the next step of the marquee
+ * @param none
+ * @return none
+ */
+void marquee_task(void) {
+	uint8_t ui8_column = 0;
+	uint8_t ui8_idx = 0;
+	uint8_t ui8_cell = 0;
+
+	if((gui8_marquee_period == 0) ||
+	   (timer_elapsed(gui16_marquee_start, 
+			  (uint16_t)gui8_marquee_period * MARQUEE_UNIT) == 0)) {
+		return;
+	}
+	/* else nothing to do */
+
+	gui16_marquee_start += (uint16_t)gui8_marquee_period * MARQUEE_UNIT;
+
+	ui8_idx = gui8_marquee_pos;
+	ui8_cell = (gui8_marquee_row - 1) * LCD_NB_COLUMNS;
+	for(ui8_column = 0; ui8_column < LCD_NB_COLUMNS; ui8_column ++) {
+		// only written if the cell changes
+		lcd_write_cell(ui8_cell, gpui8_marquee_text[ui8_idx]);
+		ui8_cell ++;
+		ui8_idx ++;
+		if(ui8_idx == gui8_marquee_size) {
+			ui8_idx = 0;
+		}
+		/* else nothing to do */
+	}
+
+	gui8_marquee_pos ++;
+	if(gui8_marquee_pos == gui8_marquee_size) {
+		gui8_marquee_pos = 0;
+	}
+	/* else nothing to do */
+}
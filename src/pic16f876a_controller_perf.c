@@ -0,0 +1,257 @@
+/*************************************************************************
+ * Projet Raspberry pi lcd controller
+ *************************************************************************
+ * File : pic16f876a_controller_perf.c
+ *************************************************************************
+ * Date : 19 Octobre 2026
+ * Author : Sinseman44
+ * Organization : Coloc's bar
+ *************************************************************************/
+
+/*
+ * Performance counters :
+ * ----------------------
+ * Timer1 runs freely at 1 us per count, the longest interrupt and the
+ * longest frame decoding are measured with it (up to 65 ms). 
+ *
+ * The counters of frames received per id are 8 bits and wrap, the master
+ * reads them periodically and computes the differences. The other 
+ * counters saturate.
+ *
+ * Each counter is only written by one context : the reception counters 
+ * by the interrupt, the decoding counters by the main loop (under di() 
+ * since they are 16 bits and read by the interrupt).
+ */
+
+/*************************************************************************
+ * Inclusion(s)
+ *************************************************************************/
+
+#include "pic16f876a_controller_perf.h"
+#include "pic16f876a_controller_frame.h"
+
+/*************************************************************************
+ * Constante(s)/Macro(s)
+ *************************************************************************/
+
+#define PERF_HEADER_SIZE	12		/*!< Bytes before the counters per id */
+
+// read Timer1 without interrupting it (TMR1L may overflow between reads)
+#define PERF_READ_TIMER(ui16_time)						\
+	do {										\
+		(ui16_time) = TMR1H;						\
+		(ui16_time) = ((ui16_time) << 8) | TMR1L;	\
+	} while((uint8_t)((ui16_time) >> 8) != TMR1H)
+
+bank1 uint8_t gpui8_perf_received[FRAME_ID_LAST];	/*!< Frames received per id */
+bank2 uint16_t gui16_perf_executed = 0;			/*!< Frames decoded */
+bank0 uint16_t gui16_perf_dropped = 0;			/*!< Bytes received and dropped */
+bank0 uint8_t gui8_perf_overflow = 0;				/*!< SSPOV or OERR occurrences */
+bank0 uint16_t gui16_perf_isr_start = 0;			/*!< Timer1 at the interrupt entry */
+bank0 uint16_t gui16_perf_isr_max = 0;			/*!< Longest interrupt (us) */
+uint16_t gui16_perf_decode_start = 0;		/*!< Timer1 at the decoding start */
+bank2 uint16_t gui16_perf_decode_max = 0;			/*!< Longest frame decoding (us) */
+bank2 uint8_t gui8_perf_decode_id = 0;			/*!< Frame id of the longest one */
+
+/*************************************************************************
+ * Prototype(s)
+ *************************************************************************/
+
+/*************************************************************************
+ * Fonction(s)
+ *************************************************************************/
+
+/**
+ * @fn void perf_init(void)
+ * @brief start Timer1 and reset the counters
+ * @param none
+ * @return none
+ */
+void perf_init(void) {
+	TMR1H = 0;
+	TMR1L = 0;
+	T1CON = PERF_T1CON;
+	perf_reset();
+}
+
+/**
+ * @fn void perf_reset(void)
+ * @brief reset the counters and the high-water marks of the lanes
+ * @param none
+ * @return none
+ */
+void perf_reset(void) {
+	uint8_t ui8_idx = 0;
+
+	di();
+	for(ui8_idx = 0; ui8_idx < FRAME_ID_LAST; ui8_idx ++) {
+		gpui8_perf_received[ui8_idx] = 0;
+	}
+	gui16_perf_executed = 0;
+	gui16_perf_dropped = 0;
+	gui8_perf_overflow = 0;
+	gui16_perf_isr_max = 0;
+	gui16_perf_decode_max = 0;
+	gui8_perf_decode_id = 0;
+	fifo_clear_hwm();
+	ei();
+}
+
+/**
+ * @fn void perf_isr_begin(void)
+ * @brief save the time of the interrupt entry (only called from the
+ *        interrupt)
+ * @param none
+ * @return none
+ */
+void perf_isr_begin(void) {
+	PERF_READ_TIMER(gui16_perf_isr_start);
+}
+
+/**
+ * @fn void perf_isr_end(void)
+ * @brief keep the duration of the longest interrupt (only called from 
+ *        the interrupt)
+ * @param none
+ * @return none
+ */
+void perf_isr_end(void) {
+	uint16_t ui16_time = 0;
+
+	PERF_READ_TIMER(ui16_time);
+	ui16_time -= gui16_perf_isr_start;
+	if(ui16_time > gui16_perf_isr_max) {
+		gui16_perf_isr_max = ui16_time;
+	}
+	/* else nothing to do */
+}
+
+/**
+ * @fn void perf_isr_frame(const uint8_t ui8_frame_id)
+ * @brief count a frame received (only called from the interrupt)
+ * @param [in] ui8_frame_id	frame identifier, display bits included
+ * @return none
+ */
+void perf_isr_frame(const uint8_t /* in */ ui8_frame_id) {
+	uint8_t ui8_idx = (ui8_frame_id & FRAME_ID_MASK) - 1;
+
+	if(ui8_idx < FRAME_ID_LAST) {
+		gpui8_perf_received[ui8_idx] ++;
+	}
+	/* else nothing to do */
+}
+
+/**
+ * @fn void perf_isr_drop(const uint8_t ui8_nb_bytes)
+ * @brief count bytes received and dropped (only called from the 
+ *        interrupt)
+ * @param [in] ui8_nb_bytes	number of bytes dropped
+ * @return none
+ */
+void perf_isr_drop(const uint8_t /* in */ ui8_nb_bytes) {
+	if(gui16_perf_dropped < (0xFFFF - ui8_nb_bytes)) {
+		gui16_perf_dropped += ui8_nb_bytes;
+	}
+	else {
+		gui16_perf_dropped = 0xFFFF;
+	}
+}
+
+/**
+ * @fn void perf_isr_overflow(void)
+ * @brief count a reception overflow of the I2C module (only called from
+ *        the interrupt)
+ * @param none
+ * @return none
+ */
+void perf_isr_overflow(void) {
+	if(gui8_perf_overflow != 0xFF) {
+		gui8_perf_overflow ++;
+	}
+	/* else nothing to do */
+}
+
+/**
+ * @fn void perf_decode_begin(void)
+ * @brief save the time of the decoding start
+ * @param none
+ * @return none
+ */
+void perf_decode_begin(void) {
+	PERF_READ_TIMER(gui16_perf_decode_start);
+}
+
+/**
+ * @fn void perf_decode_end(const uint8_t ui8_frame_id)
+ * @brief count a frame decoded and keep the duration of the longest one
+ * @param [in] ui8_frame_id	frame identifier
+ * @return none
+ */
+void perf_decode_end(const uint8_t /* in */ ui8_frame_id) {
+	uint16_t ui16_time = 0;
+
+	PERF_READ_TIMER(ui16_time);
+	ui16_time -= gui16_perf_decode_start;
+
+	di();
+	if(gui16_perf_executed != 0xFFFF) {
+		gui16_perf_executed ++;
+	}
+	/* else nothing to do */
+	if(ui16_time > gui16_perf_decode_max) {
+		gui16_perf_decode_max = ui16_time;
+		gui8_perf_decode_id = ui8_frame_id;
+	}
+	/* else nothing to do */
+	ei();
+}
+
+/**
+ * @fn uint8_t perf_read_byte(const uint8_t ui8_idx)
+ * @brief retrieve a byte of the counters page (only called from the 
+ *        interrupt)
+ *
+ * | Dropped LSB | Dropped MSB | SSPOV | Hwm control | Hwm text |
+ * | Decode max LSB | Decode max MSB | Decode max id | ISR max LSB |
+ * | ISR max MSB | Executed LSB | Executed MSB | Received id 1 | ... |
+ *
+ * @param [in] ui8_idx	index of the byte
+ * @return byte to send
+ */
+uint8_t perf_read_byte(const uint8_t /* in */ ui8_idx) {
+	switch(ui8_idx) {
+		case 0:
+			return (uint8_t)gui16_perf_dropped;
+		case 1:
+			return (uint8_t)(gui16_perf_dropped >> 8);
+		case 2:
+			return gui8_perf_overflow;
+		case 3:
+			return fifo_read_hwm(FIFO_LANE_HIGH);
+		case 4:
+			return fifo_read_hwm(FIFO_LANE_BULK);
+		case 5:
+			return (uint8_t)gui16_perf_decode_max;
+		case 6:
+			return (uint8_t)(gui16_perf_decode_max >> 8);
+		case 7:
+			return gui8_perf_decode_id;
+		case 8:
+			return (uint8_t)gui16_perf_isr_max;
+		case 9:
+			return (uint8_t)(gui16_perf_isr_max >> 8);
+		case 10:
+			return (uint8_t)gui16_perf_executed;
+		case 11:
+			return (uint8_t)(gui16_perf_executed >> 8);
+		default:
+			break;
+	}
+
+	if(ui8_idx < (PERF_HEADER_SIZE + FRAME_ID_LAST)) {
+		return gpui8_perf_received[ui8_idx - PERF_HEADER_SIZE];
+	}
+	/* else nothing to do */
+
+	return 0;
+}
@@ -0,0 +1,228 @@
+/*************************************************************************
+ * Projet Raspberry pi lcd controller
+ *************************************************************************
+ * File : pic16f876a_controller_schedule.c
+ *************************************************************************
+ * Date : 19 Octobre 2026
+ * Author : Sinseman44
+ * Organization : Coloc's bar
+ *************************************************************************/
+
+/*
+ * Scheduled frames :
+ * ------------------
+ * Frames received ahead of time are kept in RAM, sorted by deadline, and
+ * decoded when the deadline is reached.
+ *
+ *          ------------------------------------------------//-----
+ * queue :  | Deadline LSB | Deadline MSB | Size | Frame | Deadline ...
+ *          ------------------------------------------------//-----
+ *            first frame due                      next one
+ *
+ * Time :
+ * ------
+ * The master time is the tick counter (1 ms) plus an offset set by the 
+ * master (SET_TICK frame), the tick itself is never changed so the 
+ * timed tasks aren't disturbed. Deadlines are converted to ticks when
+ * they are received and must be less than 32 s ahead.
+ */
+
+/*************************************************************************
+ * Inclusion(s)
+ *************************************************************************/
+
+#include "pic16f876a_controller_schedule.h"
+#include "pic16f876a_controller_timer.h"
+
+/*************************************************************************
+ * Constante(s)/Macro(s)
+ *************************************************************************/
+
+#define SCHEDULE_HEADER_SIZE	3		/*!< Deadline and size bytes */
+
+bank3 uint8_t gpui8_schedule_buffer[SCHEDULE_BUFFER_SIZE];	/*!< Queued frames */
+bank3 uint8_t gui8_schedule_used = 0;					/*!< Bytes used in the queue */
+bank3 uint8_t gui8_schedule_wr = 0;					/*!< Next byte written */
+bank3 uint8_t gui8_schedule_wr_end = 0;				/*!< End of the frame written */
+bank3 uint8_t gui8_schedule_rd = 0;					/*!< Next byte of the due frame */
+uint16_t gui16_schedule_offset = 0;				/*!< Master time - tick */
+
+/*************************************************************************
+ * Prototype(s)
+ *************************************************************************/
+
+uint16_t schedule_deadline(const uint8_t /* in */ ui8_pos);
+
+/*************************************************************************
+ * Fonction(s)
+ *************************************************************************/
+
+/**
+ * @fn void schedule_init(void)
+ * @brief empty the queue
+ * @param none
+ * @return none
+ */
+void schedule_init(void) {
+	gui8_schedule_used = 0;
+	gui8_schedule_wr = 0;
+	gui8_schedule_wr_end = 0;
+	gui8_schedule_rd = SCHEDULE_HEADER_SIZE;
+}
+
+/**
+ * @fn void schedule_set_time(const uint16_t ui16_time)
+ * @brief synchronise the master time
+ *
+ * @param [in] ui16_time	current master time (ms)
+ * @return none
+ */
+void schedule_set_time(const uint16_t /* in */ ui16_time) {
+	di();
+	gui16_schedule_offset = ui16_time - gui16_timer_tick;
+	ei();
+}
+
+/**
+ * @fn uint16_t schedule_deadline(const uint8_t ui8_pos)
+ * @brief retrieve the deadline (tick) of a queued frame
+ *
+ * @param [in] ui8_pos	position of the frame in the queue
+ * @return deadline
+ */
+uint16_t schedule_deadline(const uint8_t /* in */ ui8_pos) {
+	return (uint16_t)gpui8_schedule_buffer[ui8_pos] | 
+	       ((uint16_t)gpui8_schedule_buffer[ui8_pos + 1] << 8);
+}
+
+/**
+ * @fn int8_t schedule_open(const uint16_t ui16_deadline,
+ *			    const uint8_t ui8_size)
+ * @brief insert a frame in the queue, its bytes are given by schedule_put
+ *
+ * @param [in] ui16_deadline	master time of the execution (ms)
+ * @param [in] ui8_size		frame size
+ * @return RET_SCHEDULE_NOK if the queue is full otherwise RET_SCHEDULE_OK
+ */
+int8_t schedule_open(const uint16_t /* in */ ui16_deadline,
+		     const uint8_t /* in */ ui8_size) {
+	uint16_t ui16_tick = ui16_deadline - gui16_schedule_offset;
+	uint8_t ui8_pos = 0;
+	uint8_t ui8_idx = 0;
+	uint8_t ui8_length = ui8_size + SCHEDULE_HEADER_SIZE;
+
+	gui8_schedule_wr = 0;
+	gui8_schedule_wr_end = 0;
+	if((ui8_size == 0) || 
+	   (ui8_length > (SCHEDULE_BUFFER_SIZE - gui8_schedule_used))) {
+		return RET_SCHEDULE_NOK;
+	}
+	/* else nothing to do */
+
+	// after the frames with the same or an earlier deadline
+	while((ui8_pos < gui8_schedule_used) &&
+	      ((int16_t)(ui16_tick - schedule_deadline(ui8_pos)) >= 0)) {
+		ui8_pos += gpui8_schedule_buffer[ui8_pos + 2] + SCHEDULE_HEADER_SIZE;
+	}
+
+	// make room for the frame
+	for(ui8_idx = gui8_schedule_used; ui8_idx > ui8_pos; ui8_idx --) {
+		gpui8_schedule_buffer[ui8_idx - 1 + ui8_length] = gpui8_schedule_buffer[ui8_idx - 1];
+	}
+	gui8_schedule_used += ui8_length;
+
+	gpui8_schedule_buffer[ui8_pos] = (uint8_t)ui16_tick;
+	gpui8_schedule_buffer[ui8_pos + 1] = (uint8_t)(ui16_tick >> 8);
+	gpui8_schedule_buffer[ui8_pos + 2] = ui8_size;
+	gui8_schedule_wr = ui8_pos + SCHEDULE_HEADER_SIZE;
+	gui8_schedule_wr_end = gui8_schedule_wr + ui8_size;
+	return RET_SCHEDULE_OK;
+}
+
+/**
+ * @fn int8_t schedule_put(const uint8_t ui8_value)
+ * @brief save the next byte of the frame inserted
+ *
+ * @param [in] ui8_value
+ * @return RET_SCHEDULE_NOK if no frame is inserted or if it's complete
+ *         otherwise RET_SCHEDULE_OK
+ */
+int8_t schedule_put(const uint8_t /* in */ ui8_value) {
+	if(gui8_schedule_wr == gui8_schedule_wr_end) {
+		return RET_SCHEDULE_NOK;
+	}
+	/* else nothing to do */
+
+	gpui8_schedule_buffer[gui8_schedule_wr] = ui8_value;
+	gui8_schedule_wr ++;
+	return RET_SCHEDULE_OK;
+}
+
+/**
+ * @fn uint8_t schedule_is_due(void)
+ * @brief indicate if the first frame of the queue must be executed
+ * @param none
+ * @return 1 if the deadline is reached otherwise 0
+ */
+uint8_t schedule_is_due(void) {
+	if(gui8_schedule_used == 0) {
+		return 0;
+	}
+	/* else nothing to do */
+
+	if((int16_t)(timer_get_tick() - schedule_deadline(0)) >= 0) {
+		return 1;
+	}
+	/* else nothing to do */
+
+	return 0;
+}
+
+/**
+ * @fn int8_t schedule_get(uint8_t * const pui8_value)
+ * @brief get the next byte of the frame due
+ *
+ * @param [out] pui8_value
+ * @return RET_SCHEDULE_NOK if an error occurs
+ * 		   RET_SCHEDULE_EMPTY if the end of the frame is reached
+ * 		   RET_SCHEDULE_OK otherwise
+ */
+int8_t schedule_get(uint8_t * /* out */ const pui8_value) {
+	if(pui8_value == (uint8_t *)NULL) {
+		return RET_SCHEDULE_NOK;
+	}
+	/* else nothing to do */
+
+	if((gui8_schedule_used == 0) ||
+	   (gui8_schedule_rd >= (gpui8_schedule_buffer[2] + SCHEDULE_HEADER_SIZE))) {
+		return RET_SCHEDULE_EMPTY;
+	}
+	/* else nothing to do */
+
+	*(pui8_value) = gpui8_schedule_buffer[gui8_schedule_rd];
+	gui8_schedule_rd ++;
+	return RET_SCHEDULE_OK;
+}
+
+/**
+ * @fn void schedule_pop(void)
+ * @brief remove the frame due from the queue
+ * @param none
+ * @return none
+ */
+void schedule_pop(void) {
+	uint8_t ui8_idx = 0;
+	uint8_t ui8_length = 0;
+
+	if(gui8_schedule_used == 0) {
+		return;
+	}
+	/* else nothing to do */
+
+	ui8_length = gpui8_schedule_buffer[2] + SCHEDULE_HEADER_SIZE;
+	for(ui8_idx = ui8_length; ui8_idx < gui8_schedule_used; ui8_idx ++) {
+		gpui8_schedule_buffer[ui8_idx - ui8_length] = gpui8_schedule_buffer[ui8_idx];
+	}
+	gui8_schedule_used -= ui8_length;
+	gui8_schedule_rd = SCHEDULE_HEADER_SIZE;
+}
@@ -0,0 +1,121 @@
+/*************************************************************************
+ * Projet Raspberry pi lcd controller
+ *************************************************************************
+ * File : pic16f876a_controller_spi.c
+ *************************************************************************
+ * Date : 19 Octobre 2026
+ * Author : Sinseman44
+ * Organization : Coloc's bar
+ *************************************************************************/
+
+/*
+ * SPI transport :
+ * ---------------
+ * SPI slave, mode 1 (clock idle low, data sampled on the falling edge), 
+ * MSB first, receive only. SCK on RC3, SDI on RC4, SDO on RC5 isn't used
+ * and stays an input (the LED of the other transports isn't fitted).
+ *
+ * The /SS pin (RA5) drives the LCD, the framing line is RB0/INT : the 
+ * master pulls it low before the first byte of a transfer, the bit 
+ * counter of the MSSP is reset and a new frame starts as after an I2C
+ * address. The master waits for the interrupt between the falling edge
+ * and the first clock, an interrupt already running delays it.
+ *
+ * Each byte is read by the interrupt : the SCK high and low times must
+ * be over Tcy + 20 ns (960 kHz at 8 MHz) but the master leaves the time
+ * of the interrupt between two bytes (see 'make cycles'), an overrun is 
+ * counted as an SSPOV. The gap and not the clock sets the rate, with the
+ * host emulator ('make bench TRANSPORT=spi', modelled and not measured
+ * on the board) :
+ *  - 250 kHz : gap 100 us, setup 50 us, 158 frames/s,
+ *  - 500 kHz : gap 150 us, setup 50 us, 169 frames/s,
+ *  - 960 kHz : gap 150 us, setup 50 us, 160 frames/s,
+ * for full rows (18 bytes) with a pause of 3 to 4 ms between frames.
+ */
+
+/*************************************************************************
+ * Inclusion(s)
+ *************************************************************************/
+
+#include "pic16f876a_controller_spi.h"
+#include "pic16f876a_controller_frame.h"
+#include "pic16f876a_controller_perf.h"
+
+/*************************************************************************
+ * Constante(s)/Macro(s)
+ *************************************************************************/
+
+#define SPI_SSPSTAT		0x00	/*!< SMP = 0 (slave), CKE = 0 */
+#define SPI_SSPCON		0x05	/*!< CKP = 0, SPI slave, /SS disabled */
+
+/*************************************************************************
+ * Prototype(s)
+ *************************************************************************/
+
+/*************************************************************************
+ * Fonction(s)
+ *************************************************************************/
+
+/**
+ * @fn void spi_init(void)
+ * @brief initialise the MSSP in SPI slave mode and the framing line
+ * @param none
+ * @return none
+ */
+void spi_init(void) {
+	// Synchronous Serial Port Disable bit
+	SSPEN = 0;
+
+	// SCK and SDI are inputs, SDO isn't driven
+	TRISC3 = 1;
+	TRISC4 = 1;
+	TRISC5 = 1;
+
+	SSPSTAT = SPI_SSPSTAT;
+	SSPCON = SPI_SSPCON;
+
+	// Synchronous Serial Port Enable bit
+	SSPEN = 1;
+
+	// framing line : interrupt on the falling edge of RB0
+	TRISB0 = 1;
+	INTEDG = 0;
+	INTF = 0;
+	INTE = 1;
+
+	// enable SSP interrupt
+	SSPIF = 0;
+	SSPIE = 1;
+}
+
+/**
+ * @fn void spi_isr(void)
+ * @brief start a frame on the framing line and give the bytes received
+ *        to the frame layer (only called from the interrupt)
+ * @param none
+ * @return none
+ */
+void spi_isr(void) {
+	uint8_t ui8_value = 0;
+
+	if(INTF == 1) {
+		INTF = 0; // Reset IRQ flag
+		// restart the bit counter of the shift register
+		SSPEN = 0;
+		SSPEN = 1;
+		frame_receive_start();
+	}
+	/* else nothing to do */
+
+	if(SSPIF == 1) {
+		SSPIF = 0; // Reset IRQ flag
+		if(SSPOV == 1) {
+			SSPOV = 0;
+			perf_isr_overflow();
+		}
+		/* else nothing to do */
+		ui8_value = SSPBUF; // clear BF bit
+		frame_receive(ui8_value);
+	}
+	/* else nothing to do */
+}
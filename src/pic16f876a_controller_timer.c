@@ -0,0 +1,103 @@
+/*************************************************************************
+ * Projet Raspberry pi lcd controller
+ *************************************************************************
+ * File : pic16f876a_controller_timer.c
+ *************************************************************************
+ * Date : 19 Octobre 2026
+ * Author : Sinseman44
+ * Organization : Coloc's bar
+ *************************************************************************/
+
+/*
+ * Tick timer :
+ * ------------
+ * Timer2 : FOSC/4 = 2 MHz, prescaler 1:4 => 500 kHz
+ *          PR2 = 124 => 4 kHz, postscaler 1:4 => 1 kHz
+ *
+ * The tick counter wraps after 65.5 s, durations are computed with an
+ * unsigned difference and must be shorter than that.
+ */
+
+/*************************************************************************
+ * Inclusion(s)
+ *************************************************************************/
+
+#include "pic16f876a_controller_timer.h"
+
+/*************************************************************************
+ * Constante(s)/Macro(s)
+ *************************************************************************/
+
+#define TIMER_PR2				124		/*!< Period register */
+#define TIMER_T2CON				0x1D	/*!< Postscaler 1:4, Timer2 On, Prescaler 1:4 */
+
+bank0 volatile uint16_t gui16_timer_tick = 0;	/*!< Number of ticks since the start */
+
+/*************************************************************************
+ * Prototype(s)
+ *************************************************************************/
+
+/*************************************************************************
+ * Fonction(s)
+ *************************************************************************/
+
+/**
+ * @fn void timer_init(void)
+ * @brief initialise Timer2 to generate an interrupt each tick
+ * @param none
+ * @return none
+ */
+void timer_init(void) {
+	gui16_timer_tick = 0;
+	TMR2 = 0;
+	PR2 = TIMER_PR2;
+	T2CON = TIMER_T2CON;
+
+	// clear TMR2IF interrupt flag
+	TMR2IF = 0;
+	// enable Timer2 interrupt
+	TMR2IE = 1;
+}
+
+/**
+ * @fn void timer_isr(void)
+ * @brief count a tick, called from the Timer2 interrupt
+ * @param none
+ * @return none
+ */
+void timer_isr(void) {
+	gui16_timer_tick ++;
+}
+
+/**
+ * @fn uint16_t timer_get_tick(void)
+ * @brief retrieve the tick counter
+ *        (read twice, interrupts stay enabled)
+ * @param none
+ * @return the number of ticks since the start
+ */
+uint16_t timer_get_tick(void) {
+	uint16_t ui16_tick = 0;
+	do {
+		ui16_tick = gui16_timer_tick;
+	} while(ui16_tick != gui16_timer_tick);
+	return ui16_tick;
+}
+
+/**
+ * @fn uint8_t timer_elapsed(const uint16_t ui16_since,
+ *			     const uint16_t ui16_nb_ticks)
+ * @brief test if a number of ticks has elapsed since a tick value
+ *
+ * @param [in] ui16_since	tick value at the start
+ * @param [in] ui16_nb_ticks	number of ticks
+ * @return 1 if the ticks have elapsed otherwise 0
+ */
+uint8_t timer_elapsed(const uint16_t /* in */ ui16_since,
+		      const uint16_t /* in */ ui16_nb_ticks) {
+	if((uint16_t)(timer_get_tick() - ui16_since) >= ui16_nb_ticks) {
+		return 1;
+	}
+	/* else nothing to do */
+	return 0;
+}
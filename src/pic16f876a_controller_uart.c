@@ -0,0 +1,109 @@
+/*************************************************************************
+ * Projet Raspberry pi lcd controller
+ *************************************************************************
+ * File : pic16f876a_controller_uart.c
+ *************************************************************************
+ * Date : 19 Octobre 2026
+ * Author : Sinseman44
+ * Organization : Coloc's bar
+ *************************************************************************/
+
+/*
+ * UART transport :
+ * ----------------
+ * 8 bits, no parity, 1 stop bit, receive only. With the 8 MHz crystal 
+ * the exact rates are 125000, 250000 and 500000 bauds (115200 is 8.5 % 
+ * off and can't be used). The interrupt of a byte may last longer than 
+ * two bytes at 250000 bauds : with the host emulator ('make bench 
+ * TRANSPORT=uart BAUD=250000', modelled and not measured on the board) 
+ * bytes are lost above 3 cycles per basic block. 125000 bauds gives 154 
+ * frames/s for full rows (18 bytes) with a pause of 5 ms.
+ *
+ * There is no transfer as on the I2C bus : the master sends sync bytes 
+ * (0x00) between the frames so the parser finds the next frame after an
+ * error. A framing error or an overrun drops the frame being received and
+ * the bytes until the next sync byte.
+ */
+
+/*************************************************************************
+ * Inclusion(s)
+ *************************************************************************/
+
+#include "pic16f876a_controller_uart.h"
+#include "pic16f876a_controller_frame.h"
+#include "pic16f876a_controller_perf.h"
+
+/*************************************************************************
+ * Constante(s)/Macro(s)
+ *************************************************************************/
+
+#define UART_SPBRG		((_XTAL_FREQ / (16UL * UART_BAUD)) - 1)	/*!< BRGH = 1 */
+
+#if (_XTAL_FREQ % (16UL * UART_BAUD)) != 0
+#error "UART_BAUD can't be generated from _XTAL_FREQ"
+#endif
+
+#define UART_TXSTA		0x04	/*!< Asynchronous, high speed, TX off */
+#define UART_RCSTA		0x90	/*!< Serial port on, continuous receive */
+
+/*************************************************************************
+ * Prototype(s)
+ *************************************************************************/
+
+/*************************************************************************
+ * Fonction(s)
+ *************************************************************************/
+
+/**
+ * @fn void uart_init(void)
+ * @brief initialise the USART in asynchronous receive mode
+ * @param none
+ * @return none
+ */
+void uart_init(void) {
+	// RC6 and RC7 are driven by the USART
+	TRISC6 = 1;
+	TRISC7 = 1;
+
+	SPBRG = UART_SPBRG;
+	TXSTA = UART_TXSTA;
+	RCSTA = UART_RCSTA;
+
+	// enable the reception interrupt
+	RCIE = 1;
+}
+
+/**
+ * @fn void uart_isr(void)
+ * @brief give the bytes received to the frame layer (only called from 
+ *        the interrupt)
+ * @param none
+ * @return none
+ */
+void uart_isr(void) {
+	uint8_t ui8_value = 0;
+
+	// up to 2 bytes are waiting
+	while(RCIF == 1) {
+		if(FERR == 1) {
+			ui8_value = RCREG; // discard it
+			perf_isr_drop(1);
+			frame_receive_resync();
+		}
+		else {
+			ui8_value = RCREG;
+			frame_receive(ui8_value);
+		}
+	}
+
+	// checked once the FIFO is empty : an overrun while it was read sets
+	// no other RCIF, the reception would stay stopped
+	if(OERR == 1) {
+		// bytes lost after the ones read : restart the reception
+		CREN = 0;
+		CREN = 1;
+		perf_isr_overflow();
+		frame_receive_resync();
+	}
+	/* else nothing to do */
+}
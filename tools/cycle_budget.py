@@ -0,0 +1,228 @@
+#!/usr/bin/env python3
+#########################################################################
+# Projet Raspberry pi lcd controller
+#########################################################################
+# File : cycle_budget.py
+#########################################################################
+# Date : 19 Octobre 2026
+# Author : Sinseman44
+# Organization : Coloc's bar
+#########################################################################
+
+"""
+Worst-case cycle report from the list file of picc (--ASMLIST).
+
+Each function is bounded by the sum of its instructions plus the bound
+of every function it calls :
+ - 1 cycle per word, 2 for call, goto, return, retfie and retlw,
+ - a skip (btfsc, btfss, decfsz, incfsz) counts 2 cycles,
+ - a loop (goto to a label above it in the same function) is counted
+   once, unless the budget file gives its number of iterations with 
+   'loop.<function> N' : the whole function, callees included, is then
+   counted N times. The other functions with a loop are marked with '*'
+   and their bound is per iteration (delays, string copies).
+
+The interrupt path is ISR_handle plus the interrupt latency and the
+context saving, a loop without a number of iterations on it fails. The
+frame handlers are split on the 'case' lines of the C source interleaved
+in frame_decode, each handler is reported with the common part of
+frame_decode (frame id and size reading, dispatch).
+
+Not validated : the patterns follow the list file format of the picc
+documentation, the script hasn't been run on a list file of this
+firmware (no picc here). Check the labels, the 'case' lines and a few
+bounds by hand on the first real list file.
+
+usage : cycle_budget.py <list file> <budget file>
+Returns 1 if a budget is exceeded.
+"""
+
+import re
+import sys
+
+ISR_FUNCTION = "_ISR_handle"
+ISR_OVERHEAD = 4 + 16		# latency + context saving/restoring
+DECODE_FUNCTION = "_frame_decode"
+DECODE_FILE = "pic16f876a_controller_frame.c"
+COMMON = ""
+
+RE_LABEL = re.compile(r"^\s*\d+\s+(_\w+):")
+RE_LOCAL = re.compile(r"^\s*\d+\s+([a-zA-Z]\w*):")
+RE_INSN = re.compile(r"^\s*\d+\s+[0-9A-Fa-f]{3,4}\s+[0-9A-Fa-f]{4}(?:\s+(\w+)\s*([^;]*))?")
+RE_SOURCE = re.compile(r";\s*(\S+\.c):\s*(\d+):\s*(.*)$")
+RE_CASE = re.compile(r"^\s*case\s+(\w+)\s*:")
+
+TWO_CYCLES = ("call", "fcall", "goto", "ljmp", "return", "retfie", "retlw")
+SKIPS = ("btfsc", "btfss", "decfsz", "incfsz")
+
+
+class Function:
+	def __init__(self, name):
+		self.name = name
+		self.cycles = {COMMON: 0}	# cycles per handler (frame_decode)
+		self.calls = {COMMON: []}	# callees per handler
+		self.labels = set()
+		self.loops = set()			# handlers with a loop
+
+
+def insn_cycles(mnemonic):
+	if mnemonic is None:
+		return 1			# second word of a pseudo instruction
+	mnemonic = mnemonic.lower()
+	if (mnemonic in TWO_CYCLES) or (mnemonic in SKIPS):
+		return 2
+	return 1
+
+
+def parse(path):
+	functions = {}
+	current = None
+	handler = COMMON
+
+	with open(path, errors="replace") as f:
+		for line in f:
+			source = RE_SOURCE.search(line)
+			if source:
+				if (current is not None) and (current.name == DECODE_FUNCTION) \
+				   and source.group(1).endswith(DECODE_FILE):
+					text = source.group(3)
+					case = RE_CASE.match(text)
+					if case:
+						handler = case.group(1)
+					elif text.strip().startswith("default:"):
+						handler = "default"
+					elif text.strip().startswith("switch"):
+						handler = COMMON
+				continue
+
+			label = RE_LABEL.match(line)
+			if label:
+				current = Function(label.group(1))
+				functions[current.name] = current
+				handler = COMMON
+				continue
+
+			if current is None:
+				continue
+
+			local = RE_LOCAL.match(line)
+			if local:
+				current.labels.add(local.group(1))
+				continue
+
+			insn = RE_INSN.match(line)
+			if not insn:
+				continue
+			mnemonic = insn.group(1)
+			operand = (insn.group(2) or "").strip()
+			current.cycles.setdefault(handler, 0)
+			current.calls.setdefault(handler, [])
+			current.cycles[handler] += insn_cycles(mnemonic)
+			if mnemonic is None:
+				continue
+			mnemonic = mnemonic.lower()
+			if mnemonic in ("call", "fcall") and operand.startswith("_"):
+				current.calls[handler].append(operand.split(",")[0].strip())
+			elif mnemonic in ("goto", "ljmp") and (operand in current.labels):
+				current.loops.add(handler)
+	return functions
+
+
+def bound(functions, name, cache, budgets, stack=()):
+	if name in cache:
+		return cache[name]
+	function = functions.get(name)
+	if (function is None) or (name in stack):
+		return 0, False
+	cycles = 0
+	iterations = budgets.get("loop." + name.lstrip("_"))
+	loop = (len(function.loops) != 0) and (iterations is None)
+	for handler in function.cycles:
+		cycles += function.cycles[handler]
+		for callee in function.calls[handler]:
+			callee_cycles, callee_loop = bound(functions, callee, cache, budgets, stack + (name,))
+			cycles += callee_cycles
+			loop = loop or callee_loop
+	if (len(function.loops) != 0) and (iterations is not None):
+		cycles *= iterations
+	cache[name] = (cycles, loop)
+	return cache[name]
+
+
+def handler_bound(functions, function, handler, cache, budgets):
+	cycles = function.cycles.get(handler, 0)
+	loop = handler in function.loops
+	for callee in function.calls.get(handler, []):
+		callee_cycles, callee_loop = bound(functions, callee, cache, budgets)
+		cycles += callee_cycles
+		loop = loop or callee_loop
+	return cycles, loop
+
+
+def read_budgets(path):
+	budgets = {}
+	with open(path) as f:
+		for line in f:
+			line = line.split("#")[0].strip()
+			if line:
+				key, value = line.split()
+				budgets[key] = int(value)
+	return budgets
+
+
+def check(name, cycles, loop, budget, bounded=False):
+	mark = "*" if loop else " "
+	if budget is None:
+		print("  %-24s %6d%s" % (name, cycles, mark))
+		return True
+	if bounded and loop:
+		print("  %-24s %6d%s / %6d  UNBOUNDED" % (name, cycles, mark, budget))
+		return False
+	state = "ok" if cycles <= budget else "OVER"
+	print("  %-24s %6d%s / %6d  %s" % (name, cycles, mark, budget, state))
+	return cycles <= budget
+
+
+def main():
+	if len(sys.argv) != 3:
+		print(__doc__)
+		return 2
+
+	functions = parse(sys.argv[1])
+	budgets = read_budgets(sys.argv[2])
+	cache = {}
+	ok = True
+
+	if ISR_FUNCTION not in functions:
+		print("cycle_budget: %s not found in %s" % (ISR_FUNCTION, sys.argv[1]))
+		return 2
+
+	print("Interrupt path (cycles) :")
+	cycles, loop = bound(functions, ISR_FUNCTION, cache, budgets)
+	ok &= check("ISR_handle", cycles + ISR_OVERHEAD, loop, budgets.get("isr"), True)
+	if loop:
+		for name in sorted(cache):
+			if (cache[name][1]) and (name in functions) and (len(functions[name].loops) != 0) \
+			   and (("loop." + name.lstrip("_")) not in budgets):
+				print("  loop without a number of iterations : %s" % name.lstrip("_"))
+
+	decode = functions.get(DECODE_FUNCTION)
+	if decode is not None:
+		print("Frame handlers (cycles) :")
+		common, common_loop = handler_bound(functions, decode, COMMON, cache, budgets)
+		for handler in sorted(decode.cycles):
+			if handler == COMMON:
+				continue
+			cycles, loop = handler_bound(functions, decode, handler, cache, budgets)
+			budget = budgets.get("decode." + handler, budgets.get("decode"))
+			ok &= check(handler, common + cycles, loop or common_loop, budget)
+
+	print("* : contains a loop, counted once")
+	if not ok:
+		print("cycle_budget: budget exceeded")
+		return 1
+	return 0
+
+
+if __name__ == "__main__":
+	sys.exit(main())
@@ -0,0 +1,161 @@
+#ifndef EMU
+#define EMU
+
+/*************************************************************************
+ * Projet Raspberry pi lcd controller
+ *************************************************************************
+ * File : emu.h
+ *************************************************************************
+ * Date : 19 Octobre 2026
+ * Author : Sinseman44
+ * Organization : Coloc's bar
+ *************************************************************************/
+
+/*
+ * Host emulator (make emu) :
+ * --------------------------
+ *  - emu_pic.c : time, register file, timers, EEPROM and interrupt of the
+ *                PIC, the firmware runs on it,
+ *  - emu_bus.c : the master of the transport (I2C, UART or SPI, the one
+ *                of the build) and the MSSP or USART receiving it,
+ *  - emu_lcd.c : the HD44780 displays on the pins,
+ *  - emu_vcd.c : the waveforms (value change dump for GTKWave),
+ *  - emu_main.c : options, scenario and report.
+ *
+ * The emulator code isn't instrumented and reaches the registers with
+ * EMU_RAW(), without the cost of an access of the firmware.
+ */
+
+/*************************************************************************
+ * Inclusion(s)
+ *************************************************************************/
+
+#include "pic16f876a_controller_include.h"
+
+/*************************************************************************
+ * Constante(s)/Macro(s)
+ *************************************************************************/
+
+#define EMU_NS_PER_CYCLE	(4000000000ULL / _XTAL_FREQ)	/*!< 500 ns at 8 MHz */
+#define EMU_NOW_NS			(gui64_emu_cycle * EMU_NS_PER_CYCLE)
+
+#define EMU_RAW(addr)			(gpst_emu_sfr[(addr)].ui8_byte)
+#define EMU_GET(addr, mask)		((EMU_RAW(addr) & (mask)) != 0)
+#define EMU_SET(addr, mask)		(EMU_RAW(addr) |= (mask))
+#define EMU_CLR(addr, mask)		(EMU_RAW(addr) &= (uint8_t)~(mask))
+
+// bits used by the models
+#define EMU_INTCON_INTF		0x02
+#define EMU_INTCON_GIE		0x80
+#define EMU_PIR1_SSPIF		0x08
+#define EMU_PIR1_RCIF		0x20
+#define EMU_PIR2_EEIF		0x10
+#define EMU_SSPCON_CKP		0x10
+#define EMU_SSPCON_SSPEN	0x20
+#define EMU_SSPCON_SSPOV	0x40
+#define EMU_SSPCON_SSPM		0x0F
+#define EMU_SSPCON2_SEN		0x01
+#define EMU_SSPCON2_GCEN	0x80
+#define EMU_SSPSTAT_BF		0x01
+#define EMU_SSPSTAT_R_W		0x04
+#define EMU_SSPSTAT_S		0x08
+#define EMU_SSPSTAT_P		0x10
+#define EMU_SSPSTAT_D_A		0x20
+#define EMU_SSPSTAT_SMP		0x80
+#define EMU_RCSTA_OERR		0x02
+#define EMU_RCSTA_FERR		0x04
+#define EMU_RCSTA_CREN		0x10
+#define EMU_RCSTA_SPEN		0x80
+#define EMU_TXSTA_BRGH		0x04
+#define EMU_OPTION_INTEDG	0x40
+#define EMU_TRISB_TRISB0	0x01
+
+#define EMU_EEPROM_SIZE		256
+
+/*************************************************************************
+ * Enuméré(s)
+ *************************************************************************/
+
+typedef enum {
+	EMU_STEP_SEND = 0,		/*!< Transfer (I2C write, UART bytes, SPI frame) */
+	EMU_STEP_WAIT			/*!< Bus idle */
+} EMU_step_id_t;
+
+/*************************************************************************
+ * Structure(s)
+ *************************************************************************/
+
+typedef struct {
+	EMU_step_id_t e_id;
+	uint8_t ui8_addr;		/*!< I2C address of the transfer */
+	uint16_t ui16_size;
+	uint8_t * pui8_data;
+	uint64_t ui64_wait_ns;
+} EMU_step_t;
+
+typedef struct {
+	uint32_t ui32_transfers;		/*!< Transfers sent */
+	uint32_t ui32_nacks;			/*!< Transfers stopped by a NACK */
+	uint32_t ui32_bytes;			/*!< Bytes received by the PIC */
+	uint32_t ui32_overflows;		/*!< SSPOV (MSSP) or OERR (USART) */
+	uint32_t ui32_framing;			/*!< FERR (USART) */
+	uint32_t ui32_stretches;		/*!< Clock held by the slave (I2C) */
+	uint64_t ui64_stretch_ns;
+	uint64_t ui64_stretch_max_ns;
+	uint64_t ui64_first_ack_ns;		/*!< First address acknowledged (I2C) */
+} EMU_bus_stats_t;
+
+/*************************************************************************
+ * Variable(s)
+ *************************************************************************/
+
+extern uint64_t gui64_emu_cycle;
+extern EMU_sfr_t gpst_emu_sfr[EMU_NB_SFR];
+extern uint8_t gpui8_emu_eeprom[EMU_EEPROM_SIZE];
+extern uint32_t gui32_emu_block_cycles;
+extern EMU_bus_stats_t gst_emu_bus;
+
+/*************************************************************************
+ * Prototypes(s)
+ *************************************************************************/
+
+// emu_pic.c
+void emu_pic_reset(const uint8_t /* in */ ui8_warm);
+void emu_pic_run(void);
+void emu_pic_stop(void);
+void emu_pic_report(void);
+
+// emu_bus.c
+void emu_bus_init(const uint32_t /* in */ ui32_rate,
+				  const uint8_t /* in */ ui8_no_stretch);
+void emu_bus_timing(const uint64_t /* in */ ui64_gap_ns, const uint64_t /* in */ ui64_setup_ns);
+void emu_bus_run(const uint64_t /* in */ ui64_now_ns);
+void emu_bus_access(const uint16_t /* in */ ui16_addr);
+uint8_t emu_bus_portb(void);
+uint8_t emu_bus_is_idle(void);
+void emu_bus_report(void);
+
+// emu_lcd.c
+void emu_lcd_init(void);
+void emu_lcd_pins(const uint8_t /* in */ ui8_display,
+				  const uint8_t /* in */ ui8_en,
+				  const uint8_t /* in */ ui8_rs,
+				  const uint8_t /* in */ ui8_data,
+				  const uint64_t /* in */ ui64_now_ns);
+void emu_lcd_report(void);
+
+// emu_vcd.c
+int8_t emu_vcd_open(const char_t * /* in */ pc_path);
+uint8_t emu_vcd_var(const char_t * /* in */ pc_name, const uint8_t /* in */ ui8_value);
+void emu_vcd_set(const uint8_t /* in */ ui8_var, const uint8_t /* in */ ui8_value,
+				 const uint64_t /* in */ ui64_now_ns);
+void emu_vcd_close(const uint64_t /* in */ ui64_now_ns);
+
+// emu_main.c
+const EMU_step_t * emu_main_step(const uint64_t /* in */ ui64_now_ns);
+void emu_main_sent(const uint8_t /* in */ ui8_acked, const uint64_t /* in */ ui64_now_ns);
+void emu_main_lcd(const uint8_t /* in */ ui8_display, const uint8_t /* in */ ui8_rs,
+				  const uint8_t /* in */ ui8_byte, const uint64_t /* in */ ui64_now_ns);
+uint8_t emu_main_is_over(const uint64_t /* in */ ui64_now_ns);
+
+#endif /* EMU */
@@ -0,0 +1,823 @@
+/*************************************************************************
+ * Projet Raspberry pi lcd controller
+ *************************************************************************
+ * File : emu_bus.c
+ *************************************************************************
+ * Date : 19 Octobre 2026
+ * Author : Sinseman44
+ * Organization : Coloc's bar
+ *************************************************************************/
+
+/*
+ * Transport of the host emulator :
+ * --------------------------------
+ * The master sends the transfers of the scenario bit by bit, the lines are
+ * dumped to the VCD file. The transport is the one of the build.
+ *
+ * I2C (SCL, SDA) : a write transfer to the address of the scenario, the
+ * rate is 100 or 400 kHz (-r), the high and low times are both half of
+ * the period. The MSSP is a 7 bits slave : the byte is acknowledged if
+ * its address matches (SSPADD or the general call with GCEN) and if BF
+ * and SSPOV are clear, otherwise SSPOV is set (BF still set) and the
+ * master stops the transfer on the NACK. SSPBUF, BF and SSPIF are set on
+ * the falling edge of the 9th clock, then SCL is held low until CKP is
+ * set if SEN is set (-n : not held, the interrupt must be in time). Master
+ * reads aren't emulated.
+ *
+ * UART (RX) : a sync byte (0x00) then the bytes of the transfer at the
+ * rate of the master (-r, UART_BAUD by default), 1 stop bit. The USART
+ * keeps 2 bytes, a third one sets OERR and the reception stops until
+ * CREN is cleared. A rate more than 4 % off the one of SPBRG sets FERR.
+ *
+ * SPI (RB0, SCK, SDI) : RB0 low, the setup time (-u, 20 us), the bytes
+ * with a gap after each one (-b) and RB0 high. The MSSP counts the bits
+ * from the last SSPEN set, the 8th one loads SSPBUF and sets SSPIF, or
+ * sets SSPOV if BF is still set.
+ *
+ * Reading SSPBUF clears BF, reading RCREG takes the next byte of the
+ * USART.
+ */
+
+/*************************************************************************
+ * Inclusion(s)
+ *************************************************************************/
+
+#include "emu.h"
+#include "pic16f876a_controller_frame.h"
+
+/*************************************************************************
+ * Constante(s)/Macro(s)
+ *************************************************************************/
+
+#define EMU_BUS_NEVER		0xFFFFFFFFFFFFFFFFULL
+
+#define EMU_I2C_IDLE		0
+#define EMU_I2C_BIT_LOW		1
+#define EMU_I2C_BIT_HIGH	2
+#define EMU_I2C_ACK_LOW		3
+#define EMU_I2C_ACK_HIGH	4
+#define EMU_I2C_ACK_FALL	5
+#define EMU_I2C_STOP_LOW	6
+#define EMU_I2C_STOP_HIGH	7
+#define EMU_I2C_STOP		8
+
+#define EMU_SPI_SETUP_NS	20000ULL		/*!< Default frame setup (-u) */
+
+/*************************************************************************
+ * Variable(s)
+ *************************************************************************/
+
+EMU_bus_stats_t gst_emu_bus;
+
+uint64_t gui64_emu_bus_next = 0;			/*!< Time of the next step of the master */
+uint64_t gui64_emu_bus_half = 0;			/*!< Half of a bit time (ns) */
+uint8_t gui8_emu_bus_state = 0;
+const EMU_step_t * gpst_emu_bus_step = 0;
+uint16_t gui16_emu_bus_byte = 0;			/*!< Byte of the step sent */
+uint8_t gui8_emu_bus_bit = 0;
+uint8_t gui8_emu_bus_acked = 1;
+
+uint32_t gui32_emu_bus_rate = 0;
+uint8_t gui8_emu_bus_no_stretch = 0;
+uint64_t gui64_emu_bus_gap_ns = 0;			/*!< SPI : after each byte */
+uint64_t gui64_emu_bus_setup_ns = EMU_SPI_SETUP_NS;
+
+// lines
+uint8_t gui8_emu_bus_var_clk = 0;
+uint8_t gui8_emu_bus_var_data = 0;
+uint8_t gui8_emu_bus_var_frame = 0;
+uint8_t gui8_emu_bus_clk = 1;
+uint8_t gui8_emu_bus_data = 1;
+uint8_t gui8_emu_bus_portb = 0x31;			/*!< RB0 high, straps RB4/RB5 open */
+
+// slave
+uint8_t gui8_emu_slave_shift = 0;
+uint8_t gui8_emu_slave_bits = 0;
+uint8_t gui8_emu_slave_address = 1;			/*!< Next byte is the address (I2C) */
+uint8_t gui8_emu_slave_selected = 0;
+uint8_t gui8_emu_slave_load = 0;			/*!< Byte acknowledged */
+uint8_t gui8_emu_slave_hold = 0;			/*!< SCL held low */
+uint8_t gui8_emu_slave_sda = 1;
+uint64_t gui64_emu_slave_hold_ns = 0;
+uint8_t gpui8_emu_slave_fifo[2];			/*!< USART */
+uint8_t gpui8_emu_slave_ferr[2];
+uint8_t gui8_emu_slave_count = 0;
+
+/*************************************************************************
+ * Fonction(s)
+ *************************************************************************/
+
+/**
+ * @fn void emu_bus_lines(const uint8_t ui8_clk, const uint8_t ui8_data, const uint64_t ui64_ns)
+ * @brief set the clock and data lines (SCL/SDA, SCK/SDI or RX)
+ * @param [in] ui8_clk		clock level (not used by the UART)
+ * @param [in] ui8_data		data level
+ * @param [in] ui64_ns		time of the change
+ * @return nothing
+ */
+void emu_bus_lines(const uint8_t /* in */ ui8_clk, const uint8_t /* in */ ui8_data,
+				   const uint64_t /* in */ ui64_ns) {
+	if(ui8_clk != gui8_emu_bus_clk) {
+		gui8_emu_bus_clk = ui8_clk;
+		emu_vcd_set(gui8_emu_bus_var_clk, ui8_clk, ui64_ns);
+	}
+	/* else nothing to do */
+	if(ui8_data != gui8_emu_bus_data) {
+		gui8_emu_bus_data = ui8_data;
+		emu_vcd_set(gui8_emu_bus_var_data, ui8_data, ui64_ns);
+	}
+	/* else nothing to do */
+}
+
+/**
+ * @fn uint8_t emu_bus_next_step(const uint64_t ui64_now_ns)
+ * @brief take the next step of the scenario, wait for an idle one
+ * @param [in] ui64_now_ns	current time
+ * @return 1 if a transfer starts, 0 otherwise
+ */
+uint8_t emu_bus_next_step(const uint64_t /* in */ ui64_now_ns) {
+	gpst_emu_bus_step = emu_main_step(ui64_now_ns);
+	if(gpst_emu_bus_step == 0) {
+		gui64_emu_bus_next = EMU_BUS_NEVER;
+		return 0;
+	}
+	/* else nothing to do */
+	if(gpst_emu_bus_step->e_id == EMU_STEP_WAIT) {
+		gui64_emu_bus_next = ui64_now_ns + gpst_emu_bus_step->ui64_wait_ns;
+		gpst_emu_bus_step = 0;
+		return 0;
+	}
+	/* else nothing to do */
+	gui16_emu_bus_byte = 0;
+	gui8_emu_bus_bit = 0;
+	gui8_emu_bus_acked = 1;
+	gst_emu_bus.ui32_transfers ++;
+	return 1;
+}
+
+/**
+ * @fn uint8_t emu_bus_tx(void)
+ * @brief byte of the transfer being sent (I2C : the address first)
+ * @param none
+ * @return byte
+ */
+uint8_t emu_bus_tx(void) {
+#ifdef TRANSPORT_UART
+	// sync byte first
+	if(gui16_emu_bus_byte == 0) {
+		return FRAME_SYNC;
+	}
+	/* else nothing to do */
+	return gpst_emu_bus_step->pui8_data[gui16_emu_bus_byte - 1];
+#elif defined(TRANSPORT_SPI)
+	return gpst_emu_bus_step->pui8_data[gui16_emu_bus_byte];
+#else
+	if(gui16_emu_bus_byte == 0) {
+		return gpst_emu_bus_step->ui8_addr << 1;
+	}
+	/* else nothing to do */
+	return gpst_emu_bus_step->pui8_data[gui16_emu_bus_byte - 1];
+#endif
+}
+
+/**
+ * @fn uint16_t emu_bus_tx_size(void)
+ * @brief bytes of the transfer on the bus
+ * @param none
+ * @return size
+ */
+uint16_t emu_bus_tx_size(void) {
+#ifdef TRANSPORT_SPI
+	return gpst_emu_bus_step->ui16_size;
+#else
+	return gpst_emu_bus_step->ui16_size + 1;
+#endif
+}
+
+/**
+ * @fn void emu_bus_sent(const uint64_t ui64_ns)
+ * @brief end of the transfer
+ * @param [in] ui64_ns	time of the end
+ * @return nothing
+ */
+void emu_bus_sent(const uint64_t /* in */ ui64_ns) {
+	if(gui8_emu_bus_acked == 0) {
+		gst_emu_bus.ui32_nacks ++;
+	}
+	/* else nothing to do */
+	emu_main_sent(gui8_emu_bus_acked, ui64_ns);
+	gpst_emu_bus_step = 0;
+}
+
+#if !defined(TRANSPORT_UART) && !defined(TRANSPORT_SPI)
+
+/**
+ * @fn void emu_bus_i2c_ack(void)
+ * @brief slave decision on the byte received (8th falling edge)
+ * @param none
+ * @return nothing
+ */
+void emu_bus_i2c_ack(void) {
+	uint8_t ui8_match = 0;
+
+	gui8_emu_slave_load = 0;
+	if((EMU_GET(EMU_SSPCON, EMU_SSPCON_SSPEN) == 0) ||
+	   ((EMU_RAW(EMU_SSPCON) & 0x07) != 0x06)) {
+		return;
+	}
+	/* else nothing to do */
+	if(gui8_emu_slave_address == 1) {
+		ui8_match = ((gui8_emu_slave_shift & 0xFE) == (EMU_RAW(EMU_SSPADD) & 0xFE)) ||
+			((gui8_emu_slave_shift == 0x00) && EMU_GET(EMU_SSPCON2, EMU_SSPCON2_GCEN));
+		gui8_emu_slave_selected = ui8_match;
+	}
+	/* else nothing to do */
+	if(gui8_emu_slave_selected == 0) {
+		return;
+	}
+	/* else nothing to do */
+	if(EMU_GET(EMU_SSPSTAT, EMU_SSPSTAT_BF) || EMU_GET(EMU_SSPCON, EMU_SSPCON_SSPOV)) {
+		if(EMU_GET(EMU_SSPSTAT, EMU_SSPSTAT_BF)) {
+			EMU_SET(EMU_SSPCON, EMU_SSPCON_SSPOV);
+			gst_emu_bus.ui32_overflows ++;
+		}
+		/* else nothing to do */
+		EMU_SET(EMU_PIR1, EMU_PIR1_SSPIF);
+		return;
+	}
+	/* else nothing to do */
+	gui8_emu_slave_load = 1;
+	gui8_emu_slave_sda = 0;
+}
+
+/**
+ * @fn void emu_bus_i2c_fall(const uint64_t ui64_ns)
+ * @brief falling edge of the 9th clock : SSPBUF loaded and clock held
+ * @param [in] ui64_ns		time of the edge
+ * @return nothing
+ */
+void emu_bus_i2c_fall(const uint64_t /* in */ ui64_ns) {
+	gui8_emu_slave_sda = 1;
+	if(gui8_emu_slave_load == 1) {
+		EMU_RAW(EMU_SSPBUF) = gui8_emu_slave_shift;
+		EMU_SET(EMU_SSPSTAT, EMU_SSPSTAT_BF);
+		if(gui8_emu_slave_address == 1) {
+			EMU_CLR(EMU_SSPSTAT, EMU_SSPSTAT_D_A | EMU_SSPSTAT_R_W);
+			if(gst_emu_bus.ui64_first_ack_ns == 0) {
+				gst_emu_bus.ui64_first_ack_ns = ui64_ns;
+			}
+			/* else nothing to do */
+		}
+		else {
+			EMU_SET(EMU_SSPSTAT, EMU_SSPSTAT_D_A);
+		}
+		EMU_SET(EMU_PIR1, EMU_PIR1_SSPIF);
+		gst_emu_bus.ui32_bytes ++;
+		if((EMU_GET(EMU_SSPCON2, EMU_SSPCON2_SEN) == 1) && (gui8_emu_bus_no_stretch == 0)) {
+			EMU_CLR(EMU_SSPCON, EMU_SSPCON_CKP);
+			gui8_emu_slave_hold = 1;
+		}
+		/* else nothing to do */
+	}
+	/* else nothing to do */
+	gui8_emu_slave_address = 0;
+	gui8_emu_slave_load = 0;
+}
+
+/**
+ * @fn uint8_t emu_bus_i2c_rise(const uint64_t ui64_now_ns)
+ * @brief release SCL, wait while the slave holds it
+ * @param [in] ui64_now_ns	current time
+ * @return 1 if SCL is high, 0 if held
+ */
+uint8_t emu_bus_i2c_rise(const uint64_t /* in */ ui64_now_ns) {
+	uint64_t ui64_held = 0;
+
+	if(gui8_emu_slave_hold == 1) {
+		if(gui64_emu_slave_hold_ns == 0) {
+			gui64_emu_slave_hold_ns = gui64_emu_bus_next;
+		}
+		/* else nothing to do */
+		return 0;
+	}
+	/* else nothing to do */
+	if(gui64_emu_slave_hold_ns != 0) {
+		// released since the step was due
+		ui64_held = ui64_now_ns - gui64_emu_slave_hold_ns;
+		gst_emu_bus.ui32_stretches ++;
+		gst_emu_bus.ui64_stretch_ns += ui64_held;
+		if(ui64_held > gst_emu_bus.ui64_stretch_max_ns) {
+			gst_emu_bus.ui64_stretch_max_ns = ui64_held;
+		}
+		/* else nothing to do */
+		gui64_emu_slave_hold_ns = 0;
+		gui64_emu_bus_next = ui64_now_ns;
+	}
+	/* else nothing to do */
+	return 1;
+}
+
+/**
+ * @fn void emu_bus_i2c(const uint64_t ui64_now_ns)
+ * @brief I2C master and MSSP slave up to the current time
+ * @param [in] ui64_now_ns	current time
+ * @return nothing
+ */
+void emu_bus_i2c(const uint64_t /* in */ ui64_now_ns) {
+	uint64_t ui64_ns = 0;
+	uint8_t ui8_bit = 0;
+
+	// CKP set by the interrupt (or the MSSP disabled)
+	if((gui8_emu_slave_hold == 1) &&
+	   (EMU_GET(EMU_SSPCON, EMU_SSPCON_CKP) || !EMU_GET(EMU_SSPCON, EMU_SSPCON_SSPEN))) {
+		gui8_emu_slave_hold = 0;
+	}
+	/* else nothing to do */
+
+	while(gui64_emu_bus_next <= ui64_now_ns) {
+		ui64_ns = gui64_emu_bus_next;
+		switch(gui8_emu_bus_state) {
+			case EMU_I2C_IDLE:
+				if(emu_bus_next_step(ui64_ns) == 1) {
+					// start : SDA falls while SCL is high
+					emu_bus_lines(1, 0, ui64_ns);
+					EMU_SET(EMU_SSPSTAT, EMU_SSPSTAT_S);
+					EMU_CLR(EMU_SSPSTAT, EMU_SSPSTAT_P);
+					gui8_emu_slave_address = 1;
+					gui8_emu_slave_selected = 0;
+					gui8_emu_bus_state = EMU_I2C_BIT_LOW;
+					gui64_emu_bus_next = ui64_ns + gui64_emu_bus_half;
+				}
+				/* else waiting */
+				break;
+			case EMU_I2C_BIT_LOW:
+				ui8_bit = (emu_bus_tx() >> (7 - gui8_emu_bus_bit)) & 0x01;
+				emu_bus_lines(0, ui8_bit, ui64_ns);
+				gui8_emu_bus_state = EMU_I2C_BIT_HIGH;
+				gui64_emu_bus_next = ui64_ns + gui64_emu_bus_half;
+				break;
+			case EMU_I2C_BIT_HIGH:
+				if(emu_bus_i2c_rise(ui64_now_ns) == 0) {
+					return;
+				}
+				/* else nothing to do */
+				ui64_ns = gui64_emu_bus_next;
+				emu_bus_lines(1, gui8_emu_bus_data, ui64_ns);
+				if(gui8_emu_bus_bit == 0) {
+					gui8_emu_slave_shift = 0;
+				}
+				/* else nothing to do */
+				gui8_emu_slave_shift = (gui8_emu_slave_shift << 1) | gui8_emu_bus_data;
+				gui8_emu_bus_bit ++;
+				if(gui8_emu_bus_bit == 8) {
+					gui8_emu_bus_state = EMU_I2C_ACK_LOW;
+				}
+				else {
+					gui8_emu_bus_state = EMU_I2C_BIT_LOW;
+				}
+				gui64_emu_bus_next = ui64_ns + gui64_emu_bus_half;
+				break;
+			case EMU_I2C_ACK_LOW:
+				// the master releases SDA, the slave drives the 9th bit
+				gui8_emu_slave_sda = 1;
+				emu_bus_i2c_ack();
+				emu_bus_lines(0, gui8_emu_slave_sda, ui64_ns);
+				gui8_emu_bus_state = EMU_I2C_ACK_HIGH;
+				gui64_emu_bus_next = ui64_ns + gui64_emu_bus_half;
+				break;
+			case EMU_I2C_ACK_HIGH:
+				if(emu_bus_i2c_rise(ui64_now_ns) == 0) {
+					return;
+				}
+				/* else nothing to do */
+				ui64_ns = gui64_emu_bus_next;
+				emu_bus_lines(1, gui8_emu_bus_data, ui64_ns);
+				gui8_emu_bus_acked = (gui8_emu_bus_data == 0);
+				gui8_emu_bus_state = EMU_I2C_ACK_FALL;
+				gui64_emu_bus_next = ui64_ns + gui64_emu_bus_half;
+				break;
+			case EMU_I2C_ACK_FALL:
+				emu_bus_i2c_fall(ui64_ns);
+				emu_bus_lines(0, 0, ui64_ns);
+				gui8_emu_bus_bit = 0;
+				gui16_emu_bus_byte ++;
+				if((gui8_emu_bus_acked == 1) && (gui16_emu_bus_byte < emu_bus_tx_size())) {
+					gui8_emu_bus_state = EMU_I2C_BIT_LOW;
+				}
+				else {
+					gui8_emu_bus_state = EMU_I2C_STOP_LOW;
+				}
+				break;
+			case EMU_I2C_STOP_LOW:
+				emu_bus_lines(0, 0, ui64_ns);
+				gui8_emu_bus_state = EMU_I2C_STOP_HIGH;
+				gui64_emu_bus_next = ui64_ns + gui64_emu_bus_half;
+				break;
+			case EMU_I2C_STOP_HIGH:
+				if(emu_bus_i2c_rise(ui64_now_ns) == 0) {
+					return;
+				}
+				/* else nothing to do */
+				ui64_ns = gui64_emu_bus_next;
+				emu_bus_lines(1, 0, ui64_ns);
+				gui8_emu_bus_state = EMU_I2C_STOP;
+				gui64_emu_bus_next = ui64_ns + gui64_emu_bus_half;
+				break;
+			default:
+				// stop : SDA rises while SCL is high
+				emu_bus_lines(1, 1, ui64_ns);
+				EMU_SET(EMU_SSPSTAT, EMU_SSPSTAT_P);
+				EMU_CLR(EMU_SSPSTAT, EMU_SSPSTAT_S);
+				gui8_emu_slave_selected = 0;
+				gui8_emu_bus_state = EMU_I2C_IDLE;
+				emu_bus_sent(ui64_ns);
+				break;
+		}
+	}
+}
+
+#endif
+
+#ifdef TRANSPORT_UART
+
+/**
+ * @fn void emu_bus_uart_receive(const uint8_t ui8_value)
+ * @brief byte received by the USART (middle of the stop bit)
+ * @param [in] ui8_value	byte
+ * @return nothing
+ */
+void emu_bus_uart_receive(const uint8_t /* in */ ui8_value) {
+	uint32_t ui32_baud = 0;
+	uint8_t ui8_ferr = 0;
+
+	if((EMU_GET(EMU_RCSTA, EMU_RCSTA_SPEN) == 0) || (EMU_GET(EMU_RCSTA, EMU_RCSTA_CREN) == 0) ||
+	   (EMU_GET(EMU_RCSTA, EMU_RCSTA_OERR) == 1)) {
+		return;
+	}
+	/* else nothing to do */
+	if(gui8_emu_slave_count == 2) {
+		EMU_SET(EMU_RCSTA, EMU_RCSTA_OERR);
+		gst_emu_bus.ui32_overflows ++;
+		return;
+	}
+	/* else nothing to do */
+
+	// rate of SPBRG (BRGH = 1 : 16 clocks per bit, 64 otherwise)
+	ui32_baud = _XTAL_FREQ / ((EMU_GET(EMU_TXSTA, EMU_TXSTA_BRGH) ? 16UL : 64UL) *
+		((uint32_t)EMU_RAW(EMU_SPBRG) + 1));
+	if((gui32_emu_bus_rate * 100UL > ui32_baud * 104UL) ||
+	   (gui32_emu_bus_rate * 104UL < ui32_baud * 100UL)) {
+		ui8_ferr = 1;
+		gst_emu_bus.ui32_framing ++;
+	}
+	/* else nothing to do */
+	gpui8_emu_slave_fifo[gui8_emu_slave_count] = ui8_value;
+	gpui8_emu_slave_ferr[gui8_emu_slave_count] = ui8_ferr;
+	gui8_emu_slave_count ++;
+	gst_emu_bus.ui32_bytes ++;
+	if(gpui8_emu_slave_ferr[0] == 1) {
+		EMU_SET(EMU_RCSTA, EMU_RCSTA_FERR);
+	}
+	/* else nothing to do */
+	EMU_SET(EMU_PIR1, EMU_PIR1_RCIF);
+}
+
+/**
+ * @fn void emu_bus_uart(const uint64_t ui64_now_ns)
+ * @brief UART master and USART up to the current time
+ * @param [in] ui64_now_ns	current time
+ * @return nothing
+ */
+void emu_bus_uart(const uint64_t /* in */ ui64_now_ns) {
+	uint64_t ui64_ns = 0;
+
+	// OERR is cleared with CREN
+	if(EMU_GET(EMU_RCSTA, EMU_RCSTA_CREN) == 0) {
+		EMU_CLR(EMU_RCSTA, EMU_RCSTA_OERR);
+	}
+	/* else nothing to do */
+
+	// bit 0 : start bit, 1 to 8 : data, 9 : stop bit, 10 : middle of the
+	// stop bit, 11 : end of the stop bit
+	while(gui64_emu_bus_next <= ui64_now_ns) {
+		ui64_ns = gui64_emu_bus_next;
+		if(gpst_emu_bus_step == 0) {
+			if(emu_bus_next_step(ui64_ns) == 0) {
+				continue;
+			}
+			/* else nothing to do */
+		}
+		/* else nothing to do */
+		switch(gui8_emu_bus_bit) {
+			case 0:
+				emu_bus_lines(0, 0, ui64_ns);
+				break;
+			case 9:
+				emu_bus_lines(0, 1, ui64_ns);
+				break;
+			case 10:
+				emu_bus_uart_receive(emu_bus_tx());
+				break;
+			case 11:
+				// next byte at once
+				break;
+			default:
+				emu_bus_lines(0, (emu_bus_tx() >> (gui8_emu_bus_bit - 1)) & 0x01, ui64_ns);
+				break;
+		}
+		if(gui8_emu_bus_bit == 9) {
+			gui64_emu_bus_next = ui64_ns + gui64_emu_bus_half;
+		}
+		else if(gui8_emu_bus_bit == 10) {
+			gui64_emu_bus_next = ui64_ns + gui64_emu_bus_half;
+		}
+		else if(gui8_emu_bus_bit == 11) {
+			gui64_emu_bus_next = ui64_ns;
+		}
+		else {
+			gui64_emu_bus_next = ui64_ns + 2 * gui64_emu_bus_half;
+		}
+		gui8_emu_bus_bit ++;
+		if(gui8_emu_bus_bit == 12) {
+			gui8_emu_bus_bit = 0;
+			gui16_emu_bus_byte ++;
+			if(gui16_emu_bus_byte == emu_bus_tx_size()) {
+				emu_bus_sent(ui64_ns);
+			}
+			/* else nothing to do */
+		}
+		/* else nothing to do */
+	}
+}
+
+#endif
+
+#ifdef TRANSPORT_SPI
+
+/**
+ * @fn void emu_bus_spi_frame(const uint8_t ui8_level, const uint64_t ui64_ns)
+ * @brief drive the framing line (RB0), INTF on its falling edge
+ * @param [in] ui8_level	level of RB0
+ * @param [in] ui64_ns		time of the change
+ * @return nothing
+ */
+void emu_bus_spi_frame(const uint8_t /* in */ ui8_level, const uint64_t /* in */ ui64_ns) {
+	if(ui8_level == 0) {
+		gui8_emu_bus_portb &= (uint8_t)~0x01;
+		if(EMU_GET(EMU_TRISB, EMU_TRISB_TRISB0) && !EMU_GET(EMU_OPTION_REG, EMU_OPTION_INTEDG)) {
+			EMU_SET(EMU_INTCON, EMU_INTCON_INTF);
+		}
+		/* else nothing to do */
+	}
+	else {
+		gui8_emu_bus_portb |= 0x01;
+	}
+	emu_vcd_set(gui8_emu_bus_var_frame, ui8_level, ui64_ns);
+}
+
+/**
+ * @fn void emu_bus_spi_receive(void)
+ * @brief 8th bit received by the MSSP
+ * @param none
+ * @return nothing
+ */
+void emu_bus_spi_receive(void) {
+	if(EMU_GET(EMU_SSPSTAT, EMU_SSPSTAT_BF)) {
+		EMU_SET(EMU_SSPCON, EMU_SSPCON_SSPOV);
+		gst_emu_bus.ui32_overflows ++;
+	}
+	else {
+		EMU_RAW(EMU_SSPBUF) = gui8_emu_slave_shift;
+		EMU_SET(EMU_SSPSTAT, EMU_SSPSTAT_BF);
+		gst_emu_bus.ui32_bytes ++;
+	}
+	EMU_SET(EMU_PIR1, EMU_PIR1_SSPIF);
+}
+
+/**
+ * @fn void emu_bus_spi(const uint64_t ui64_now_ns)
+ * @brief SPI master and MSSP slave up to the current time
+ * @param [in] ui64_now_ns	current time
+ * @return nothing
+ */
+void emu_bus_spi(const uint64_t /* in */ ui64_now_ns) {
+	uint64_t ui64_ns = 0;
+
+	// SSPEN cleared : the bit counter restarts
+	if(EMU_GET(EMU_SSPCON, EMU_SSPCON_SSPEN) == 0) {
+		gui8_emu_slave_bits = 0;
+	}
+	/* else nothing to do */
+
+	// bit 0 : frame line low, 1 to 16 : SCK edges (data out on the rising
+	// one, sampled on the falling one), 17 : gap
+	while(gui64_emu_bus_next <= ui64_now_ns) {
+		ui64_ns = gui64_emu_bus_next;
+		if(gpst_emu_bus_step == 0) {
+			if(emu_bus_next_step(ui64_ns) == 0) {
+				continue;
+			}
+			/* else nothing to do */
+			emu_bus_spi_frame(0, ui64_ns);
+			gui64_emu_bus_next = ui64_ns + gui64_emu_bus_setup_ns;
+			gui8_emu_bus_bit = 1;
+			continue;
+		}
+		/* else nothing to do */
+		if(gui8_emu_bus_bit <= 16) {
+			if((gui8_emu_bus_bit & 0x01) == 1) {
+				emu_bus_lines(1, (emu_bus_tx() >> (7 - (gui8_emu_bus_bit >> 1))) & 0x01, ui64_ns);
+			}
+			else {
+				emu_bus_lines(0, gui8_emu_bus_data, ui64_ns);
+				if(EMU_GET(EMU_SSPCON, EMU_SSPCON_SSPEN) &&
+				   ((EMU_RAW(EMU_SSPCON) & EMU_SSPCON_SSPM) == 0x05)) {
+					gui8_emu_slave_shift = (gui8_emu_slave_shift << 1) | gui8_emu_bus_data;
+					gui8_emu_slave_bits ++;
+					if(gui8_emu_slave_bits == 8) {
+						gui8_emu_slave_bits = 0;
+						emu_bus_spi_receive();
+					}
+					/* else nothing to do */
+				}
+				/* else nothing to do */
+			}
+			gui64_emu_bus_next = ui64_ns + gui64_emu_bus_half;
+			gui8_emu_bus_bit ++;
+		}
+		else {
+			// gap after the byte
+			gui16_emu_bus_byte ++;
+			gui8_emu_bus_bit = 1;
+			if(gui16_emu_bus_byte == emu_bus_tx_size()) {
+				emu_bus_spi_frame(1, ui64_ns);
+				emu_bus_sent(ui64_ns);
+			}
+			else {
+				gui64_emu_bus_next = ui64_ns + gui64_emu_bus_gap_ns;
+			}
+		}
+	}
+}
+
+#endif
+
+/**
+ * @fn void emu_bus_init(const uint32_t ui32_rate, const uint8_t ui8_no_stretch)
+ * @brief lines of the transport in the VCD file and bit time
+ * @param [in] ui32_rate		kHz (I2C, SPI) or bauds (UART), 0 : default
+ * @param [in] ui8_no_stretch	1 : the I2C clock isn't held (SEN ignored)
+ * @return nothing
+ */
+void emu_bus_init(const uint32_t /* in */ ui32_rate, const uint8_t /* in */ ui8_no_stretch) {
+	gui32_emu_bus_rate = ui32_rate;
+	gui8_emu_bus_no_stretch = ui8_no_stretch;
+#ifdef TRANSPORT_UART
+	if(gui32_emu_bus_rate == 0) {
+		gui32_emu_bus_rate = UART_BAUD;
+	}
+	/* else nothing to do */
+	gui64_emu_bus_half = 500000000ULL / gui32_emu_bus_rate;
+	gui8_emu_bus_var_data = emu_vcd_var("rx", 1);
+	gui8_emu_bus_var_clk = gui8_emu_bus_var_data;
+#elif defined(TRANSPORT_SPI)
+	if(gui32_emu_bus_rate == 0) {
+		gui32_emu_bus_rate = 1000;
+	}
+	/* else nothing to do */
+	gui64_emu_bus_half = 500000ULL / gui32_emu_bus_rate;
+	gui8_emu_bus_clk = 0;
+	gui8_emu_bus_var_frame = emu_vcd_var("frame", 1);
+	gui8_emu_bus_var_clk = emu_vcd_var("sck", 0);
+	gui8_emu_bus_var_data = emu_vcd_var("sdi", 1);
+#else
+	if(gui32_emu_bus_rate == 0) {
+#ifdef I2C_FAST_MODE
+		gui32_emu_bus_rate = 400;
+#else
+		gui32_emu_bus_rate = 100;
+#endif
+	}
+	/* else nothing to do */
+	gui64_emu_bus_half = 500000ULL / gui32_emu_bus_rate;
+	gui8_emu_bus_var_clk = emu_vcd_var("scl", 1);
+	gui8_emu_bus_var_data = emu_vcd_var("sda", 1);
+#endif
+}
+
+/**
+ * @fn void emu_bus_timing(const uint64_t ui64_gap_ns, const uint64_t ui64_setup_ns)
+ * @brief SPI : gap after each byte and setup after the framing line
+ * @param [in] ui64_gap_ns		gap after each byte
+ * @param [in] ui64_setup_ns	time between RB0 low and the first clock
+ * @return nothing
+ */
+void emu_bus_timing(const uint64_t /* in */ ui64_gap_ns, const uint64_t /* in */ ui64_setup_ns) {
+	gui64_emu_bus_gap_ns = ui64_gap_ns;
+	gui64_emu_bus_setup_ns = ui64_setup_ns;
+}
+
+/**
+ * @fn void emu_bus_run(const uint64_t ui64_now_ns)
+ * @brief run the transport up to the current time
+ * @param [in] ui64_now_ns	current time
+ * @return nothing
+ */
+void emu_bus_run(const uint64_t /* in */ ui64_now_ns) {
+#ifdef TRANSPORT_UART
+	emu_bus_uart(ui64_now_ns);
+#elif defined(TRANSPORT_SPI)
+	emu_bus_spi(ui64_now_ns);
+#else
+	emu_bus_i2c(ui64_now_ns);
+#endif
+}
+
+/**
+ * @fn void emu_bus_access(const uint16_t ui16_addr)
+ * @brief access of the firmware to SSPBUF (BF cleared) or RCREG (next
+ *        byte of the USART)
+ * @param [in] ui16_addr	address of the register
+ * @return nothing
+ */
+void emu_bus_access(const uint16_t /* in */ ui16_addr) {
+	if(ui16_addr == EMU_SSPBUF) {
+		EMU_CLR(EMU_SSPSTAT, EMU_SSPSTAT_BF);
+		return;
+	}
+	/* else nothing to do */
+	if(gui8_emu_slave_count == 0) {
+		return;
+	}
+	/* else nothing to do */
+	EMU_RAW(EMU_RCREG) = gpui8_emu_slave_fifo[0];
+	gpui8_emu_slave_fifo[0] = gpui8_emu_slave_fifo[1];
+	gpui8_emu_slave_ferr[0] = gpui8_emu_slave_ferr[1];
+	gui8_emu_slave_count --;
+	EMU_CLR(EMU_RCSTA, EMU_RCSTA_FERR);
+	if(gui8_emu_slave_count == 0) {
+		EMU_CLR(EMU_PIR1, EMU_PIR1_RCIF);
+	}
+	else if(gpui8_emu_slave_ferr[0] == 1) {
+		EMU_SET(EMU_RCSTA, EMU_RCSTA_FERR);
+	}
+	/* else nothing to do */
+}
+
+/**
+ * @fn uint8_t emu_bus_portb(void)
+ * @brief level of the inputs of the port B driven from outside
+ * @param none
+ * @return RB0 (framing line) and RB4/RB5 (straps)
+ */
+uint8_t emu_bus_portb(void) {
+	return gui8_emu_bus_portb;
+}
+
+/**
+ * @fn uint8_t emu_bus_is_idle(void)
+ * @brief tell if no transfer is in progress
+ * @param none
+ * @return 1 if idle, 0 otherwise
+ */
+uint8_t emu_bus_is_idle(void) {
+	return (gpst_emu_bus_step == 0);
+}
+
+/**
+ * @fn void emu_bus_report(void)
+ * @brief print the transport counters
+ * @param none
+ * @return nothing
+ */
+void emu_bus_report(void) {
+#ifdef TRANSPORT_UART
+	printf("transport    : uart %lu bauds\n", (unsigned long)gui32_emu_bus_rate);
+	printf("bus          : %lu transfers, %lu bytes received, %lu OERR, %lu FERR\n",
+		   (unsigned long)gst_emu_bus.ui32_transfers, (unsigned long)gst_emu_bus.ui32_bytes,
+		   (unsigned long)gst_emu_bus.ui32_overflows, (unsigned long)gst_emu_bus.ui32_framing);
+#elif defined(TRANSPORT_SPI)
+	printf("transport    : spi %lu kHz, %.1f us setup, %.1f us after each byte\n",
+		   (unsigned long)gui32_emu_bus_rate, gui64_emu_bus_setup_ns / 1000.0,
+		   gui64_emu_bus_gap_ns / 1000.0);
+	printf("bus          : %lu transfers, %lu bytes received, %lu SSPOV\n",
+		   (unsigned long)gst_emu_bus.ui32_transfers, (unsigned long)gst_emu_bus.ui32_bytes,
+		   (unsigned long)gst_emu_bus.ui32_overflows);
+#else
+	printf("transport    : i2c %lu kHz, SMP %u%s%s\n", (unsigned long)gui32_emu_bus_rate,
+		   EMU_GET(EMU_SSPSTAT, EMU_SSPSTAT_SMP),
+		   (EMU_GET(EMU_SSPSTAT, EMU_SSPSTAT_SMP) == (gui32_emu_bus_rate > 100)) ?
+		   " (wrong for the rate)" : "",
+		   (gui8_emu_bus_no_stretch == 1) ? ", clock never held" : "");
+	printf("bus          : %lu transfers, %lu NACKed, %lu bytes received, %lu SSPOV\n",
+		   (unsigned long)gst_emu_bus.ui32_transfers, (unsigned long)gst_emu_bus.ui32_nacks,
+		   (unsigned long)gst_emu_bus.ui32_bytes, (unsigned long)gst_emu_bus.ui32_overflows);
+	printf("stretch      : %lu, %.1f us in all, longest %.1f us\n",
+		   (unsigned long)gst_emu_bus.ui32_stretches, gst_emu_bus.ui64_stretch_ns / 1000.0,
+		   gst_emu_bus.ui64_stretch_max_ns / 1000.0);
+	if(gst_emu_bus.ui64_first_ack_ns != 0) {
+		printf("first ack    : %.3f ms\n", gst_emu_bus.ui64_first_ack_ns / 1000000.0);
+	}
+	/* else nothing to do */
+#endif
+}
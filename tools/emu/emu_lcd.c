@@ -0,0 +1,332 @@
+/*************************************************************************
+ * Projet Raspberry pi lcd controller
+ *************************************************************************
+ * File : emu_lcd.c
+ *************************************************************************
+ * Date : 19 Octobre 2026
+ * Author : Sinseman44
+ * Organization : Coloc's bar
+ *************************************************************************/
+
+/*
+ * HD44780 of the host emulator :
+ * ------------------------------
+ * Each display latches D4-D7 and RS on the falling edge of its EN. The
+ * interface is 8 bits wide after the power-on (one instruction per pulse,
+ * D0-D3 read as 0) until a function set with DL = 0, then an instruction
+ * is 2 pulses, the high nibble first.
+ *
+ * Execution times of the datasheet : 1.52 ms for a clear or a return
+ * home, 37 us for the other instructions, 41 us for a data write. An
+ * instruction started before the end of the previous one (or before 15 ms
+ * after the power-on, or less than 4.1 ms after the first function set)
+ * is counted as written while busy, it is executed anyway.
+ *
+ * DDRAM of 2 lines of 40 characters, display shift, entry mode and CGRAM.
+ * The report shows a custom character as its number (0 to 7). The
+ * backpacks (make BACKPACK=1) aren't decoded.
+ */
+
+/*************************************************************************
+ * Inclusion(s)
+ *************************************************************************/
+
+#include "emu.h"
+#include "pic16f876a_controller_lcd.h"
+
+/*************************************************************************
+ * Constante(s)/Macro(s)
+ *************************************************************************/
+
+#define EMU_LCD_POWER_UP_NS		15000000ULL
+#define EMU_LCD_FIRST_SET_NS	4100000ULL
+#define EMU_LCD_LONG_NS			1520000ULL
+#define EMU_LCD_CMD_NS			37000ULL
+#define EMU_LCD_DATA_NS			41000ULL
+#define EMU_LCD_DDRAM_SIZE		0x80
+#define EMU_LCD_CGRAM_SIZE		0x40
+#define EMU_LCD_ROW2			0x40		/*!< DDRAM address of the second line */
+
+/*************************************************************************
+ * Structure(s)
+ *************************************************************************/
+
+typedef struct {
+	uint8_t ui8_en;
+	uint8_t ui8_four_bits;
+	uint8_t ui8_high;				/*!< High nibble latched (4 bits interface) */
+	uint8_t ui8_has_high;
+	uint8_t ui8_sets;				/*!< First function set done */
+	uint64_t ui64_busy_ns;			/*!< End of the instruction executed */
+	uint8_t pui8_ddram[EMU_LCD_DDRAM_SIZE];
+	uint8_t pui8_cgram[EMU_LCD_CGRAM_SIZE];
+	uint8_t ui8_addr;
+	uint8_t ui8_cgram;				/*!< Address counter in the CGRAM */
+	uint8_t ui8_increment;
+	uint8_t ui8_entry_shift;
+	uint8_t ui8_control;
+	int8_t i8_shift;				/*!< First column shown */
+	uint32_t ui32_commands;
+	uint32_t ui32_data;
+	uint32_t ui32_busy;				/*!< Instructions written while busy */
+	uint64_t ui64_first_busy_ns;
+} EMU_lcd_t;
+
+/*************************************************************************
+ * Variable(s)
+ *************************************************************************/
+
+EMU_lcd_t gpst_emu_lcd[LCD_NB_DISPLAYS];
+
+/*************************************************************************
+ * Fonction(s)
+ *************************************************************************/
+
+/**
+ * @fn void emu_lcd_move(EMU_lcd_t * pst_lcd, const uint8_t ui8_right)
+ * @brief move the address counter of the DDRAM, the 2 lines follow each
+ *        other
+ * @param [in,out] pst_lcd	display
+ * @param [in] ui8_right	1 : incremented, 0 : decremented
+ * @return nothing
+ */
+void emu_lcd_move(EMU_lcd_t * /* in/out */ pst_lcd, const uint8_t /* in */ ui8_right) {
+	if(ui8_right == 1) {
+		pst_lcd->ui8_addr ++;
+		if(pst_lcd->ui8_addr == 0x28) {
+			pst_lcd->ui8_addr = 0x40;
+		}
+		else if(pst_lcd->ui8_addr == 0x68) {
+			pst_lcd->ui8_addr = 0x00;
+		}
+		/* else nothing to do */
+	}
+	else {
+		if(pst_lcd->ui8_addr == 0x40) {
+			pst_lcd->ui8_addr = 0x27;
+		}
+		else if(pst_lcd->ui8_addr == 0x00) {
+			pst_lcd->ui8_addr = 0x67;
+		}
+		else {
+			pst_lcd->ui8_addr --;
+		}
+	}
+}
+
+/**
+ * @fn void emu_lcd_scroll(EMU_lcd_t * pst_lcd, const uint8_t ui8_right)
+ * @brief shift the display along the lines
+ * @param [in,out] pst_lcd	display
+ * @param [in] ui8_right	1 : the text moves right
+ * @return nothing
+ */
+void emu_lcd_scroll(EMU_lcd_t * /* in/out */ pst_lcd, const uint8_t /* in */ ui8_right) {
+	if(ui8_right == 1) {
+		pst_lcd->i8_shift = (pst_lcd->i8_shift + LCD_LINE_SIZE - 1) % LCD_LINE_SIZE;
+	}
+	else {
+		pst_lcd->i8_shift = (pst_lcd->i8_shift + 1) % LCD_LINE_SIZE;
+	}
+}
+
+/**
+ * @fn uint64_t emu_lcd_execute(EMU_lcd_t * pst_lcd, const uint8_t ui8_rs, const uint8_t ui8_byte)
+ * @brief execute an instruction or a data write
+ * @param [in,out] pst_lcd	display
+ * @param [in] ui8_rs		register select
+ * @param [in] ui8_byte		byte
+ * @return execution time (ns)
+ */
+uint64_t emu_lcd_execute(EMU_lcd_t * /* in/out */ pst_lcd, const uint8_t /* in */ ui8_rs,
+						 const uint8_t /* in */ ui8_byte) {
+	if(ui8_rs == 1) {
+		pst_lcd->ui32_data ++;
+		if(pst_lcd->ui8_cgram < EMU_LCD_CGRAM_SIZE) {
+			pst_lcd->pui8_cgram[pst_lcd->ui8_cgram] = ui8_byte;
+			pst_lcd->ui8_cgram = (pst_lcd->ui8_cgram + 1) & (EMU_LCD_CGRAM_SIZE - 1);
+		}
+		else {
+			pst_lcd->pui8_ddram[pst_lcd->ui8_addr] = ui8_byte;
+			emu_lcd_move(pst_lcd, pst_lcd->ui8_increment);
+			if(pst_lcd->ui8_entry_shift == 1) {
+				emu_lcd_scroll(pst_lcd, (pst_lcd->ui8_increment == 0));
+			}
+			/* else nothing to do */
+		}
+		return EMU_LCD_DATA_NS;
+	}
+	/* else nothing to do */
+
+	pst_lcd->ui32_commands ++;
+	if((ui8_byte & 0x80) != 0) {
+		pst_lcd->ui8_addr = ui8_byte & 0x7F;
+		pst_lcd->ui8_cgram = EMU_LCD_CGRAM_SIZE;
+	}
+	else if((ui8_byte & 0x40) != 0) {
+		pst_lcd->ui8_cgram = ui8_byte & 0x3F;
+	}
+	else if((ui8_byte & 0x20) != 0) {
+		// function set : DL = 0 selects the 4 bits interface
+		if((ui8_byte & 0x10) == 0) {
+			pst_lcd->ui8_four_bits = 1;
+		}
+		/* else nothing to do */
+	}
+	else if((ui8_byte & 0x10) != 0) {
+		if((ui8_byte & 0x08) != 0) {
+			emu_lcd_scroll(pst_lcd, (ui8_byte & 0x04) != 0);
+		}
+		else {
+			emu_lcd_move(pst_lcd, (ui8_byte & 0x04) != 0);
+		}
+	}
+	else if((ui8_byte & 0x08) != 0) {
+		pst_lcd->ui8_control = ui8_byte & 0x07;
+	}
+	else if((ui8_byte & 0x04) != 0) {
+		pst_lcd->ui8_increment = (ui8_byte & 0x02) != 0;
+		pst_lcd->ui8_entry_shift = ui8_byte & 0x01;
+	}
+	else if((ui8_byte & 0x02) != 0) {
+		pst_lcd->ui8_addr = 0;
+		pst_lcd->i8_shift = 0;
+		pst_lcd->ui8_cgram = EMU_LCD_CGRAM_SIZE;
+		return EMU_LCD_LONG_NS;
+	}
+	else if(ui8_byte == 0x01) {
+		memset(pst_lcd->pui8_ddram, ' ', EMU_LCD_DDRAM_SIZE);
+		pst_lcd->ui8_addr = 0;
+		pst_lcd->i8_shift = 0;
+		pst_lcd->ui8_increment = 1;
+		pst_lcd->ui8_cgram = EMU_LCD_CGRAM_SIZE;
+		return EMU_LCD_LONG_NS;
+	}
+	/* else nothing to do */
+	return EMU_LCD_CMD_NS;
+}
+
+/**
+ * @fn void emu_lcd_init(void)
+ * @brief state of the displays at the power-on
+ * @param none
+ * @return nothing
+ */
+void emu_lcd_init(void) {
+	uint8_t ui8_idx = 0;
+
+	memset(gpst_emu_lcd, 0, sizeof(gpst_emu_lcd));
+	for(ui8_idx = 0; ui8_idx < LCD_NB_DISPLAYS; ui8_idx ++) {
+		memset(gpst_emu_lcd[ui8_idx].pui8_ddram, ' ', EMU_LCD_DDRAM_SIZE);
+		gpst_emu_lcd[ui8_idx].ui8_increment = 1;
+		gpst_emu_lcd[ui8_idx].ui8_cgram = EMU_LCD_CGRAM_SIZE;
+		gpst_emu_lcd[ui8_idx].ui64_busy_ns = EMU_LCD_POWER_UP_NS;
+	}
+}
+
+/**
+ * @fn void emu_lcd_pins(const uint8_t ui8_display, const uint8_t ui8_en,
+ *                       const uint8_t ui8_rs, const uint8_t ui8_data,
+ *                       const uint64_t ui64_now_ns)
+ * @brief pins of a display, latched on the falling edge of EN
+ * @param [in] ui8_display	LCD_DISPLAY_1 or LCD_DISPLAY_2
+ * @param [in] ui8_en		level of EN
+ * @param [in] ui8_rs		level of RS
+ * @param [in] ui8_data		levels of D4-D7
+ * @param [in] ui64_now_ns	current time
+ * @return nothing
+ */
+void emu_lcd_pins(const uint8_t /* in */ ui8_display, const uint8_t /* in */ ui8_en,
+				  const uint8_t /* in */ ui8_rs, const uint8_t /* in */ ui8_data,
+				  const uint64_t /* in */ ui64_now_ns) {
+	EMU_lcd_t * pst_lcd = &gpst_emu_lcd[ui8_display];
+	uint8_t ui8_byte = 0;
+	uint8_t ui8_eight_bits = 0;
+
+	if((pst_lcd->ui8_en == 0) || (ui8_en == 1)) {
+		pst_lcd->ui8_en = ui8_en;
+		return;
+	}
+	/* else falling edge */
+	pst_lcd->ui8_en = 0;
+
+	// an instruction starts with its first pulse
+	if((pst_lcd->ui8_has_high == 0) && (ui64_now_ns < pst_lcd->ui64_busy_ns)) {
+		if(pst_lcd->ui32_busy == 0) {
+			pst_lcd->ui64_first_busy_ns = ui64_now_ns;
+		}
+		/* else nothing to do */
+		pst_lcd->ui32_busy ++;
+	}
+	/* else nothing to do */
+
+	if(pst_lcd->ui8_four_bits == 0) {
+		ui8_byte = ui8_data << 4;
+		ui8_eight_bits = 1;
+	}
+	else if(pst_lcd->ui8_has_high == 0) {
+		pst_lcd->ui8_high = ui8_data;
+		pst_lcd->ui8_has_high = 1;
+		return;
+	}
+	else {
+		ui8_byte = (pst_lcd->ui8_high << 4) | ui8_data;
+		pst_lcd->ui8_has_high = 0;
+	}
+
+	pst_lcd->ui64_busy_ns = ui64_now_ns + emu_lcd_execute(pst_lcd, ui8_rs, ui8_byte);
+	if((ui8_eight_bits == 1) && (pst_lcd->ui8_sets == 0)) {
+		// first function set of the initialisation by instruction
+		pst_lcd->ui64_busy_ns = ui64_now_ns + EMU_LCD_FIRST_SET_NS;
+		pst_lcd->ui8_sets = 1;
+	}
+	/* else nothing to do */
+	emu_main_lcd(ui8_display, ui8_rs, ui8_byte, ui64_now_ns);
+}
+
+/**
+ * @fn void emu_lcd_report(void)
+ * @brief print the counters and the screen of each display
+ * @param none
+ * @return nothing
+ */
+void emu_lcd_report(void) {
+	uint8_t ui8_idx = 0;
+	uint8_t ui8_row = 0;
+	uint8_t ui8_col = 0;
+	uint8_t ui8_char = 0;
+	EMU_lcd_t * pst_lcd = 0;
+
+	for(ui8_idx = 0; ui8_idx < LCD_NB_DISPLAYS; ui8_idx ++) {
+		pst_lcd = &gpst_emu_lcd[ui8_idx];
+		printf("lcd %u        : %lu instructions, %lu data, %lu written while busy",
+			   ui8_idx + 1, (unsigned long)pst_lcd->ui32_commands,
+			   (unsigned long)pst_lcd->ui32_data, (unsigned long)pst_lcd->ui32_busy);
+		if(pst_lcd->ui32_busy != 0) {
+			printf(" (first at %.3f ms)", pst_lcd->ui64_first_busy_ns / 1000000.0);
+		}
+		/* else nothing to do */
+		if((pst_lcd->ui8_control & 0x04) == 0) {
+			printf(", display off");
+		}
+		/* else nothing to do */
+		printf("\n");
+		for(ui8_row = 0; ui8_row < LCD_NB_ROWS; ui8_row ++) {
+			printf("               |");
+			for(ui8_col = 0; ui8_col < LCD_NB_COLUMNS; ui8_col ++) {
+				ui8_char = pst_lcd->pui8_ddram[(ui8_row * EMU_LCD_ROW2) +
+					((ui8_col + pst_lcd->i8_shift) % LCD_LINE_SIZE)];
+				if(ui8_char < 0x08) {
+					// custom character
+					ui8_char = '0' + ui8_char;
+				}
+				else if((ui8_char < 0x20) || (ui8_char > 0x7E)) {
+					ui8_char = '?';
+				}
+				/* else nothing to do */
+				putchar(ui8_char);
+			}
+			printf("|\n");
+		}
+	}
+}
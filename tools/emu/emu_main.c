@@ -0,0 +1,529 @@
+/*************************************************************************
+ * Projet Raspberry pi lcd controller
+ *************************************************************************
+ * File : emu_main.c
+ *************************************************************************
+ * Date : 19 Octobre 2026
+ * Author : Sinseman44
+ * Organization : Coloc's bar
+ *************************************************************************/
+
+/*
+ * Host emulator (make emu) :
+ * --------------------------
+ * usage : raspi_lcd_controller_emu [options] <scenario | ->
+ *
+ *  -v file		write the waveforms to a VCD file
+ *  -r rate		bus rate : kHz (I2C, SPI) or bauds (UART)
+ *  -n			I2C : the clock isn't held after a byte (SEN ignored)
+ *  -b us		SPI : gap after each byte (0)
+ *  -u us		SPI : setup between RB0 low and the first clock (20)
+ *  -c cycles	cycles charged per basic block of the firmware (6)
+ *  -w			brown-out reset instead of a power-on reset
+ *  -e file		EEPROM image, read at the reset if it exists, written at
+ *				the end
+ *  -t ms		time emulated after the last step (100)
+ *  -m ms		time limit (60000)
+ *  -l			log the transfers and the instructions of the displays
+ *
+ * Scenario, one step per line ('#' starts a comment) :
+ *
+ *  05 07 41 42 43 44 45	a transfer (hexadecimal), an I2C write, UART bytes
+ *							after a sync byte, an SPI frame
+ *  wait <ms>				bus idle
+ *  addr <hex>				I2C address of the next transfers (0x76)
+ *  watch cmd|data <hex>	time from the end of the next transfer until the
+ *							first display executes this instruction or data
+ *  repeat <n> ... end		steps sent n times
+ *
+ * The report gives the times of the cost model (see emu_pic.c), the
+ * counters of the transport, of the performance page (make PERF=1) and of
+ * the displays, the screens, and the latency of each watch.
+ */
+
+/*************************************************************************
+ * Inclusion(s)
+ *************************************************************************/
+
+#include <unistd.h>
+#include "emu.h"
+#include "pic16f876a_controller_perf.h"
+
+/*************************************************************************
+ * Constante(s)/Macro(s)
+ *************************************************************************/
+
+#define EMU_MAIN_MAX_STEPS		65536
+#define EMU_MAIN_MAX_WATCHES	64
+#define EMU_MAIN_MAX_LINE		512
+#define EMU_MAIN_MAX_DEPTH		8		/*!< Nested repeats */
+#define EMU_MAIN_I2C_ADDR		0x76	/*!< Slave address with no strap */
+#define EMU_MAIN_NO_WATCH		0xFFFF
+
+/*************************************************************************
+ * Structure(s)
+ *************************************************************************/
+
+typedef struct {
+	uint32_t ui32_step;			/*!< Transfer watched */
+	uint8_t ui8_rs;
+	uint8_t ui8_byte;
+	uint64_t ui64_sent_ns;		/*!< End of the transfer, 0 : not sent */
+	uint64_t ui64_hit_ns;		/*!< Instruction executed, 0 : not yet */
+} EMU_watch_t;
+
+/*************************************************************************
+ * Variable(s)
+ *************************************************************************/
+
+EMU_step_t * gpst_emu_main_step = 0;
+uint32_t gui32_emu_main_steps = 0;
+uint32_t gui32_emu_main_next = 0;				/*!< Next step given to the bus */
+uint64_t gui64_emu_main_end_ns = 0;				/*!< Last step done, 0 : running */
+uint64_t gui64_emu_main_tail_ns = 100000000ULL;
+uint64_t gui64_emu_main_limit_ns = 60000000000ULL;
+uint64_t gui64_emu_main_last_sent_ns = 0;
+
+EMU_watch_t gpst_emu_main_watch[EMU_MAIN_MAX_WATCHES];
+uint8_t gui8_emu_main_watches = 0;
+uint8_t gui8_emu_main_log = 0;
+
+/*************************************************************************
+ * Fonction(s)
+ *************************************************************************/
+
+/**
+ * @fn void emu_main_usage(void)
+ * @brief print the usage and leave
+ * @param none
+ * @return nothing
+ */
+void emu_main_usage(void) {
+	fprintf(stderr, "usage : raspi_lcd_controller_emu [-v file.vcd] [-r rate] [-n] [-b us] "
+			"[-u us] [-c cycles] [-w] [-e eeprom] [-t ms] [-m ms] [-l] <scenario | ->\n");
+	exit(2);
+}
+
+/**
+ * @fn EMU_step_t * emu_main_add(const EMU_step_id_t e_id)
+ * @brief append a step to the scenario
+ * @param [in] e_id		kind of step
+ * @return the step
+ */
+EMU_step_t * emu_main_add(const EMU_step_id_t /* in */ e_id) {
+	EMU_step_t * pst_step = 0;
+
+	if(gui32_emu_main_steps == EMU_MAIN_MAX_STEPS) {
+		fprintf(stderr, "emu: more than %u steps\n", EMU_MAIN_MAX_STEPS);
+		exit(2);
+	}
+	/* else nothing to do */
+	pst_step = &gpst_emu_main_step[gui32_emu_main_steps];
+	memset(pst_step, 0, sizeof(EMU_step_t));
+	pst_step->e_id = e_id;
+	gui32_emu_main_steps ++;
+	return pst_step;
+}
+
+/**
+ * @fn void emu_main_load(FILE * pf_file, const char_t * pc_name)
+ * @brief read the scenario
+ * @param [in] pf_file	scenario
+ * @param [in] pc_name	file name for the errors
+ * @return nothing
+ */
+void emu_main_load(FILE * /* in */ pf_file, const char_t * /* in */ pc_name) {
+	char_t pc_line[EMU_MAIN_MAX_LINE];
+	char_t * pc_token = 0;
+	char_t * pc_end = 0;
+	uint8_t pui8_data[EMU_MAIN_MAX_LINE];
+	uint32_t pui32_repeat_start[EMU_MAIN_MAX_DEPTH];
+	uint32_t pui32_repeat_count[EMU_MAIN_MAX_DEPTH];
+	uint8_t ui8_depth = 0;
+	uint16_t ui16_size = 0;
+	uint32_t ui32_line = 0;
+	uint32_t ui32_count = 0;
+	uint32_t ui32_first = 0;
+	uint32_t ui32_last = 0;
+	uint32_t ui32_idx = 0;
+	uint8_t ui8_addr = EMU_MAIN_I2C_ADDR;
+	uint8_t ui8_watch = 0;
+	EMU_step_t * pst_step = 0;
+
+	while(fgets(pc_line, sizeof(pc_line), pf_file) != 0) {
+		ui32_line ++;
+		pc_end = strchr(pc_line, '#');
+		if(pc_end != 0) {
+			*pc_end = '\0';
+		}
+		/* else nothing to do */
+		pc_token = strtok(pc_line, " \t\r\n");
+		if(pc_token == 0) {
+			continue;
+		}
+		/* else nothing to do */
+
+		if(strcmp(pc_token, "wait") == 0) {
+			pst_step = emu_main_add(EMU_STEP_WAIT);
+			pc_token = strtok(0, " \t\r\n");
+			pst_step->ui64_wait_ns = (uint64_t)((pc_token != 0 ? atof(pc_token) : 0.0) * 1000000.0);
+		}
+		else if(strcmp(pc_token, "addr") == 0) {
+			pc_token = strtok(0, " \t\r\n");
+			ui8_addr = (uint8_t)strtoul(pc_token != 0 ? pc_token : "0", 0, 16);
+		}
+		else if(strcmp(pc_token, "watch") == 0) {
+			if(ui8_depth != 0) {
+				fprintf(stderr, "%s:%lu: no watch in a repeat\n", pc_name, (unsigned long)ui32_line);
+				exit(2);
+			}
+			/* else nothing to do */
+			if(gui8_emu_main_watches == EMU_MAIN_MAX_WATCHES) {
+				fprintf(stderr, "%s:%lu: more than %u watches\n", pc_name,
+						(unsigned long)ui32_line, EMU_MAIN_MAX_WATCHES);
+				exit(2);
+			}
+			/* else nothing to do */
+			pc_token = strtok(0, " \t\r\n");
+			gpst_emu_main_watch[gui8_emu_main_watches].ui8_rs =
+				((pc_token != 0) && (strcmp(pc_token, "data") == 0));
+			pc_token = strtok(0, " \t\r\n");
+			gpst_emu_main_watch[gui8_emu_main_watches].ui8_byte =
+				(uint8_t)strtoul(pc_token != 0 ? pc_token : "0", 0, 16);
+			gpst_emu_main_watch[gui8_emu_main_watches].ui32_step = EMU_MAIN_NO_WATCH;
+			gui8_emu_main_watches ++;
+			ui8_watch = 1;
+		}
+		else if(strcmp(pc_token, "repeat") == 0) {
+			if(ui8_depth == EMU_MAIN_MAX_DEPTH) {
+				fprintf(stderr, "%s:%lu: repeats too deep\n", pc_name, (unsigned long)ui32_line);
+				exit(2);
+			}
+			/* else nothing to do */
+			pc_token = strtok(0, " \t\r\n");
+			pui32_repeat_start[ui8_depth] = gui32_emu_main_steps;
+			pui32_repeat_count[ui8_depth] = (pc_token != 0) ? strtoul(pc_token, 0, 10) : 1;
+			ui8_depth ++;
+		}
+		else if(strcmp(pc_token, "end") == 0) {
+			if(ui8_depth == 0) {
+				fprintf(stderr, "%s:%lu: end without repeat\n", pc_name, (unsigned long)ui32_line);
+				exit(2);
+			}
+			/* else nothing to do */
+			ui8_depth --;
+			// the body is copied after itself, the data are shared
+			ui32_first = pui32_repeat_start[ui8_depth];
+			ui32_last = gui32_emu_main_steps;
+			for(ui32_count = 1; ui32_count < pui32_repeat_count[ui8_depth]; ui32_count ++) {
+				for(ui32_idx = ui32_first; ui32_idx < ui32_last; ui32_idx ++) {
+					pst_step = emu_main_add(EMU_STEP_WAIT);
+					*pst_step = gpst_emu_main_step[ui32_idx];
+				}
+			}
+			if(pui32_repeat_count[ui8_depth] == 0) {
+				gui32_emu_main_steps = ui32_first;
+			}
+			/* else nothing to do */
+		}
+		else {
+			ui16_size = 0;
+			while(pc_token != 0) {
+				pui8_data[ui16_size] = (uint8_t)strtoul(pc_token, &pc_end, 16);
+				if(*pc_end != '\0') {
+					fprintf(stderr, "%s:%lu: bad byte '%s'\n", pc_name, (unsigned long)ui32_line, pc_token);
+					exit(2);
+				}
+				/* else nothing to do */
+				ui16_size ++;
+				pc_token = strtok(0, " \t\r\n");
+			}
+			pst_step = emu_main_add(EMU_STEP_SEND);
+			pst_step->ui8_addr = ui8_addr;
+			pst_step->ui16_size = ui16_size;
+			pst_step->pui8_data = malloc(ui16_size);
+			memcpy(pst_step->pui8_data, pui8_data, ui16_size);
+			if(ui8_watch == 1) {
+				gpst_emu_main_watch[gui8_emu_main_watches - 1].ui32_step = gui32_emu_main_steps - 1;
+				ui8_watch = 0;
+			}
+			/* else nothing to do */
+		}
+	}
+	if(ui8_depth != 0) {
+		fprintf(stderr, "%s: repeat without end\n", pc_name);
+		exit(2);
+	}
+	/* else nothing to do */
+}
+
+/**
+ * @fn const EMU_step_t * emu_main_step(const uint64_t ui64_now_ns)
+ * @brief next step for the bus
+ * @param [in] ui64_now_ns	current time
+ * @return the step, 0 at the end of the scenario
+ */
+const EMU_step_t * emu_main_step(const uint64_t /* in */ ui64_now_ns) {
+	if(gui32_emu_main_next == gui32_emu_main_steps) {
+		if(gui64_emu_main_end_ns == 0) {
+			gui64_emu_main_end_ns = ui64_now_ns;
+		}
+		/* else nothing to do */
+		return 0;
+	}
+	/* else nothing to do */
+	gui32_emu_main_next ++;
+	return &gpst_emu_main_step[gui32_emu_main_next - 1];
+}
+
+/**
+ * @fn void emu_main_sent(const uint8_t ui8_acked, const uint64_t ui64_now_ns)
+ * @brief end of the transfer of the last step given to the bus
+ * @param [in] ui8_acked	0 if the transfer was stopped by a NACK
+ * @param [in] ui64_now_ns	current time
+ * @return nothing
+ */
+void emu_main_sent(const uint8_t /* in */ ui8_acked, const uint64_t /* in */ ui64_now_ns) {
+	uint8_t ui8_idx = 0;
+	uint16_t ui16_byte = 0;
+	EMU_step_t * pst_step = &gpst_emu_main_step[gui32_emu_main_next - 1];
+
+	gui64_emu_main_last_sent_ns = ui64_now_ns;
+	for(ui8_idx = 0; ui8_idx < gui8_emu_main_watches; ui8_idx ++) {
+		if(gpst_emu_main_watch[ui8_idx].ui32_step == gui32_emu_main_next - 1) {
+			gpst_emu_main_watch[ui8_idx].ui64_sent_ns = ui64_now_ns;
+		}
+		/* else nothing to do */
+	}
+	if(gui8_emu_main_log == 1) {
+		printf("%12.3f ms  sent%s", ui64_now_ns / 1000000.0, (ui8_acked == 1) ? "" : " (NACK)");
+		for(ui16_byte = 0; ui16_byte < pst_step->ui16_size; ui16_byte ++) {
+			printf(" %02X", pst_step->pui8_data[ui16_byte]);
+		}
+		printf("\n");
+	}
+	/* else nothing to do */
+}
+
+/**
+ * @fn void emu_main_lcd(const uint8_t ui8_display, const uint8_t ui8_rs,
+ *                       const uint8_t ui8_byte, const uint64_t ui64_now_ns)
+ * @brief instruction or data executed by a display
+ * @param [in] ui8_display	LCD_DISPLAY_1 or LCD_DISPLAY_2
+ * @param [in] ui8_rs		register select
+ * @param [in] ui8_byte		byte
+ * @param [in] ui64_now_ns	current time
+ * @return nothing
+ */
+void emu_main_lcd(const uint8_t /* in */ ui8_display, const uint8_t /* in */ ui8_rs,
+				  const uint8_t /* in */ ui8_byte, const uint64_t /* in */ ui64_now_ns) {
+	uint8_t ui8_idx = 0;
+	EMU_watch_t * pst_watch = 0;
+
+	if(gui8_emu_main_log == 1) {
+		printf("%12.3f ms  lcd %u %s %02X", ui64_now_ns / 1000000.0, ui8_display + 1,
+			   (ui8_rs == 1) ? "data" : "cmd ", ui8_byte);
+		if((ui8_rs == 1) && (ui8_byte >= 0x20) && (ui8_byte <= 0x7E)) {
+			printf(" '%c'", ui8_byte);
+		}
+		/* else nothing to do */
+		printf("\n");
+	}
+	/* else nothing to do */
+	if(ui8_display != 0) {
+		return;
+	}
+	/* else nothing to do */
+	for(ui8_idx = 0; ui8_idx < gui8_emu_main_watches; ui8_idx ++) {
+		pst_watch = &gpst_emu_main_watch[ui8_idx];
+		if((pst_watch->ui64_sent_ns != 0) && (pst_watch->ui64_hit_ns == 0) &&
+		   (pst_watch->ui8_rs == ui8_rs) && (pst_watch->ui8_byte == ui8_byte)) {
+			pst_watch->ui64_hit_ns = ui64_now_ns;
+		}
+		/* else nothing to do */
+	}
+}
+
+/**
+ * @fn uint8_t emu_main_is_over(const uint64_t ui64_now_ns)
+ * @brief tell if the emulation is over : the time after the last step
+ *        or the time limit are over
+ * @param [in] ui64_now_ns	current time
+ * @return 1 if over, 0 otherwise
+ */
+uint8_t emu_main_is_over(const uint64_t /* in */ ui64_now_ns) {
+	if(ui64_now_ns >= gui64_emu_main_limit_ns) {
+		return 1;
+	}
+	/* else nothing to do */
+	if((gui64_emu_main_end_ns != 0) && (emu_bus_is_idle() == 1) &&
+	   (ui64_now_ns >= gui64_emu_main_end_ns + gui64_emu_main_tail_ns)) {
+		return 1;
+	}
+	/* else nothing to do */
+	return 0;
+}
+
+/**
+ * @fn void emu_main_report(void)
+ * @brief print the results of the emulation
+ * @param none
+ * @return nothing
+ */
+void emu_main_report(void) {
+	uint8_t ui8_idx = 0;
+	EMU_watch_t * pst_watch = 0;
+
+	printf("emulated     : %.3f ms, %lu cycles per block (cost model, not the target)\n",
+		   EMU_NOW_NS / 1000000.0, (unsigned long)gui32_emu_block_cycles);
+	emu_bus_report();
+#ifdef PERF_ENABLE
+	printf("perf         : %u frames executed, %u bytes dropped, %u overflows, "
+		   "isr max %u us, decode max %u us (id %u)\n",
+		   perf_read_byte(10) | (perf_read_byte(11) << 8),
+		   perf_read_byte(0) | (perf_read_byte(1) << 8), perf_read_byte(2),
+		   perf_read_byte(8) | (perf_read_byte(9) << 8),
+		   perf_read_byte(5) | (perf_read_byte(6) << 8), perf_read_byte(7));
+#endif
+	emu_pic_report();
+	for(ui8_idx = 0; ui8_idx < gui8_emu_main_watches; ui8_idx ++) {
+		pst_watch = &gpst_emu_main_watch[ui8_idx];
+		printf("watch %-6u : %s %02X ", ui8_idx + 1, (pst_watch->ui8_rs == 1) ? "data" : "cmd",
+			   pst_watch->ui8_byte);
+		if(pst_watch->ui64_sent_ns == 0) {
+			printf("not sent\n");
+		}
+		else if(pst_watch->ui64_hit_ns == 0) {
+			printf("sent at %.3f ms, never executed\n", pst_watch->ui64_sent_ns / 1000000.0);
+		}
+		else {
+			printf("sent at %.3f ms, executed %.3f ms later\n", pst_watch->ui64_sent_ns / 1000000.0,
+				   (pst_watch->ui64_hit_ns - pst_watch->ui64_sent_ns) / 1000000.0);
+		}
+	}
+	if(gui64_emu_main_last_sent_ns != 0) {
+		printf("last sent    : %.3f ms\n", gui64_emu_main_last_sent_ns / 1000000.0);
+	}
+	/* else nothing to do */
+	emu_lcd_report();
+}
+
+/**
+ * @fn int main(int argc, char ** argv)
+ * @brief read the options and the scenario, run the firmware, report
+ * @param [in] argc		number of arguments
+ * @param [in] argv		arguments
+ * @return 0, 2 on a bad usage
+ */
+int main(int argc, char ** argv) {
+	int i_opt = 0;
+	const char_t * pc_vcd = 0;
+	const char_t * pc_eeprom = 0;
+	uint32_t ui32_rate = 0;
+	uint8_t ui8_no_stretch = 0;
+	uint8_t ui8_warm = 0;
+	uint64_t ui64_gap_ns = 0;
+	uint64_t ui64_setup_ns = 20000;
+	FILE * pf_file = 0;
+
+	while((i_opt = getopt(argc, argv, "v:r:nb:u:c:we:t:m:l")) != -1) {
+		switch(i_opt) {
+			case 'v':
+				pc_vcd = optarg;
+				break;
+			case 'r':
+				ui32_rate = strtoul(optarg, 0, 10);
+				break;
+			case 'n':
+				ui8_no_stretch = 1;
+				break;
+			case 'b':
+				ui64_gap_ns = (uint64_t)(atof(optarg) * 1000.0);
+				break;
+			case 'u':
+				ui64_setup_ns = (uint64_t)(atof(optarg) * 1000.0);
+				break;
+			case 'c':
+				gui32_emu_block_cycles = strtoul(optarg, 0, 10);
+				break;
+			case 'w':
+				ui8_warm = 1;
+				break;
+			case 'e':
+				pc_eeprom = optarg;
+				break;
+			case 't':
+				gui64_emu_main_tail_ns = (uint64_t)(atof(optarg) * 1000000.0);
+				break;
+			case 'm':
+				gui64_emu_main_limit_ns = (uint64_t)(atof(optarg) * 1000000.0);
+				break;
+			case 'l':
+				gui8_emu_main_log = 1;
+				break;
+			default:
+				emu_main_usage();
+				break;
+		}
+	}
+	if(optind != argc - 1) {
+		emu_main_usage();
+	}
+	/* else nothing to do */
+
+	// scenario
+	gpst_emu_main_step = malloc(EMU_MAIN_MAX_STEPS * sizeof(EMU_step_t));
+	if(strcmp(argv[optind], "-") == 0) {
+		emu_main_load(stdin, "stdin");
+	}
+	else {
+		pf_file = fopen(argv[optind], "r");
+		if(pf_file == 0) {
+			fprintf(stderr, "emu: can't read %s\n", argv[optind]);
+			return 2;
+		}
+		/* else nothing to do */
+		emu_main_load(pf_file, argv[optind]);
+		fclose(pf_file);
+	}
+
+	// EEPROM erased, or its image
+	memset(gpui8_emu_eeprom, 0xFF, EMU_EEPROM_SIZE);
+	if(pc_eeprom != 0) {
+		pf_file = fopen(pc_eeprom, "rb");
+		if(pf_file != 0) {
+			if(fread(gpui8_emu_eeprom, 1, EMU_EEPROM_SIZE, pf_file) != EMU_EEPROM_SIZE) {
+				fprintf(stderr, "emu: %s is shorter than the EEPROM\n", pc_eeprom);
+			}
+			/* else nothing to do */
+			fclose(pf_file);
+		}
+		/* else erased */
+	}
+	/* else nothing to do */
+
+	emu_pic_reset(ui8_warm);
+	emu_bus_init(ui32_rate, ui8_no_stretch);
+	emu_bus_timing(ui64_gap_ns, ui64_setup_ns);
+	emu_lcd_init();
+	if((pc_vcd != 0) && (emu_vcd_open(pc_vcd) == RET_NOK)) {
+		fprintf(stderr, "emu: can't write %s\n", pc_vcd);
+		return 2;
+	}
+	/* else nothing to do */
+
+	emu_pic_run();
+
+	emu_vcd_close(EMU_NOW_NS);
+	if(pc_eeprom != 0) {
+		pf_file = fopen(pc_eeprom, "wb");
+		if(pf_file != 0) {
+			fwrite(gpui8_emu_eeprom, 1, EMU_EEPROM_SIZE, pf_file);
+			fclose(pf_file);
+		}
+		/* else nothing to do */
+	}
+	/* else nothing to do */
+	emu_main_report();
+	return 0;
+}
@@ -0,0 +1,573 @@
+/*************************************************************************
+ * Projet Raspberry pi lcd controller
+ *************************************************************************
+ * File : emu_pic.c
+ *************************************************************************
+ * Date : 19 Octobre 2026
+ * Author : Sinseman44
+ * Organization : Coloc's bar
+ *************************************************************************/
+
+/*
+ * PIC of the host emulator :
+ * --------------------------
+ * The firmware is compiled for the host with -fsanitize-coverage=trace-pc :
+ * each basic block calls __sanitizer_cov_trace_pc(), which charges a fixed
+ * number of instruction cycles (-c, 6 by default) and each access to a
+ * register charges one more. This is a cost model, not the code of picc :
+ * the times of the report are modelled ones, to compare two builds or two
+ * transports, not a measure of the target (make cycles reads the list
+ * file for the worst case).
+ *
+ * At each block and each access, the peripherals are run up to the
+ * current time and a pending interrupt calls ISR_handle() : 4 cycles of
+ * latency and 8 of context saving before, 8 after (cycle_budget.py counts
+ * the same 20 cycles). The ISR isn't interrupted.
+ *
+ * Registers with a side effect :
+ *  - TMR0, TMR1 and TMR2 are computed from the time when read, a write is
+ *    seen at the next access (the byte differs from the one computed),
+ *  - EECON1 : RD reads the byte at once, WR writes it 4 ms later and sets
+ *    EEIF (WREN must be set, EECON2 isn't checked),
+ *  - SSPBUF and RCREG : see emu_bus.c.
+ */
+
+/*************************************************************************
+ * Inclusion(s)
+ *************************************************************************/
+
+#include <setjmp.h>
+#include "emu.h"
+#include "pic16f876a_controller_lcd.h"
+
+/*************************************************************************
+ * Constante(s)/Macro(s)
+ *************************************************************************/
+
+#define EMU_ISR_ENTRY		12		/*!< Latency and context saving */
+#define EMU_ISR_EXIT		8		/*!< Context restoring and retfie */
+#define EMU_EEPROM_WRITE	(4000UL * (_XTAL_FREQ / 4000000UL))	/*!< 4 ms */
+
+#define EMU_NB_PINS			10
+
+/*************************************************************************
+ * Structure(s)
+ *************************************************************************/
+
+typedef struct {
+	uint16_t ui16_port;
+	uint8_t ui8_mask;
+	const char_t * pc_name;
+	uint8_t ui8_var;		/*!< VCD variable */
+	uint8_t ui8_level;
+	uint64_t ui64_rise_ns;
+	uint64_t ui64_high_max_ns;	/*!< Longest pulse (trace points) */
+	uint32_t ui32_pulses;
+} EMU_pin_t;
+
+/*************************************************************************
+ * Variable(s)
+ *************************************************************************/
+
+uint64_t gui64_emu_cycle = 0;						/*!< Instruction cycles since the reset */
+EMU_sfr_t gpst_emu_sfr[EMU_NB_SFR];
+uint8_t gpui8_emu_eeprom[EMU_EEPROM_SIZE];
+uint32_t gui32_emu_block_cycles = 6;				/*!< Cycles charged per basic block */
+
+uint8_t gpui8_emu_shadow[EMU_NB_SFR];				/*!< Byte left by the emulator */
+jmp_buf gst_emu_stop;
+uint8_t gui8_emu_running = 0;
+uint8_t gui8_emu_in_isr = 0;
+
+// timers : value and cycle of the last write (or of the prescaler change)
+uint64_t gui64_emu_tmr0_cycle = 0;
+uint8_t gui8_emu_tmr0_base = 0;
+uint64_t gui64_emu_tmr1_cycle = 0;
+uint16_t gui16_emu_tmr1_base = 0;
+uint64_t gui64_emu_tmr1_ovf = 0;
+uint64_t gui64_emu_tmr2_cycle = 0;
+uint64_t gui64_emu_tmr2_next = 0;					/*!< Next TMR2IF */
+uint32_t gui32_emu_tmr2_period = 0;					/*!< Cycles between two TMR2IF */
+
+// EEPROM write in progress
+uint8_t gui8_emu_eeprom_busy = 0;
+uint8_t gui8_emu_eeprom_addr = 0;
+uint8_t gui8_emu_eeprom_data = 0;
+uint64_t gui64_emu_eeprom_end = 0;
+uint32_t gui32_emu_eeprom_writes = 0;
+
+// interrupt
+uint32_t gui32_emu_isr_count = 0;
+uint64_t gui64_emu_isr_max = 0;
+
+EMU_pin_t gpst_emu_pin[EMU_NB_PINS] = {
+	{ EMU_PORTA, 0x01, "lcd_d4" },
+	{ EMU_PORTA, 0x02, "lcd_d5" },
+	{ EMU_PORTA, 0x04, "lcd_d6" },
+	{ EMU_PORTA, 0x08, "lcd_d7" },
+	{ EMU_PORTA, 0x10, "lcd_rs" },
+	{ EMU_PORTA, 0x20, "lcd_en" },
+	{ EMU_PORTB, 0x02, "lcd2_en" },
+	{ EMU_PORTB, 0x40, "trace_decode" },
+	{ EMU_PORTB, 0x80, "trace_isr" },
+	{ EMU_PORTC, 0x20, "led" }
+};
+
+/*************************************************************************
+ * Prototype(s)
+ *************************************************************************/
+
+void ISR_handle(void);
+void emu_firmware_main(void);
+
+void emu_pic_sync(void);
+
+/*************************************************************************
+ * Fonction(s)
+ *************************************************************************/
+
+/**
+ * @fn uint8_t emu_pic_written(const uint16_t ui16_addr)
+ * @brief tell if the firmware wrote a register since the emulator left it
+ * @param [in] ui16_addr	address of the register
+ * @return 1 if the byte changed, 0 otherwise
+ */
+uint8_t emu_pic_written(const uint16_t /* in */ ui16_addr) {
+	if(EMU_RAW(ui16_addr) != gpui8_emu_shadow[ui16_addr]) {
+		gpui8_emu_shadow[ui16_addr] = EMU_RAW(ui16_addr);
+		return 1;
+	}
+	/* else nothing to do */
+	return 0;
+}
+
+/**
+ * @fn void emu_pic_leave(const uint16_t ui16_addr, const uint8_t ui8_value)
+ * @brief set a register from the emulator (not seen as a write)
+ * @param [in] ui16_addr	address of the register
+ * @param [in] ui8_value	byte
+ * @return nothing
+ */
+void emu_pic_leave(const uint16_t /* in */ ui16_addr, const uint8_t /* in */ ui8_value) {
+	EMU_RAW(ui16_addr) = ui8_value;
+	gpui8_emu_shadow[ui16_addr] = ui8_value;
+}
+
+/**
+ * @fn uint32_t emu_pic_tmr0_prescaler(void)
+ * @brief Timer0 prescaler from OPTION_REG (PSA set : 1)
+ * @param none
+ * @return cycles per count
+ */
+uint32_t emu_pic_tmr0_prescaler(void) {
+	if((EMU_RAW(EMU_OPTION_REG) & 0x08) != 0) {
+		return 1;
+	}
+	/* else nothing to do */
+	return 2UL << (EMU_RAW(EMU_OPTION_REG) & 0x07);
+}
+
+/**
+ * @fn uint8_t emu_pic_tmr0(void)
+ * @brief value of Timer0 at the current cycle
+ * @param none
+ * @return TMR0
+ */
+uint8_t emu_pic_tmr0(void) {
+	return (uint8_t)(gui8_emu_tmr0_base +
+		(gui64_emu_cycle - gui64_emu_tmr0_cycle) / emu_pic_tmr0_prescaler());
+}
+
+/**
+ * @fn uint64_t emu_pic_tmr1_count(void)
+ * @brief counts of Timer1 since its last write, its base included
+ * @param none
+ * @return count (the bits 16 and above are the overflows)
+ */
+uint64_t emu_pic_tmr1_count(void) {
+	uint64_t ui64_count = gui16_emu_tmr1_base;
+
+	if((EMU_RAW(EMU_T1CON) & 0x01) != 0) {
+		ui64_count += (gui64_emu_cycle - gui64_emu_tmr1_cycle) >>
+			((EMU_RAW(EMU_T1CON) >> 4) & 0x03);
+	}
+	/* else nothing to do */
+	return ui64_count;
+}
+
+/**
+ * @fn uint32_t emu_pic_tmr2_prescaler(void)
+ * @brief Timer2 prescaler from T2CON
+ * @param none
+ * @return cycles per count
+ */
+uint32_t emu_pic_tmr2_prescaler(void) {
+	switch(EMU_RAW(EMU_T2CON) & 0x03) {
+		case 0:
+			return 1;
+		case 1:
+			return 4;
+		default:
+			return 16;
+	}
+}
+
+/**
+ * @fn void emu_pic_tmr2_start(void)
+ * @brief restart the period of Timer2 (T2CON or PR2 written)
+ * @param none
+ * @return nothing
+ */
+void emu_pic_tmr2_start(void) {
+	gui32_emu_tmr2_period = ((uint32_t)EMU_RAW(EMU_PR2) + 1) * emu_pic_tmr2_prescaler() *
+		(((EMU_RAW(EMU_T2CON) >> 3) & 0x0F) + 1);
+	gui64_emu_tmr2_cycle = gui64_emu_cycle;
+	gui64_emu_tmr2_next = gui64_emu_cycle + gui32_emu_tmr2_period;
+}
+
+/**
+ * @fn void emu_pic_timers(void)
+ * @brief take the writes of the timer registers and raise the flags
+ * @param none
+ * @return nothing
+ */
+void emu_pic_timers(void) {
+	uint64_t ui64_ovf = 0;
+
+	// Timer0 (TMR0IF isn't used)
+	if(emu_pic_written(EMU_OPTION_REG) == 1) {
+		gui8_emu_tmr0_base = EMU_RAW(EMU_TMR0);
+		gui64_emu_tmr0_cycle = gui64_emu_cycle;
+	}
+	/* else nothing to do */
+	if(emu_pic_written(EMU_TMR0) == 1) {
+		gui8_emu_tmr0_base = EMU_RAW(EMU_TMR0);
+		gui64_emu_tmr0_cycle = gui64_emu_cycle;
+	}
+	/* else nothing to do */
+
+	// Timer1
+	if((emu_pic_written(EMU_TMR1L) == 1) || (emu_pic_written(EMU_TMR1H) == 1) ||
+	   (emu_pic_written(EMU_T1CON) == 1)) {
+		gui16_emu_tmr1_base = ((uint16_t)EMU_RAW(EMU_TMR1H) << 8) | EMU_RAW(EMU_TMR1L);
+		gui64_emu_tmr1_cycle = gui64_emu_cycle;
+		gui64_emu_tmr1_ovf = 0;
+	}
+	/* else nothing to do */
+	ui64_ovf = emu_pic_tmr1_count() >> 16;
+	if(ui64_ovf != gui64_emu_tmr1_ovf) {
+		gui64_emu_tmr1_ovf = ui64_ovf;
+		EMU_SET(EMU_PIR1, 0x01);
+	}
+	/* else nothing to do */
+
+	// Timer2
+	if((emu_pic_written(EMU_T2CON) == 1) || (emu_pic_written(EMU_PR2) == 1) ||
+	   (emu_pic_written(EMU_TMR2) == 1)) {
+		emu_pic_tmr2_start();
+	}
+	/* else nothing to do */
+	if((EMU_RAW(EMU_T2CON) & 0x04) != 0) {
+		while(gui64_emu_cycle >= gui64_emu_tmr2_next) {
+			EMU_SET(EMU_PIR1, 0x02);
+			gui64_emu_tmr2_next += gui32_emu_tmr2_period;
+		}
+	}
+	/* else nothing to do */
+}
+
+/**
+ * @fn void emu_pic_eeprom(void)
+ * @brief read at once, start a write or end it
+ * @param none
+ * @return nothing
+ */
+void emu_pic_eeprom(void) {
+	// RD
+	if((EMU_RAW(EMU_EECON1) & 0x01) != 0) {
+		emu_pic_leave(EMU_EEDATA, gpui8_emu_eeprom[EMU_RAW(EMU_EEADR)]);
+		emu_pic_leave(EMU_EECON1, EMU_RAW(EMU_EECON1) & (uint8_t)~0x01);
+	}
+	/* else nothing to do */
+
+	// WR
+	if(((EMU_RAW(EMU_EECON1) & 0x02) != 0) && (gui8_emu_eeprom_busy == 0)) {
+		if((EMU_RAW(EMU_EECON1) & 0x04) != 0) {
+			gui8_emu_eeprom_busy = 1;
+			gui8_emu_eeprom_addr = EMU_RAW(EMU_EEADR);
+			gui8_emu_eeprom_data = EMU_RAW(EMU_EEDATA);
+			gui64_emu_eeprom_end = gui64_emu_cycle + EMU_EEPROM_WRITE;
+		}
+		else {
+			// WR can't be set without WREN
+			emu_pic_leave(EMU_EECON1, EMU_RAW(EMU_EECON1) & (uint8_t)~0x02);
+		}
+	}
+	/* else nothing to do */
+	if((gui8_emu_eeprom_busy == 1) && (gui64_emu_cycle >= gui64_emu_eeprom_end)) {
+		gui8_emu_eeprom_busy = 0;
+		gpui8_emu_eeprom[gui8_emu_eeprom_addr] = gui8_emu_eeprom_data;
+		gui32_emu_eeprom_writes ++;
+		emu_pic_leave(EMU_EECON1, EMU_RAW(EMU_EECON1) & (uint8_t)~0x02);
+		EMU_SET(EMU_PIR2, EMU_PIR2_EEIF);
+	}
+	/* else nothing to do */
+}
+
+/**
+ * @fn void emu_pic_pins(void)
+ * @brief give the output pins to the displays and to the VCD file, time
+ *        the pulses of the trace points
+ * @param none
+ * @return nothing
+ */
+void emu_pic_pins(void) {
+	uint64_t ui64_now = EMU_NOW_NS;
+	uint8_t ui8_idx = 0;
+	uint8_t ui8_level = 0;
+	uint8_t ui8_porta = EMU_RAW(EMU_PORTA) & (uint8_t)~EMU_RAW(EMU_TRISA);
+	uint8_t ui8_portb = EMU_RAW(EMU_PORTB) & (uint8_t)~EMU_RAW(EMU_TRISB);
+
+	// inputs of the port B : framing line and straps
+	EMU_RAW(EMU_PORTB) = (EMU_RAW(EMU_PORTB) & (uint8_t)~EMU_RAW(EMU_TRISB)) |
+		(emu_bus_portb() & EMU_RAW(EMU_TRISB));
+
+	for(ui8_idx = 0; ui8_idx < EMU_NB_PINS; ui8_idx ++) {
+		ui8_level = ((EMU_RAW(gpst_emu_pin[ui8_idx].ui16_port) &
+			(uint8_t)~EMU_RAW(gpst_emu_pin[ui8_idx].ui16_port + 0x80) &
+			gpst_emu_pin[ui8_idx].ui8_mask) != 0);
+		if(ui8_level != gpst_emu_pin[ui8_idx].ui8_level) {
+			gpst_emu_pin[ui8_idx].ui8_level = ui8_level;
+			emu_vcd_set(gpst_emu_pin[ui8_idx].ui8_var, ui8_level, ui64_now);
+			if(ui8_level == 1) {
+				gpst_emu_pin[ui8_idx].ui64_rise_ns = ui64_now;
+				gpst_emu_pin[ui8_idx].ui32_pulses ++;
+			}
+			else if((ui64_now - gpst_emu_pin[ui8_idx].ui64_rise_ns) > gpst_emu_pin[ui8_idx].ui64_high_max_ns) {
+				gpst_emu_pin[ui8_idx].ui64_high_max_ns = ui64_now - gpst_emu_pin[ui8_idx].ui64_rise_ns;
+			}
+			/* else nothing to do */
+		}
+		/* else nothing to do */
+	}
+
+	// D4-D7 on RA0-RA3, RS on RA4, EN on RA5 and RB1 (second display)
+	emu_lcd_pins(LCD_DISPLAY_1, (ui8_porta >> 5) & 0x01, (ui8_porta >> 4) & 0x01,
+				 ui8_porta & 0x0F, ui64_now);
+#ifdef LCD2_ENABLE
+	emu_lcd_pins(LCD_DISPLAY_2, (ui8_portb >> 1) & 0x01, (ui8_porta >> 4) & 0x01,
+				 ui8_porta & 0x0F, ui64_now);
+#else
+	(void)ui8_portb;
+#endif
+}
+
+/**
+ * @fn uint8_t emu_pic_pending(void)
+ * @brief tell if an interrupt is enabled and pending
+ * @param none
+ * @return 1 if pending, 0 otherwise
+ */
+uint8_t emu_pic_pending(void) {
+	uint8_t ui8_intcon = EMU_RAW(EMU_INTCON);
+
+	if((ui8_intcon & EMU_INTCON_GIE) == 0) {
+		return 0;
+	}
+	/* else nothing to do */
+	if(((ui8_intcon >> 3) & ui8_intcon & 0x07) != 0) {
+		return 1;
+	}
+	/* else nothing to do */
+	if(((ui8_intcon & 0x40) != 0) &&
+	   (((EMU_RAW(EMU_PIR1) & EMU_RAW(EMU_PIE1)) != 0) ||
+	    ((EMU_RAW(EMU_PIR2) & EMU_RAW(EMU_PIE2)) != 0))) {
+		return 1;
+	}
+	/* else nothing to do */
+	return 0;
+}
+
+/**
+ * @fn void emu_pic_sync(void)
+ * @brief run the peripherals up to the current cycle and serve the
+ *        interrupt
+ * @param none
+ * @return nothing
+ */
+void emu_pic_sync(void) {
+	uint64_t ui64_start = 0;
+
+	if(gui8_emu_running == 0) {
+		return;
+	}
+	/* else nothing to do */
+	emu_pic_timers();
+	emu_pic_eeprom();
+	emu_bus_run(EMU_NOW_NS);
+	emu_pic_pins();
+	if(emu_main_is_over(EMU_NOW_NS) == 1) {
+		emu_pic_stop();
+	}
+	/* else nothing to do */
+
+	while((gui8_emu_in_isr == 0) && (emu_pic_pending() == 1)) {
+		gui8_emu_in_isr = 1;
+		ui64_start = gui64_emu_cycle;
+		EMU_CLR(EMU_INTCON, EMU_INTCON_GIE);
+		gui64_emu_cycle += EMU_ISR_ENTRY;
+		ISR_handle();
+		gui64_emu_cycle += EMU_ISR_EXIT;
+		EMU_SET(EMU_INTCON, EMU_INTCON_GIE);
+		gui8_emu_in_isr = 0;
+		gui32_emu_isr_count ++;
+		if((gui64_emu_cycle - ui64_start) > gui64_emu_isr_max) {
+			gui64_emu_isr_max = gui64_emu_cycle - ui64_start;
+		}
+		/* else nothing to do */
+	}
+}
+
+/**
+ * @fn volatile EMU_sfr_t * emu_sfr(const uint16_t ui16_addr)
+ * @brief access of the firmware to a register : one cycle, then the
+ *        register is brought up to date
+ * @param [in] ui16_addr	address of the register
+ * @return the register
+ */
+volatile EMU_sfr_t * emu_sfr(const uint16_t /* in */ ui16_addr) {
+	uint64_t ui64_count = 0;
+
+	gui64_emu_cycle ++;
+	emu_pic_sync();
+
+	switch(ui16_addr) {
+		case EMU_TMR0:
+			emu_pic_leave(EMU_TMR0, emu_pic_tmr0());
+			break;
+		case EMU_TMR1L:
+		case EMU_TMR1H:
+			ui64_count = emu_pic_tmr1_count();
+			emu_pic_leave(EMU_TMR1L, (uint8_t)ui64_count);
+			emu_pic_leave(EMU_TMR1H, (uint8_t)(ui64_count >> 8));
+			break;
+		case EMU_TMR2:
+			emu_pic_leave(EMU_TMR2, (uint8_t)(((gui64_emu_cycle - gui64_emu_tmr2_cycle) /
+				emu_pic_tmr2_prescaler()) % ((uint32_t)EMU_RAW(EMU_PR2) + 1)));
+			break;
+		case EMU_SSPBUF:
+		case EMU_RCREG:
+			emu_bus_access(ui16_addr);
+			break;
+		default:
+			break;
+	}
+	return &gpst_emu_sfr[ui16_addr];
+}
+
+/**
+ * @fn void emu_delay(const uint32_t ui32_cycles)
+ * @brief delay loop of picc (__delay_us, __delay_ms, NOP)
+ * @param [in] ui32_cycles	instruction cycles
+ * @return nothing
+ */
+void emu_delay(const uint32_t /* in */ ui32_cycles) {
+	uint32_t ui32_idx = 0;
+
+	for(ui32_idx = 0; ui32_idx < ui32_cycles; ui32_idx ++) {
+		gui64_emu_cycle ++;
+		emu_pic_sync();
+	}
+}
+
+/**
+ * @fn void __sanitizer_cov_trace_pc(void)
+ * @brief called by each basic block of the firmware
+ * @param none
+ * @return nothing
+ */
+void __sanitizer_cov_trace_pc(void) {
+	if(gui8_emu_running == 1) {
+		gui64_emu_cycle += gui32_emu_block_cycles;
+		emu_pic_sync();
+	}
+	/* else nothing to do */
+}
+
+/**
+ * @fn void emu_pic_reset(const uint8_t ui8_warm)
+ * @brief registers after a power-on reset or after a brown-out reset
+ * @param [in] ui8_warm		1 for a brown-out reset
+ * @return nothing
+ */
+void emu_pic_reset(const uint8_t /* in */ ui8_warm) {
+	uint8_t ui8_idx = 0;
+
+	memset(gpst_emu_sfr, 0, sizeof(gpst_emu_sfr));
+	EMU_RAW(EMU_STATUS) = 0x18;			// TO, PD
+	EMU_RAW(EMU_OPTION_REG) = 0xFF;
+	EMU_RAW(EMU_TRISA) = 0x3F;
+	EMU_RAW(EMU_TRISB) = 0xFF;
+	EMU_RAW(EMU_TRISC) = 0xFF;
+	EMU_RAW(EMU_PR2) = 0xFF;
+	EMU_RAW(EMU_TXSTA) = 0x02;			// TRMT
+	if(ui8_warm == 1) {
+		EMU_RAW(EMU_PCON) = 0x02;		// POR, BOR cleared
+	}
+	/* else POR and BOR cleared */
+	memcpy(gpui8_emu_shadow, gpst_emu_sfr, sizeof(gpui8_emu_shadow));
+
+	for(ui8_idx = 0; ui8_idx < EMU_NB_PINS; ui8_idx ++) {
+		gpst_emu_pin[ui8_idx].ui8_var = emu_vcd_var(gpst_emu_pin[ui8_idx].pc_name, 0);
+	}
+}
+
+/**
+ * @fn void emu_pic_run(void)
+ * @brief run the firmware from its reset until the end of the scenario
+ * @param none
+ * @return nothing
+ */
+void emu_pic_run(void) {
+	if(setjmp(gst_emu_stop) == 0) {
+		gui8_emu_running = 1;
+		emu_firmware_main();
+	}
+	/* else stopped */
+	gui8_emu_running = 0;
+}
+
+/**
+ * @fn void emu_pic_stop(void)
+ * @brief leave the firmware, the scenario is over
+ * @param none
+ * @return nothing
+ */
+void emu_pic_stop(void) {
+	gui8_emu_running = 0;
+	longjmp(gst_emu_stop, 1);
+}
+
+/**
+ * @fn void emu_pic_report(void)
+ * @brief print the interrupt, the trace points and the EEPROM
+ * @param none
+ * @return nothing
+ */
+void emu_pic_report(void) {
+	uint8_t ui8_idx = 0;
+
+	printf("interrupt    : %lu, longest %lu cycles (%.1f us)\n",
+		   (unsigned long)gui32_emu_isr_count, (unsigned long)gui64_emu_isr_max,
+		   gui64_emu_isr_max * EMU_NS_PER_CYCLE / 1000.0);
+	for(ui8_idx = 0; ui8_idx < EMU_NB_PINS; ui8_idx ++) {
+		if(strncmp(gpst_emu_pin[ui8_idx].pc_name, "trace_", 6) == 0) {
+			printf("%-12s : %lu pulses, longest %.1f us\n", gpst_emu_pin[ui8_idx].pc_name,
+				   (unsigned long)gpst_emu_pin[ui8_idx].ui32_pulses,
+				   gpst_emu_pin[ui8_idx].ui64_high_max_ns / 1000.0);
+		}
+		/* else nothing to do */
+	}
+	printf("eeprom       : %lu bytes written (4 ms each)\n",
+		   (unsigned long)gui32_emu_eeprom_writes);
+}
@@ -0,0 +1,133 @@
+/*************************************************************************
+ * Projet Raspberry pi lcd controller
+ *************************************************************************
+ * File : emu_vcd.c
+ *************************************************************************
+ * Date : 19 Octobre 2026
+ * Author : Sinseman44
+ * Organization : Coloc's bar
+ *************************************************************************/
+
+/*
+ * Value change dump of the host emulator (-v file.vcd) :
+ * ------------------------------------------------------
+ * One wire per pin, in the scope of the PIC, the time unit is 1 ns. The
+ * wires are declared before the file is opened, a change is written with
+ * its time (the changes come in order). Without a file nothing is written.
+ */
+
+/*************************************************************************
+ * Inclusion(s)
+ *************************************************************************/
+
+#include "emu.h"
+
+/*************************************************************************
+ * Constante(s)/Macro(s)
+ *************************************************************************/
+
+#define EMU_VCD_MAX_VARS	32
+#define EMU_VCD_ID(var)		((char_t)('!' + (var)))		/*!< Identifier code of a wire */
+
+/*************************************************************************
+ * Variable(s)
+ *************************************************************************/
+
+FILE * gpf_emu_vcd = 0;
+const char_t * gppc_emu_vcd_name[EMU_VCD_MAX_VARS];
+uint8_t gpui8_emu_vcd_init[EMU_VCD_MAX_VARS];		/*!< Level at the reset */
+uint8_t gui8_emu_vcd_vars = 0;
+uint64_t gui64_emu_vcd_time = 0;
+
+/*************************************************************************
+ * Fonction(s)
+ *************************************************************************/
+
+/**
+ * @fn uint8_t emu_vcd_var(const char_t * pc_name, const uint8_t ui8_value)
+ * @brief declare a wire
+ * @param [in] pc_name		name shown by the viewer
+ * @param [in] ui8_value	level at the reset
+ * @return the variable
+ */
+uint8_t emu_vcd_var(const char_t * /* in */ pc_name, const uint8_t /* in */ ui8_value) {
+	if(gui8_emu_vcd_vars == EMU_VCD_MAX_VARS) {
+		fprintf(stderr, "emu: too many VCD wires\n");
+		exit(1);
+	}
+	/* else nothing to do */
+	gppc_emu_vcd_name[gui8_emu_vcd_vars] = pc_name;
+	gpui8_emu_vcd_init[gui8_emu_vcd_vars] = ui8_value;
+	gui8_emu_vcd_vars ++;
+	return gui8_emu_vcd_vars - 1;
+}
+
+/**
+ * @fn int8_t emu_vcd_open(const char_t * pc_path)
+ * @brief create the file and write the declarations
+ * @param [in] pc_path	file name
+ * @return RET_OK or RET_NOK if the file can't be created
+ */
+int8_t emu_vcd_open(const char_t * /* in */ pc_path) {
+	uint8_t ui8_var = 0;
+
+	gpf_emu_vcd = fopen(pc_path, "w");
+	if(gpf_emu_vcd == 0) {
+		return RET_NOK;
+	}
+	/* else nothing to do */
+	fprintf(gpf_emu_vcd, "$version raspi_lcd_controller host emulator $end\n");
+	fprintf(gpf_emu_vcd, "$timescale 1 ns $end\n");
+	fprintf(gpf_emu_vcd, "$scope module pic16f876a $end\n");
+	for(ui8_var = 0; ui8_var < gui8_emu_vcd_vars; ui8_var ++) {
+		fprintf(gpf_emu_vcd, "$var wire 1 %c %s $end\n", EMU_VCD_ID(ui8_var),
+				gppc_emu_vcd_name[ui8_var]);
+	}
+	fprintf(gpf_emu_vcd, "$upscope $end\n$enddefinitions $end\n#0\n$dumpvars\n");
+	for(ui8_var = 0; ui8_var < gui8_emu_vcd_vars; ui8_var ++) {
+		fprintf(gpf_emu_vcd, "%u%c\n", gpui8_emu_vcd_init[ui8_var], EMU_VCD_ID(ui8_var));
+	}
+	fprintf(gpf_emu_vcd, "$end\n");
+	return RET_OK;
+}
+
+/**
+ * @fn void emu_vcd_set(const uint8_t ui8_var, const uint8_t ui8_value, const uint64_t ui64_now_ns)
+ * @brief write a change of a wire
+ * @param [in] ui8_var		variable
+ * @param [in] ui8_value	new level
+ * @param [in] ui64_now_ns	time of the change
+ * @return nothing
+ */
+void emu_vcd_set(const uint8_t /* in */ ui8_var, const uint8_t /* in */ ui8_value,
+				 const uint64_t /* in */ ui64_now_ns) {
+	if(gpf_emu_vcd == 0) {
+		return;
+	}
+	/* else nothing to do */
+	if(ui64_now_ns > gui64_emu_vcd_time) {
+		gui64_emu_vcd_time = ui64_now_ns;
+		fprintf(gpf_emu_vcd, "#%llu\n", (unsigned long long)ui64_now_ns);
+	}
+	/* else same time */
+	fprintf(gpf_emu_vcd, "%u%c\n", ui8_value, EMU_VCD_ID(ui8_var));
+}
+
+/**
+ * @fn void emu_vcd_close(const uint64_t ui64_now_ns)
+ * @brief write the end time and close the file
+ * @param [in] ui64_now_ns	end of the emulation
+ * @return nothing
+ */
+void emu_vcd_close(const uint64_t /* in */ ui64_now_ns) {
+	if(gpf_emu_vcd == 0) {
+		return;
+	}
+	/* else nothing to do */
+	if(ui64_now_ns > gui64_emu_vcd_time) {
+		fprintf(gpf_emu_vcd, "#%llu\n", (unsigned long long)ui64_now_ns);
+	}
+	/* else nothing to do */
+	fclose(gpf_emu_vcd);
+	gpf_emu_vcd = 0;
+}
@@ -0,0 +1,304 @@
+#ifndef EMU_HTC
+#define EMU_HTC
+
+/*************************************************************************
+ * Projet Raspberry pi lcd controller
+ *************************************************************************
+ * File : htc.h (host emulator)
+ *************************************************************************
+ * Date : 19 Octobre 2026
+ * Author : Sinseman44
+ * Organization : Coloc's bar
+ *************************************************************************/
+
+/*
+ * <htc.h> of the host emulator (make emu) :
+ * -----------------------------------------
+ * Found before the one of picc by the include path of the emulator build.
+ * The qualifiers of picc are removed, a bit variable is a byte, and each
+ * special function register is a byte of the emulated register file reached
+ * through emu_sfr() : the access costs one cycle, runs the peripherals up
+ * to the current time and gives the interrupt a chance, as an instruction
+ * of the target would. A bit of a register is a bit field of the same
+ * byte, SSPSTAT and BF stay coherent.
+ *
+ * Only the registers and the bits used by the firmware are named.
+ */
+
+/*************************************************************************
+ * Inclusion(s)
+ *************************************************************************/
+
+#include <stdint.h>
+
+/*************************************************************************
+ * Constante(s)/Macro(s)
+ *************************************************************************/
+
+#define EMU_HOST
+
+// qualifiers of picc
+#define interrupt
+#define bank0
+#define bank1
+#define bank2
+#define bank3
+#define near
+#define persistent
+#define bit				uint8_t
+
+// configuration word (fuses are not emulated)
+#define __CONFIG(x)
+
+// built-in functions
+#define NOP()			emu_delay(1)
+#define CLRWDT()		emu_delay(1)
+#define di()			(GIE = 0)
+#define ei()			(GIE = 1)
+#define __delay_us(x)	emu_delay((uint32_t)(x) * (_XTAL_FREQ / 4000000UL))
+#define __delay_ms(x)	emu_delay((uint32_t)(x) * (_XTAL_FREQ / 4000UL))
+
+// register file : the address of the target, bank bits included
+#define EMU_REG(addr)		(emu_sfr(addr)->ui8_byte)
+#define EMU_BIT(addr, n)	(emu_sfr(addr)->st_bits.b##n)
+
+#define EMU_TMR0		0x001
+#define EMU_STATUS		0x003
+#define EMU_PORTA		0x005
+#define EMU_PORTB		0x006
+#define EMU_PORTC		0x007
+#define EMU_INTCON		0x00B
+#define EMU_PIR1		0x00C
+#define EMU_PIR2		0x00D
+#define EMU_TMR1L		0x00E
+#define EMU_TMR1H		0x00F
+#define EMU_T1CON		0x010
+#define EMU_TMR2		0x011
+#define EMU_T2CON		0x012
+#define EMU_SSPBUF		0x013
+#define EMU_SSPCON		0x014
+#define EMU_RCSTA		0x018
+#define EMU_TXREG		0x019
+#define EMU_RCREG		0x01A
+#define EMU_OPTION_REG	0x081
+#define EMU_TRISA		0x085
+#define EMU_TRISB		0x086
+#define EMU_TRISC		0x087
+#define EMU_PIE1		0x08C
+#define EMU_PIE2		0x08D
+#define EMU_PCON		0x08E
+#define EMU_SSPCON2		0x091
+#define EMU_PR2			0x092
+#define EMU_SSPADD		0x093
+#define EMU_SSPSTAT		0x094
+#define EMU_TXSTA		0x098
+#define EMU_SPBRG		0x099
+#define EMU_ADCON1		0x09F
+#define EMU_EEDATA		0x10C
+#define EMU_EEADR		0x10D
+#define EMU_EECON1		0x18C
+#define EMU_EECON2		0x18D
+#define EMU_NB_SFR		0x200
+
+#define TMR0		EMU_REG(EMU_TMR0)
+#define STATUS		EMU_REG(EMU_STATUS)
+#define PORTA		EMU_REG(EMU_PORTA)
+#define PORTB		EMU_REG(EMU_PORTB)
+#define PORTC		EMU_REG(EMU_PORTC)
+#define INTCON		EMU_REG(EMU_INTCON)
+#define PIR1		EMU_REG(EMU_PIR1)
+#define PIR2		EMU_REG(EMU_PIR2)
+#define TMR1L		EMU_REG(EMU_TMR1L)
+#define TMR1H		EMU_REG(EMU_TMR1H)
+#define T1CON		EMU_REG(EMU_T1CON)
+#define TMR2		EMU_REG(EMU_TMR2)
+#define T2CON		EMU_REG(EMU_T2CON)
+#define SSPBUF		EMU_REG(EMU_SSPBUF)
+#define SSPCON		EMU_REG(EMU_SSPCON)
+#define RCSTA		EMU_REG(EMU_RCSTA)
+#define TXREG		EMU_REG(EMU_TXREG)
+#define RCREG		EMU_REG(EMU_RCREG)
+#define OPTION_REG	EMU_REG(EMU_OPTION_REG)
+#define TRISA		EMU_REG(EMU_TRISA)
+#define TRISB		EMU_REG(EMU_TRISB)
+#define TRISC		EMU_REG(EMU_TRISC)
+#define PIE1		EMU_REG(EMU_PIE1)
+#define PIE2		EMU_REG(EMU_PIE2)
+#define PCON		EMU_REG(EMU_PCON)
+#define SSPCON2		EMU_REG(EMU_SSPCON2)
+#define PR2			EMU_REG(EMU_PR2)
+#define SSPADD		EMU_REG(EMU_SSPADD)
+#define SSPSTAT		EMU_REG(EMU_SSPSTAT)
+#define TXSTA		EMU_REG(EMU_TXSTA)
+#define SPBRG		EMU_REG(EMU_SPBRG)
+#define ADCON1		EMU_REG(EMU_ADCON1)
+#define EEDATA		EMU_REG(EMU_EEDATA)
+#define EEADR		EMU_REG(EMU_EEADR)
+#define EECON1		EMU_REG(EMU_EECON1)
+#define EECON2		EMU_REG(EMU_EECON2)
+
+// STATUS
+#define nPD			EMU_BIT(EMU_STATUS, 3)
+#define PD			nPD
+#define nTO			EMU_BIT(EMU_STATUS, 4)
+#define TO			nTO
+
+// PORTA, PORTB, PORTC
+#define RA0			EMU_BIT(EMU_PORTA, 0)
+#define RA1			EMU_BIT(EMU_PORTA, 1)
+#define RA2			EMU_BIT(EMU_PORTA, 2)
+#define RA3			EMU_BIT(EMU_PORTA, 3)
+#define RA4			EMU_BIT(EMU_PORTA, 4)
+#define RA5			EMU_BIT(EMU_PORTA, 5)
+#define RB0			EMU_BIT(EMU_PORTB, 0)
+#define RB1			EMU_BIT(EMU_PORTB, 1)
+#define RB2			EMU_BIT(EMU_PORTB, 2)
+#define RB3			EMU_BIT(EMU_PORTB, 3)
+#define RB4			EMU_BIT(EMU_PORTB, 4)
+#define RB5			EMU_BIT(EMU_PORTB, 5)
+#define RB6			EMU_BIT(EMU_PORTB, 6)
+#define RB7			EMU_BIT(EMU_PORTB, 7)
+#define RC0			EMU_BIT(EMU_PORTC, 0)
+#define RC1			EMU_BIT(EMU_PORTC, 1)
+#define RC2			EMU_BIT(EMU_PORTC, 2)
+#define RC3			EMU_BIT(EMU_PORTC, 3)
+#define RC4			EMU_BIT(EMU_PORTC, 4)
+#define RC5			EMU_BIT(EMU_PORTC, 5)
+#define RC6			EMU_BIT(EMU_PORTC, 6)
+#define RC7			EMU_BIT(EMU_PORTC, 7)
+
+// INTCON
+#define RBIF		EMU_BIT(EMU_INTCON, 0)
+#define INTF		EMU_BIT(EMU_INTCON, 1)
+#define T0IF		EMU_BIT(EMU_INTCON, 2)
+#define RBIE		EMU_BIT(EMU_INTCON, 3)
+#define INTE		EMU_BIT(EMU_INTCON, 4)
+#define T0IE		EMU_BIT(EMU_INTCON, 5)
+#define PEIE		EMU_BIT(EMU_INTCON, 6)
+#define GIE			EMU_BIT(EMU_INTCON, 7)
+
+// PIR1, PIE1, PIR2, PIE2
+#define TMR1IF		EMU_BIT(EMU_PIR1, 0)
+#define TMR2IF		EMU_BIT(EMU_PIR1, 1)
+#define SSPIF		EMU_BIT(EMU_PIR1, 3)
+#define TXIF		EMU_BIT(EMU_PIR1, 4)
+#define RCIF		EMU_BIT(EMU_PIR1, 5)
+#define TMR1IE		EMU_BIT(EMU_PIE1, 0)
+#define TMR2IE		EMU_BIT(EMU_PIE1, 1)
+#define SSPIE		EMU_BIT(EMU_PIE1, 3)
+#define TXIE		EMU_BIT(EMU_PIE1, 4)
+#define RCIE		EMU_BIT(EMU_PIE1, 5)
+#define EEIF		EMU_BIT(EMU_PIR2, 4)
+#define EEIE		EMU_BIT(EMU_PIE2, 4)
+
+// T1CON, T2CON
+#define TMR1ON		EMU_BIT(EMU_T1CON, 0)
+#define TMR1CS		EMU_BIT(EMU_T1CON, 1)
+#define T1CKPS0		EMU_BIT(EMU_T1CON, 4)
+#define T1CKPS1		EMU_BIT(EMU_T1CON, 5)
+#define TMR2ON		EMU_BIT(EMU_T2CON, 2)
+
+// SSPCON, SSPCON2, SSPSTAT
+#define SSPM0		EMU_BIT(EMU_SSPCON, 0)
+#define SSPM1		EMU_BIT(EMU_SSPCON, 1)
+#define SSPM2		EMU_BIT(EMU_SSPCON, 2)
+#define SSPM3		EMU_BIT(EMU_SSPCON, 3)
+#define CKP			EMU_BIT(EMU_SSPCON, 4)
+#define SSPEN		EMU_BIT(EMU_SSPCON, 5)
+#define SSPOV		EMU_BIT(EMU_SSPCON, 6)
+#define WCOL		EMU_BIT(EMU_SSPCON, 7)
+#define SEN			EMU_BIT(EMU_SSPCON2, 0)
+#define RSEN		EMU_BIT(EMU_SSPCON2, 1)
+#define PEN			EMU_BIT(EMU_SSPCON2, 2)
+#define RCEN		EMU_BIT(EMU_SSPCON2, 3)
+#define ACKEN		EMU_BIT(EMU_SSPCON2, 4)
+#define ACKDT		EMU_BIT(EMU_SSPCON2, 5)
+#define ACKSTAT		EMU_BIT(EMU_SSPCON2, 6)
+#define GCEN		EMU_BIT(EMU_SSPCON2, 7)
+#define BF			EMU_BIT(EMU_SSPSTAT, 0)
+#define UA			EMU_BIT(EMU_SSPSTAT, 1)
+#define R_W			EMU_BIT(EMU_SSPSTAT, 2)
+#define S			EMU_BIT(EMU_SSPSTAT, 3)
+#define P			EMU_BIT(EMU_SSPSTAT, 4)
+#define D_A			EMU_BIT(EMU_SSPSTAT, 5)
+#define CKE			EMU_BIT(EMU_SSPSTAT, 6)
+#define SMP			EMU_BIT(EMU_SSPSTAT, 7)
+
+// RCSTA, TXSTA
+#define RX9D		EMU_BIT(EMU_RCSTA, 0)
+#define OERR		EMU_BIT(EMU_RCSTA, 1)
+#define FERR		EMU_BIT(EMU_RCSTA, 2)
+#define CREN		EMU_BIT(EMU_RCSTA, 4)
+#define SPEN		EMU_BIT(EMU_RCSTA, 7)
+#define TRMT		EMU_BIT(EMU_TXSTA, 1)
+#define BRGH		EMU_BIT(EMU_TXSTA, 2)
+#define SYNC		EMU_BIT(EMU_TXSTA, 4)
+#define TXEN		EMU_BIT(EMU_TXSTA, 5)
+
+// OPTION_REG
+#define PS0			EMU_BIT(EMU_OPTION_REG, 0)
+#define PS1			EMU_BIT(EMU_OPTION_REG, 1)
+#define PS2			EMU_BIT(EMU_OPTION_REG, 2)
+#define PSA			EMU_BIT(EMU_OPTION_REG, 3)
+#define T0SE		EMU_BIT(EMU_OPTION_REG, 4)
+#define T0CS		EMU_BIT(EMU_OPTION_REG, 5)
+#define INTEDG		EMU_BIT(EMU_OPTION_REG, 6)
+#define nRBPU		EMU_BIT(EMU_OPTION_REG, 7)
+#define RBPU		nRBPU
+
+// TRISA, TRISB, TRISC
+#define TRISA5		EMU_BIT(EMU_TRISA, 5)
+#define TRISB0		EMU_BIT(EMU_TRISB, 0)
+#define TRISB1		EMU_BIT(EMU_TRISB, 1)
+#define TRISB2		EMU_BIT(EMU_TRISB, 2)
+#define TRISB3		EMU_BIT(EMU_TRISB, 3)
+#define TRISB4		EMU_BIT(EMU_TRISB, 4)
+#define TRISB5		EMU_BIT(EMU_TRISB, 5)
+#define TRISB6		EMU_BIT(EMU_TRISB, 6)
+#define TRISB7		EMU_BIT(EMU_TRISB, 7)
+#define TRISC3		EMU_BIT(EMU_TRISC, 3)
+#define TRISC4		EMU_BIT(EMU_TRISC, 4)
+#define TRISC5		EMU_BIT(EMU_TRISC, 5)
+#define TRISC6		EMU_BIT(EMU_TRISC, 6)
+#define TRISC7		EMU_BIT(EMU_TRISC, 7)
+
+// PCON
+#define nBOR		EMU_BIT(EMU_PCON, 0)
+#define BOR			nBOR
+#define nPOR		EMU_BIT(EMU_PCON, 1)
+#define POR			nPOR
+
+// EECON1
+#define RD			EMU_BIT(EMU_EECON1, 0)
+#define WR			EMU_BIT(EMU_EECON1, 1)
+#define WREN		EMU_BIT(EMU_EECON1, 2)
+#define WRERR		EMU_BIT(EMU_EECON1, 3)
+#define EEPGD		EMU_BIT(EMU_EECON1, 7)
+
+/*************************************************************************
+ * Structure(s)
+ *************************************************************************/
+
+typedef union {
+	uint8_t ui8_byte;
+	struct {
+		unsigned b0 : 1;
+		unsigned b1 : 1;
+		unsigned b2 : 1;
+		unsigned b3 : 1;
+		unsigned b4 : 1;
+		unsigned b5 : 1;
+		unsigned b6 : 1;
+		unsigned b7 : 1;
+	} st_bits;
+} EMU_sfr_t;
+
+/*************************************************************************
+ * Prototypes(s)
+ *************************************************************************/
+
+volatile EMU_sfr_t * emu_sfr(const uint16_t /* in */ ui16_addr);
+
+void emu_delay(const uint32_t /* in */ ui32_cycles);
+
+#endif /* EMU_HTC */
@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+#########################################################################
+# Projet Raspberry pi lcd controller
+#########################################################################
+# File : emu_bench.py
+#########################################################################
+# Date : 19 Octobre 2026
+# Author : Sinseman44
+# Organization : Coloc's bar
+#########################################################################
+
+"""
+Frames per second of the transport built, with the host emulator (make emu).
+
+The master sends FRAMES PUT_STRING frames of a full row (16 characters,
+18 bytes) after the logo, with a pause between two frames. The pause is
+the shortest of PAUSES_MS with every frame executed, no byte dropped and
+no overrun (SSPOV, OERR). The rate is the number of frames over the time
+from the first transfer to the last character written to the display.
+
+I2C and UART run at the rate of the build (I2C_SPEED, BAUD). The SPI clock
+is given by the master : each rate of SPI_RATES_KHZ is run with the
+shortest byte gap of SPI_GAPS_US, then the shortest setup of
+SPI_SETUPS_US (framing line low to the first clock), without loss.
+
+The times come from the cost model of the emulator (cycles per basic
+block, -c), they are not measured on the board.
+
+usage : emu_bench.py <emulator> [cycles per block]
+Returns 1 if no pause is found for a rate.
+"""
+
+import re
+import subprocess
+import sys
+
+FRAMES = 40
+START_MS = 2600				# the logo stays 2500 ms
+PAUSES_MS = (0, 0.5, 1, 1.5, 2, 2.5, 3, 3.5, 4, 5, 6, 8, 10)
+SPI_RATES_KHZ = (250, 500, 960)
+SPI_GAPS_US = (0, 10, 20, 40, 60, 80, 100, 150, 200)
+SPI_SETUPS_US = (20, 50, 100, 150, 200, 250, 300)
+
+RE_TRANSPORT = re.compile(r"^transport\s*:\s*(\w+)\s+(.*)$")
+RE_BUS = re.compile(r"^bus\s*:.*?(\d+) bytes received, (\d+) (?:SSPOV|OERR)")
+RE_PERF = re.compile(r"^perf\s*:\s*(\d+) frames executed, (\d+) bytes dropped")
+RE_LCD = re.compile(r"^\s*([\d.]+) ms\s+lcd 1 data")
+
+
+def scenario(pause_ms):
+	lines = ["wait %d" % START_MS]
+	for frame in range(FRAMES):
+		text = " ".join("%02X" % (0x41 + (frame + col) % 26) for col in range(16))
+		lines.append("05 12 " + text)
+		if pause_ms > 0:
+			lines.append("wait %g" % pause_ms)
+	return "\n".join(lines) + "\n"
+
+
+def run(emulator, options, pause_ms):
+	result = subprocess.run([emulator, "-l"] + options + ["-"], input=scenario(pause_ms),
+				capture_output=True, text=True, check=True)
+	run = {"transport": "", "overruns": 0, "executed": 0, "dropped": 0, "last_ms": 0.0}
+	for line in result.stdout.splitlines():
+		transport = RE_TRANSPORT.match(line)
+		if transport:
+			run["transport"] = "%s %s" % (transport.group(1), transport.group(2))
+		bus = RE_BUS.match(line)
+		if bus:
+			run["overruns"] = int(bus.group(2))
+		perf = RE_PERF.match(line)
+		if perf:
+			run["executed"] = int(perf.group(1))
+			run["dropped"] = int(perf.group(2))
+		lcd = RE_LCD.match(line)
+		if lcd:
+			run["last_ms"] = float(lcd.group(1))
+	return run
+
+
+def lossless(result):
+	return (result["executed"] == FRAMES and result["dropped"] == 0 and
+		result["overruns"] == 0)
+
+
+def best(emulator, options):
+	for pause_ms in PAUSES_MS:
+		result = run(emulator, options, pause_ms)
+		if lossless(result):
+			result["pause_ms"] = pause_ms
+			result["rate"] = FRAMES * 1000.0 / (result["last_ms"] - START_MS)
+			return result
+	return None
+
+
+def show(label, result):
+	if result is None:
+		print("%-36s no pause up to %g ms without loss" % (label, PAUSES_MS[-1]))
+		return 1
+	print("%-36s pause %4g ms  %6.1f frames/s" % (label, result["pause_ms"], result["rate"]))
+	return 0
+
+
+def main():
+	if len(sys.argv) not in (2, 3):
+		print(__doc__)
+		return 2
+	emulator = sys.argv[1]
+	options = ["-c", sys.argv[2]] if len(sys.argv) == 3 else []
+	failed = 0
+
+	transport = run(emulator, options + ["-m", "1"], 0)["transport"]
+	print("%d frames of 18 bytes, cost model%s (not the board)" %
+	      (FRAMES, " -c " + sys.argv[2] if len(sys.argv) == 3 else ""))
+	if not transport.startswith("spi"):
+		failed |= show(transport, best(emulator, options))
+		return failed
+
+	for rate in SPI_RATES_KHZ:
+		label = "spi %d kHz" % rate
+		timing = None
+		for gap_us in SPI_GAPS_US:
+			gap = ["-r", str(rate), "-b", str(gap_us)]
+			if lossless(run(emulator, options + gap + ["-u", str(SPI_SETUPS_US[-1])], PAUSES_MS[-1])):
+				for setup_us in SPI_SETUPS_US:
+					timing = gap + ["-u", str(setup_us)]
+					if lossless(run(emulator, options + timing, PAUSES_MS[-1])):
+						label += " gap %d us setup %d us" % (gap_us, setup_us)
+						break
+				break
+		failed |= show(label, best(emulator, options + timing) if timing else None)
+	return failed
+
+
+if __name__ == "__main__":
+	sys.exit(main())
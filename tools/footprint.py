@@ -0,0 +1,172 @@
+#!/usr/bin/env python3
+#########################################################################
+# Projet Raspberry pi lcd controller
+#########################################################################
+# File : footprint.py
+#########################################################################
+# Date : 19 Octobre 2026
+# Author : Sinseman44
+# Organization : Coloc's bar
+#########################################################################
+
+"""
+ROM/RAM footprint per module from the list file of picc (--ASMLIST).
+
+Program words are counted per function and RAM bytes ('ds') per variable,
+the compiled stack included (as placed by the linker, overlaid autos are
+counted once). A symbol belongs to the module named in it : fifo_put,
+gpui8_fifo_bulk, fifo_put@ui8_lane -> fifo, the others go to main.
+
+The RAM of each class (COMMON, BANK0 to BANK3) and the words of each
+program memory page are checked against the limits of the config file,
+each module against the baseline plus the allowed growth.
+
+usage : footprint.py <list file> <config file> <baseline file> [--update]
+--update writes the baseline from the list file.
+Returns 1 if a limit is exceeded or if there is no baseline.
+"""
+
+import re
+import sys
+
+MODULES = ("i2c", "lcd", "fifo", "timer", "eeprom", "macro", "marquee",
+	   "animate", "schedule", "crc", "error", "perf", "frame", "backpack",
+	   "uart", "spi")
+MAIN = "main"
+PAGE_SIZE = 2048			# words per program memory page
+
+RE_PSECT = re.compile(r"^\s*\d+\s+.*\bpsect\s+(\w+)(.*)$")
+RE_CLASS = re.compile(r"class\s*=\s*(\w+)")
+RE_LABEL = re.compile(r"^\s*\d+\s+(?:[0-9A-Fa-f]{3,4}\s+)?([\w?@$]+):")
+RE_DS = re.compile(r"^\s*\d+\s+(?:[0-9A-Fa-f]{3,4}\s+)?ds\s+(0[xX][0-9A-Fa-f]+|\d+)")
+RE_WORD = re.compile(r"^\s*\d+\s+([0-9A-Fa-f]{3,4})\s+[0-9A-Fa-f]{4}\b")
+RE_GLOBAL = re.compile(r"^g(?:b_flag|[a-z0-9]*)_(\w+)$")
+
+
+def module_of(symbol):
+	name = symbol.lstrip("_?").split("@")[0]
+	variable = RE_GLOBAL.match(name)
+	if variable:
+		name = variable.group(1)
+	for module in MODULES:
+		if name.startswith(module):
+			return module
+	return MAIN
+
+
+def parse(path):
+	code = {}				# words per module
+	ram = {}				# bytes per module
+	classes = {}			# bytes per RAM class
+	pages = {}				# words per page
+	psect_class = {}
+	current_class = None
+	owner = MAIN
+
+	with open(path, errors="replace") as f:
+		for line in f:
+			psect = RE_PSECT.match(line)
+			if psect:
+				name = psect.group(1)
+				klass = RE_CLASS.search(psect.group(2))
+				if klass:
+					psect_class[name] = klass.group(1).upper()
+				current_class = psect_class.get(name)
+				continue
+
+			label = RE_LABEL.match(line)
+			if label:
+				owner = module_of(label.group(1))
+				continue
+
+			ds = RE_DS.match(line)
+			if ds:
+				size = int(ds.group(1), 0)
+				if (current_class is not None) and (current_class != "CODE"):
+					ram[owner] = ram.get(owner, 0) + size
+					classes[current_class] = classes.get(current_class, 0) + size
+				continue
+
+			word = RE_WORD.match(line)
+			if word and (current_class in ("CODE", "ENTRY", "STRCODE", "CONST")):
+				code[owner] = code.get(owner, 0) + 1
+				page = "PAGE%d" % (int(word.group(1), 16) // PAGE_SIZE)
+				pages[page] = pages.get(page, 0) + 1
+	return code, ram, classes, pages
+
+
+def read_table(path):
+	table = {}
+	with open(path) as f:
+		for line in f:
+			line = line.split("#")[0].split()
+			if line:
+				table[line[0]] = [int(value) for value in line[1:]]
+	return table
+
+
+def write_baseline(path, code, ram):
+	with open(path, "w") as f:
+		f.write("# module  code (words)  ram (bytes), written by 'make footprint_baseline'\n")
+		for module in MODULES + (MAIN,):
+			f.write("%-10s %6d %6d\n" % (module, code.get(module, 0), ram.get(module, 0)))
+
+
+def main():
+	if len(sys.argv) not in (4, 5):
+		print(__doc__)
+		return 2
+
+	code, ram, classes, pages = parse(sys.argv[1])
+	if len(code) == 0:
+		print("footprint: no code found in %s" % sys.argv[1])
+		return 2
+
+	if (len(sys.argv) == 5) and (sys.argv[4] == "--update"):
+		write_baseline(sys.argv[3], code, ram)
+		print("footprint: baseline written to %s" % sys.argv[3])
+		return 0
+
+	config = read_table(sys.argv[2])
+	try:
+		baseline = read_table(sys.argv[3])
+	except IOError:
+		print("footprint: no baseline %s, run 'make footprint_baseline'" % sys.argv[3])
+		return 1
+	growth_code = config.get("growth_code", [0])[0]
+	growth_ram = config.get("growth_ram", [0])[0]
+	ok = True
+
+	print("Module       code  (base)    ram  (base)")
+	for module in MODULES + (MAIN,):
+		words = code.get(module, 0)
+		size = ram.get(module, 0)
+		state = ""
+		base = baseline.get(module)
+		if base is not None:
+			if (words > base[0] + growth_code) or (size > base[1] + growth_ram):
+				state = "GROWN"
+				ok = False
+			print("  %-10s %5d (%5d)  %5d (%5d) %s" % (module, words, base[0], size, base[1], state))
+		else:
+			print("  %-10s %5d          %5d" % (module, words, size))
+
+	print("Memory       used / limit")
+	for name in sorted(set(classes) | set(pages)):
+		used = classes.get(name, pages.get(name, 0))
+		limit = config.get(name)
+		if limit is None:
+			print("  %-10s %5d" % (name, used))
+			continue
+		state = "ok" if used <= limit[0] else "FULL"
+		print("  %-10s %5d / %5d  %s" % (name, used, limit[0], state))
+		ok &= used <= limit[0]
+
+	if not ok:
+		print("footprint: budget exceeded")
+		return 1
+	return 0
+
+
+if __name__ == "__main__":
+	sys.exit(main())